@@ -0,0 +1,50 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define CACHE_LINE_SIZE             64
+#define MACHINE_ARENA_SIZE     0x80000 // 512 KB, a machine carves about 400 KB.
+
+typedef struct Arena Arena;
+
+/*
+    One contiguous, zeroed mapping holding every fixed-size piece of a machine's mutable state.
+    Layout, in cache lines from the start of the mapping:
+        [0]                 -> the arena's own bookkeeping
+        [1, HOT)            -> small structs (CPU, registers, flags, PPU, events, DMA...) packed back to back
+        [HOT, end)          -> bulk buffers (IO/HRAM, code cache, LCD, tile cache) in init order
+    Every piece starts on a cache line, so the hot structs touched every dot share a handful of adjacent lines
+    instead of being scattered across heap chunks.
+    @note -> Pieces are never freed on their own, tidy_arena() drops the whole machine at once.
+             Copy-on-write banks and cartridge RAM stay pages (see page.h), since forks share them.
+*/
+
+/*
+    Maps an arena of at least size bytes.
+    @return -> NULL if the host refuses the mapping.
+    @note   -> With huge pages enabled, size rounds up to a 2 MB page and the kernel is asked to back it with one.
+*/
+Arena *init_arena(size_t size);
+
+void tidy_arena(Arena *arena);
+
+/*
+    Carves a zeroed, cache-line-aligned piece out of the arena.
+    @return -> NULL (and an error logged) once the arena is exhausted.
+*/
+void *arena_alloc(Arena *arena, size_t size);
+
+/*
+    Bytes carved so far, bookkeeping and alignment padding included.
+*/
+size_t get_arena_used(Arena *arena);
+
+/*
+    Process-wide, applies to arenas mapped afterwards. Off by default: a 2 MB page per machine only pays off
+    when few machines run, and vectorised environments may hold hundreds.
+*/
+void set_huge_pages(bool enabled);
+
+#endif
@@ -1,26 +1,40 @@
 #ifndef CART_H
 #define CART_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct GbcMachine GbcMachine;
+
 /*
     Reads in ROM and initializes cartridge context. 
+    @param gb          -> machine that owns the cartridge
     @param file_path   -> location of ROM file being opened
     @param testing     -> Indicates testing ROM. Skips header info and starts at 0x00.
-    @return int (bool) -> Was initialization successful?
+    @return int (bool) -> Was initialization successful? False (and an error logged) if the ROM or either BIOS
+                          image cannot be mapped; tidy_cartridge() still releases the rest.
     @note              -> Call this function first. :)  
 */
-void init_cartridge(char *file_path);
+bool init_cartridge(GbcMachine *gb, char *file_path);
 
 /*
     Prints header, rom, and ram information derived from the ROM file.
     @todo            -> Possible code refactor into samller print functions.
 */
-void print_cartridge();
+void print_cartridge(GbcMachine *gb);
+
+/*
+    Initializes gb's cartridge as a fork of parent's: same bank registers, shared ROM and BIOS images.
+    @note -> Cartridge RAM is shared too, until the first write (or snapshot load) in either machine.
+*/
+void fork_cartridge(GbcMachine *gb, GbcMachine *parent);
 
 /*
     Cleans up memory and pointers that were used in a global context.
     @note           -> Call this only during program exit.
 */
-void tidy_cartridge();
+void tidy_cartridge(GbcMachine *gb);
 
 /*
     Reads byte from ROM content.
@@ -30,7 +44,7 @@ void tidy_cartridge();
     @note 2        -> Test with MBC and MBC1 first.
     @todo          -> Add support for larger ROM types. 
 */
-uint8_t read_rom_memory(uint16_t address);
+uint8_t read_rom_memory(GbcMachine *gb, uint16_t address);
 
 /*
     Handles ROM and RAM Memory Banking.
@@ -40,9 +54,44 @@ uint8_t read_rom_memory(uint16_t address);
                    -> Test with MBC and MBC1 first.
     @todo          -> Add support for larger ROM types. 
 */
-void write_rom_memory(uint16_t address, uint8_t value);
+void write_rom_memory(GbcMachine *gb, uint16_t address, uint8_t value);
+
+
+bool is_gbc(GbcMachine *gb);
+
+/*
+    Host memory behind the 4 KB page of ROM or cartridge RAM starting at address, as the handlers resolve it now.
+    @return -> NULL while the BIOS is mapped, for open bus, and for MBCs without plain banks (the handlers decide).
+    @note   -> Only good until the next MBC write; write pages also need the RAM to be this machine's own.
+*/
+const uint8_t *get_cart_read_page(GbcMachine *gb, uint16_t address);
+
+uint8_t *get_cart_write_page(GbcMachine *gb, uint16_t address);
+
+/*
+    ROM image as mapped by image.c, the same pointer in every machine that loaded the same file.
+*/
+const uint8_t *get_rom_image(GbcMachine *gb);
+/*
+    FNV-1a hash of the loaded ROM image, computed once at init.
+*/
+uint32_t get_rom_hash(GbcMachine *gb);
 
+/*
+    Bank currently mapped at $4000-$7FFF, as the read handlers resolve it.
+    @note -> Lets the CPU's block cache tell the same address in different banks apart.
+*/
+uint16_t get_rom_bank(GbcMachine *gb);
+
+size_t get_cartridge_snapshot_size(GbcMachine *gb);
+
+/*
+    Serializes the MBC bank registers and cartridge RAM into dest.
+    @return -> Cursor advanced past the cartridge section.
+    @note   -> Cartridge RAM is saved in full; the ROM itself is identified by the header's rom_hash.
+*/
+uint8_t *save_cartridge_snapshot(GbcMachine *gb, uint8_t *dest);
 
-bool is_gbc();
+const uint8_t *load_cartridge_snapshot(GbcMachine *gb, const uint8_t *src);
 
 #endif
\ No newline at end of file
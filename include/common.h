@@ -16,6 +16,7 @@ typedef enum
     LOWER_4_MASK    =  0b00001111,
     LOWER_5_MASK    =  0b00011111, 
     LOWER_6_MASK    =  0b00111111,
+    LOWER_7_MASK    =  0b01111111,
     LOWER_12_MASK   =      0x0FFF,
     LOWER_14_MASK   =      0x3FFF,
     LOWER_BYTE_MASK =      0x00FF,
@@ -2,6 +2,8 @@
 #define CPU_H
 #include <stdint.h>
 
+typedef struct GbcMachine GbcMachine;
+
 typedef enum
 {
     BASE_CLOCK_SPEED     = 4194304,
@@ -12,6 +14,14 @@ typedef enum
 
 } CpuDefaults;
 
+typedef enum
+{
+    ACCURATE_EXECUTION = 0, // Handlers re-entered once per M-cycle, interleaved with the clock.
+    FAST_EXECUTION     = 1, // Handlers run to completion and thread into the next, the clock catches up on bus accesses.
+    JIT_EXECUTION      = 2  // FAST_EXECUTION, plus hot register-only runs translated to x86-64.
+
+} ExecutionMode;
+
 typedef enum
 {
     ZERO_FLAG       = 0b10000000, // Z
@@ -31,9 +41,27 @@ typedef enum
     
 } InterruptCode;
 
-/* STATE MANGEMENT */
+typedef enum
+{
+    POLL_LY   = 0x01,
+    POLL_STAT = 0x02,
+    POLL_DIV  = 0x04,
+    POLL_TIMA = 0x08
+
+} PolledRegister; // What an idle loop reads, see get_idle_period().
 
 typedef struct
+{
+    uint64_t          hits; // Instructions issued without touching the bus.
+    uint64_t       decodes; // Blocks decoded, first visits and evictions alike.
+    uint64_t invalidations; // RAM lines written while holding cached code.
+    uint64_t        native; // Instructions run as translated host code (JIT_EXECUTION).
+
+} CodeCacheStats;
+
+/* STATE MANGEMENT */
+
+typedef struct Register
 {
     // CPU Registers
     uint8_t     A; uint8_t      F; // Accumulator          | Flags
@@ -46,28 +74,95 @@ typedef struct
 
 } Register;
 
-uint8_t get_machine_cycle_scaler();
+uint8_t get_machine_cycle_scaler(GbcMachine *gb);
+
+void machine_cycle(GbcMachine *gb);
+
+void init_cpu(GbcMachine *gb);
+
+/*
+    Selects how instructions are stepped; call right after init_emulator() or at any instruction boundary.
+    @note -> FAST_EXECUTION matches ACCURATE_EXECUTION bus access for bus access, but an instruction that
+             straddles the end of a frame finishes first, so run_frames() can return a few dots late.
+             Timing tests should stay on ACCURATE_EXECUTION, the default.
+             JIT_EXECUTION only checks interrupts between translated runs, so they can land up to a run late.
+             It falls back to FAST_EXECUTION where executable memory is unavailable; get_execution_mode() tells.
+*/
+void set_execution_mode(GbcMachine *gb, ExecutionMode mode);
+
+ExecutionMode get_execution_mode(GbcMachine *gb);
+
+/*
+    MMU Interface: drops cached blocks overlapping a written WRAM/HRAM byte.
+    @param bank -> WRAM bank behind $D000-$DFFF, ignored elsewhere.
+    @note       -> Only needed while code_in_ram is set; cheap when the line holds no code.
+*/
+void invalidate_code(GbcMachine *gb, uint16_t address, uint8_t bank);
+
+/*
+    MMU Interface: the next instruction is looked up again instead of following the current block.
+    @note -> Call whenever the bank mapping changes (MBC registers, SVBK, BIOS unmap).
+*/
+void reset_code_cursor(GbcMachine *gb);
+
+CodeCacheStats get_code_cache_stats(GbcMachine *gb);
+
+/*
+    Builds R->F from the last ALU operation, which the CPU only records.
+    @note -> Snapshots, PUSH AF and run_frames() settle on their own; anything else reading R->F from
+             outside cpu.c between instructions should call this first.
+*/
+void settle_flags(GbcMachine *gb);
+
+void tidy_cpu(GbcMachine *gb);
+
+void reset_cpu(GbcMachine *gb);
+
+void start_cpu(GbcMachine *gb);
+
+void stop_cpu(GbcMachine *gb);
+
+bool is_speed_enabled(GbcMachine *gb);
 
-void machine_cycle();
+bool cpu_running(GbcMachine *gb);
 
-void init_cpu();
+/*
+    Timer Interface: the CPU is spinning in a loop that only waits for the clock, e.g. LDH A, [LY]; CP n; JR NZ.
+    @param polls -> receives the PolledRegister bits the loop reads
+    @return      -> Dots per iteration, 0 when not in such a loop. Skipping whole iterations is exact for as
+                    long as nothing in polls changes and no interrupt is raised.
+    @note        -> Recognized from cached blocks that branch back to their own start, once two entries in a row
+                    saw the same registers, the same polled values and the same period.
+*/
+uint32_t get_idle_period(GbcMachine *gb, uint8_t *polls);
 
-void tidy_cpu();
+/*
+    Halted with no enabled interrupt requested, so nothing happens until the PPU or timer raises one.
+*/
+bool cpu_sleeping(GbcMachine *gb);
 
-void reset_cpu();
+/*
+    MMU Interface: the CPU sits out the next 'cycles' M-cycles while a VRAM DMA holds the bus.
+*/
+void stall_cpu(GbcMachine *gb, uint16_t cycles);
 
-void start_cpu();
+bool cpu_stalled(GbcMachine *gb);
 
-void stop_cpu();
+void request_interrupt(GbcMachine *gb, InterruptCode interrupt);
 
-bool is_speed_enabled();
+char *get_cpu_state(GbcMachine *gb, char *buffer, size_t size);
 
-bool cpu_running();
+void write_ifr(GbcMachine *gb, uint8_t value);
 
-void request_interrupt(InterruptCode interrupt);
+size_t get_cpu_snapshot_size(GbcMachine *gb);
 
-char *get_cpu_state(char *buffer, size_t size);
+/*
+    Serializes CPU, registers, pending IME and the in-flight instruction into dest.
+    @return -> Cursor advanced past the CPU section.
+    @note   -> The instruction handler is stored as (table, opcode) and re-bound on load.
+*/
+uint8_t *save_cpu_snapshot(GbcMachine *gb, uint8_t *dest);
 
-void write_ifr(uint8_t value);
+const uint8_t *load_cpu_snapshot(GbcMachine *gb, const uint8_t *src);
 
 #endif
\ No newline at end of file
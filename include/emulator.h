@@ -4,6 +4,9 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+typedef struct GbcMachine GbcMachine;
+typedef struct Movie Movie;
+
 typedef enum
 {
     A_BUTTON_MASK      = 0b00000001,
@@ -17,7 +20,20 @@ typedef enum
 
 } JoypadMask;
 
-typedef struct
+typedef enum
+{
+    JOYPAD_A      = 0b00000001,
+    JOYPAD_B      = 0b00000010,
+    JOYPAD_SELECT = 0b00000100,
+    JOYPAD_START  = 0b00001000,
+    JOYPAD_RIGHT  = 0b00010000,
+    JOYPAD_LEFT   = 0b00100000,
+    JOYPAD_UP     = 0b01000000,
+    JOYPAD_DOWN   = 0b10000000
+
+} JoypadButton; // One byte per input frame, used by headless front ends.
+
+typedef struct JoypadState
 {
     bool     A, B, SELECT, START;
     bool     RIGHT, LEFT, UP, DOWN;
@@ -27,16 +43,74 @@ typedef struct
 
 } JoypadState;
 
-JoypadState *get_joypad();
+JoypadState *get_joypad(GbcMachine *gb);
+
+/*
+    Allocates a machine and initializes every subsystem against it.
+    @param file_path -> Cartridge ROM to load.
+    @param display   -> Whether to bring up the SDL window (headless machines pass false).
+    @return          -> The machine, owned by the caller until tidy_emulator().
+                        NULL (and an error logged) if the ROM or a BIOS image cannot be mapped.
+*/
+GbcMachine *init_emulator(char *file_path, bool display);
 
-void init_emulator(char *file_path, bool display);
+/*
+    Clones a running machine for tree search, e.g. one child per candidate action.
+    @param parent -> Machine to fork; it keeps running normally afterwards.
+    @return       -> Headless child in the exact same state, released with tidy_emulator(child, false).
+    @note         -> ROM, BIOS, VRAM and WRAM pages are shared copy-on-write, so a child only pays for the
+                     banks it writes. Parent and children may be stepped on different threads.
+*/
+GbcMachine *fork_emulator(GbcMachine *parent);
 
-void tidy_emulator(bool reset_display);
+void tidy_emulator(GbcMachine *gb, bool reset_display);
 
-void start_emulator();
+/*
+    Re-initializes every subsystem from the cartridge file, as if the machine had just been created.
+    @return -> False (and an error logged) if the files cannot be mapped anymore; only tidy_emulator() is safe then.
+    @note   -> Unlike the reset key this also releases every button, so runs from power-on are reproducible.
+*/
+bool power_cycle_emulator(GbcMachine *gb);
+
+/*
+    Resets to the state right after boot without re-reading files or re-running the BIOS.
+    @note -> Restores the machine's boot snapshot (or the persisted one, see set_boot_persistence()).
+             Without either it falls back to power_cycle_emulator(), which captures one when the BIOS
+             unmaps itself, so only the first reset per machine pays for the boot.
+*/
+void fast_reset_emulator(GbcMachine *gb);
+
+/*
+    Runs the machine in the SDL window until it is closed, paced to the LCD's frame rate.
+    @param movie -> optional, records the joypad once per frame as the core sees it; NULL to just play.
+*/
+void start_emulator(GbcMachine *gb, Movie *movie);
 
 void stop_emulator();
 
-char *get_joypad_state(char *buffer, uint8_t size);
+char *get_joypad_state(GbcMachine *gb, char *buffer, uint8_t size);
+
+/*
+    Presses exactly the buttons set in the bitmask and releases the rest.
+    @param buttons -> OR of JoypadButton values.
+    @note          -> Requests the joypad interrupt when anything changed, like the SDL event loop does.
+*/
+void set_joypad(GbcMachine *gb, uint8_t buttons);
+
+/*
+    Sets the joypad without requesting an interrupt, e.g. to put back state saved alongside a snapshot.
+*/
+void restore_joypad(GbcMachine *gb, uint8_t buttons);
+
+/*
+    Packs the current joypad state into a JoypadButton bitmask.
+*/
+uint8_t get_joypad_buttons(GbcMachine *gb);
+
+/*
+    Clocks the machine until it has produced the requested number of frames.
+    @note -> Headless counterpart to the emulation thread; no display or pacing involved.
+*/
+void run_frames(GbcMachine *gb, uint32_t frames);
 
 #endif
\ No newline at end of file
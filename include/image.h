@@ -0,0 +1,35 @@
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    Read-only file images (ROMs, BIOS dumps) mapped once per process and shared by every machine.
+    Mappings are keyed by device and inode, so different paths to the same file share one mapping.
+    @note -> Safe to call from any thread; the registry is only touched on map and unmap.
+*/
+
+/*
+    Maps file_path, or takes another reference to its existing mapping.
+    @param size -> receives the image size in bytes
+    @return     -> Read-only image, or NULL if the file cannot be opened, is empty or cannot be mapped.
+*/
+const uint8_t *map_image(const char *file_path, size_t *size);
+
+/*
+    Adds a reference to an image returned by map_image(). NULL passes through.
+*/
+const uint8_t *share_image(const uint8_t *data);
+
+/*
+    Drops a reference, unmapping the file with the last one. NULL is ignored.
+*/
+void unmap_image(const uint8_t *data);
+
+/*
+    Number of live references to an image, 0 once it has been unmapped or was never mapped.
+*/
+uint32_t get_image_references(const uint8_t *data);
+
+#endif
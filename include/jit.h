@@ -0,0 +1,44 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define JIT_MIN_RUN 2 // Instructions; a single one is cheaper to interpret than to enter.
+
+typedef struct Register Register;
+typedef struct JitArena JitArena;
+
+/*
+    Translated SM83 code. Loads the guest registers into host registers, runs, and stores them back.
+    @note -> Never touches memory, PC, SP or IME, the CPU advances PC and charges the cycles itself.
+*/
+typedef void (*NativeBlock)(Register *R);
+
+/*
+    Executable memory for translated blocks.
+    @return -> NULL when the host is not x86-64 or refuses executable mappings; callers just keep interpreting.
+*/
+JitArena *init_jit(size_t size);
+
+void tidy_jit(JitArena *arena);
+
+/*
+    Changes whenever a full arena is recycled, which invalidates every NativeBlock handed out before.
+*/
+uint32_t get_jit_generation(JitArena *arena);
+
+/*
+    Translates the longest run of register-only instructions at the front of code.
+    @param code   -> opcodes and their immediates, back to back
+    @param size   -> bytes in code
+    @param count  -> receives the number of instructions translated
+    @param length -> receives the number of bytes translated
+    @param cycles -> receives their M-cycles, charged as one batch
+    @return       -> NULL if the run is too short to be worth it.
+    @note         -> Loads, ALU, INC/DEC, CPL/SCF/CCF and 16-bit INC/DEC of BC/DE/HL. Anything touching the bus,
+                     the stack, control flow or IME ends the run and stays with the handlers in cpu.c.
+*/
+NativeBlock compile_native(JitArena *arena, const uint8_t *code, size_t size, uint8_t *count, uint8_t *length, uint8_t *cycles);
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+typedef struct GbcMachine GbcMachine;
+
 typedef enum
 {
     INFO,
@@ -20,8 +22,8 @@ void log_message
     ...
 );
 
-void cpu_log(LoggingLevel level, const char *message, ...);
+void cpu_log(GbcMachine *gb, LoggingLevel level, const char *message, ...);
 
-void joypad_log(LoggingLevel level, const char *message, ...);
+void joypad_log(GbcMachine *gb, LoggingLevel level, const char *message, ...);
 
 #endif
\ No newline at end of file
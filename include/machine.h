@@ -0,0 +1,84 @@
+#ifndef MACHINE_H
+#define MACHINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Emulation context for a single Game Boy.
+    Every subsystem used to keep its state in file-scope statics, which capped us at one machine per process.
+    Each of those statics now lives here instead, and the owning subsystem still defines the structs behind the
+    pointers, carving them out of the machine's arena (see arena.h). Pass the same machine through every init_,
+    tidy_ and clocking call.
+    @note -> Nothing is shared between machines, so independent machines may be stepped on different threads.
+*/
+typedef struct GbcMachine
+{
+    // STATE ARENA                            (arena.c)
+    struct Arena              *arena; // Backs every fixed-size struct below, mapped before the subsystems init.
+
+    // CPU                                    (cpu.c)
+    struct CPU                  *cpu;
+    struct Register               *R;
+    struct InterruptEnableEvent *iee;
+    struct InstructionEntity    *ins;
+    struct LazyFlags          *flags; // Last ALU operation, R->F is built from it on demand.
+    bool                 cb_prefixed;
+    uint8_t                exec_mode; // ExecutionMode, kept across power cycles.
+    uint8_t              owed_cycles; // M-cycles a FAST_EXECUTION instruction ran ahead of the clock.
+    struct CodeCache           *code;
+    bool                 code_in_ram; // Some cached block lives in WRAM/HRAM, writes there have to check.
+
+    // MMU                                    (mmu.c)
+    struct HDMATransfer        *hdma;
+    struct DMATransfer          *dma;
+    uint8_t                  *memory;
+    uint8_t                    *cram;
+    uint8_t                   **vram;
+    uint8_t                   **wram;
+    bool                 bios_locked;
+    uint16_t             dirty_pages; // Banks written since the last fork (WRAM 0-7, VRAM 8-9).
+    const uint8_t    *read_pages[16]; // Host memory behind each 4 KB of the bus, NULL takes the handlers.
+    uint8_t         *write_pages[16];
+
+    // PPU                                    (ppu.c)
+    struct PpuState             *ppu;
+    struct TileCache     *tile_cache; // VRAM tiles decoded to color ids, see invalidate_tiles().
+
+    // TIMER                                  (timer.c)
+    struct SystemCycleEvent *tima_overflow;
+    struct EventQueue        *events; // Next dot each EventKind needs stepped in full.
+    uint64_t                   clock; // Dots since the machine was created.
+    uint32_t             current_dot;
+    uint16_t                     sys;
+    uint8_t                     *div_;
+    uint8_t                     *tac;
+    uint8_t                     *tma;
+    uint8_t                    *tima;
+    bool                prev_sys_bit;
+    uint32_t             frame_count; // Frames completed, for run loops that cannot land on dot 0.
+    uint64_t            slot_horizon; // First dot run_slots() stops short of, FAST_EXECUTION chains instructions up to it.
+    bool                no_idle_skip; // Step HALT and polling loops dot by dot, kept across power cycles.
+    uint64_t             halted_dots; // Fast-forwarded, for get_idle_stats().
+    uint64_t            polling_dots;
+
+    // CARTRIDGE                              (cart.c)
+    struct Cartridge           *cart;
+    struct Header            *header;
+    const uint8_t          *dmg_bios;
+    const uint8_t          *cgb_bios;
+    uint8_t                    *bios;
+    char                  *main_file;
+
+    // BOOT CACHE                             (snapshot.c)
+    uint8_t           *boot_snapshot; // Page holding the state right after the BIOS unmapped itself.
+    bool               boot_pending; // BIOS register written, capture once the dot completes.
+    bool               persist_boot;
+
+    // FRONT END                              (emulator.c)
+    struct JoypadState       *joypad;
+    char             *cartridge_file;
+
+} GbcMachine;
+
+#endif
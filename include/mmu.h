@@ -1,7 +1,13 @@
 #ifndef MMU_H
 #define MMU_H
+#include <stddef.h>
 #include <stdint.h>
 
+#define WRAM_VIEW_SIZE   0x2000
+#define MEMORY_PAGE_SIZE 0x1000
+
+typedef struct GbcMachine GbcMachine;
+
 typedef enum
 {
     BANK_ZERO_ADDRESS_START  = (uint16_t) 0x0000,
@@ -106,32 +112,90 @@ typedef enum
     
 } InterruptVector;
 
-void init_memory();
+void init_memory(GbcMachine *gb);
+
+void tidy_memory(GbcMachine *gb);
+
+/*
+    Initializes gb's memory as a copy-on-write fork of parent's.
+    @note -> VRAM and WRAM banks are shared until either machine writes to them; write_memory()
+             takes a private copy of a bank on its first write and marks it in dirty_pages.
+             The rest of the address space (OAM, IO, HRAM) is copied up front.
+*/
+void fork_memory(GbcMachine *gb, GbcMachine *parent);
+
+/*
+    Bitmap of banks written since this machine was created or last forked.
+    @return -> Bits 0-7 are WRAM banks 0-7, bits 8-9 are VRAM banks 0-1.
+*/
+uint16_t get_dirty_pages(GbcMachine *gb);
+
+/*
+    Rebuilds the page table read_memory() and write_memory() try before their handlers.
+    @note -> Call whenever what sits behind a page changes: VBK, SVBK, the BIOS register, MBC writes,
+             a bank changing owner, or code landing in RAM. A stale entry reads or writes the wrong bank.
+*/
+void remap_memory(GbcMachine *gb);
+
+uint8_t read_memory(GbcMachine *gb, uint16_t address);
+
+void write_memory(GbcMachine *gb, uint16_t address, uint8_t value);
+
+/*
+    OAM DMA copies all 160 bytes when $FF46 is written, then holds the bus for 160 M-cycles.
+    @note -> Meanwhile the CPU loses OAM and whichever bus the source sits on (VRAM or the external one): reads
+             there see the byte in flight (OAM reads $FF) and writes are dropped. IO and HRAM stay reachable.
+             check_dma() releases the bus once the transfer is over.
+*/
+void check_dma(GbcMachine *gb);
+
+bool dma_active(GbcMachine *gb);
+
+/*
+    Dots until an OAM DMA releases the bus, UINT32_MAX when none is running.
+*/
+uint32_t get_dma_dots(GbcMachine *gb);
+
+/*
+    PPU Interface: copies the next 16-byte block of an HBlank HDMA, called as each HBlank begins.
+    @note -> Stalls the CPU for the block and keeps HDMA5 reading back the blocks left, $FF once done.
+             A no-op unless hdma_active(), which makes every HBlank a PPU deadline.
+*/
+void run_hblank_dma(GbcMachine *gb);
 
-void tidy_memory();
+bool hdma_active(GbcMachine *gb);
 
-uint8_t read_memory(uint16_t address);
+uint8_t read_joypad(GbcMachine *gb);
 
-void write_memory(uint16_t address, uint8_t value);
+uint8_t read_vram(GbcMachine *gb, uint8_t bank, uint16_t address);
 
-void check_dma();
+uint8_t read_cram(GbcMachine *gb, bool is_obj, uint8_t palette_index, uint8_t color_id, uint8_t index);
 
-bool dma_active();
+uint8_t *get_memory(GbcMachine *gb);
 
-uint8_t read_joypad();
+/*
+    Copies WRAM as the CPU currently sees it ($C000 - $DFFF) into dest.
+    @param dest -> Caller-owned buffer of at least WRAM_VIEW_SIZE bytes.
+    @note       -> Bank N follows SVBK, so this matches read_memory() without the per-byte dispatch.
+*/
+void get_wram_view(GbcMachine *gb, uint8_t *dest);
 
-uint8_t read_vram(uint8_t bank, uint16_t address);
+uint8_t *get_memory_pointer(GbcMachine *gb, uint16_t address);
 
-uint8_t read_cram(bool is_obj, uint8_t palette_index, uint8_t color_id, uint8_t index);
+void print_vram(GbcMachine *gb, uint16_t start, uint16_t end, bool bank);
 
-uint8_t *get_memory();
+uint8_t io_memory_read(GbcMachine *gb, uint16_t address);
 
-uint8_t *get_memory_pointer(uint16_t address);
+void io_memory_write(GbcMachine *gb, uint16_t address, uint8_t value);
 
-void print_vram(uint16_t start, uint16_t end, bool bank);
+size_t get_memory_snapshot_size(GbcMachine *gb);
 
-uint8_t io_memory_read(uint16_t address);
+/*
+    Serializes the address space, CRAM, every VRAM/WRAM bank and DMA/HDMA progress into dest.
+    @return -> Cursor advanced past the MMU section.
+*/
+uint8_t *save_memory_snapshot(GbcMachine *gb, uint8_t *dest);
 
-void io_memory_write(uint16_t address, uint8_t value);
+const uint8_t *load_memory_snapshot(GbcMachine *gb, const uint8_t *src);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef MOVIE_H
+#define MOVIE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MOVIE_MAGIC   0x4D434247 // "GBCM"
+#define MOVIE_VERSION 1
+
+typedef struct GbcMachine GbcMachine;
+typedef struct Movie Movie;
+
+typedef struct
+{
+    uint32_t         magic;
+    uint16_t       version;
+    uint8_t  start_buttons; // Joypad at the first frame; snapshots do not carry it.
+    uint8_t       reserved;
+    uint32_t      rom_hash;
+    uint32_t   frame_count;
+    uint32_t     run_count;
+    uint32_t snapshot_size; // 0 = starts from power-on.
+
+} MovieHeader;
+
+/*
+    Called after every frame of playback, e.g. to copy render_frame() into a dataset.
+*/
+typedef void (*MovieFrameHandler)(void *context, GbcMachine *gb, uint32_t frame);
+
+/*
+    Starts recording input on gb.
+    @param from_snapshot -> true embeds a snapshot of gb as it is now,
+                            false power cycles gb so the movie starts from power-on.
+    @return              -> Empty movie, owned by the caller until tidy_movie().
+*/
+Movie *init_movie(GbcMachine *gb, bool from_snapshot);
+
+void tidy_movie(Movie *movie);
+
+/*
+    Appends one frame of input, sampled from the JoypadState that read_joypad() sees.
+    @note -> Call once per frame, after input is applied and before the frame is run.
+             Identical frames extend the previous run instead of growing the movie.
+*/
+void record_movie_frame(Movie *movie, GbcMachine *gb);
+
+uint32_t get_movie_length(Movie *movie);
+
+/*
+    Rewinds gb to the movie's start and replays every frame headless, as fast as the core runs.
+    @param on_frame -> optional per-frame callback, NULL to just reach the final state.
+    @return         -> false (machine untouched) if the movie was recorded with a different ROM.
+*/
+bool play_movie(Movie *movie, GbcMachine *gb, MovieFrameHandler on_frame, void *context);
+
+/*
+    Serialized layout: MovieHeader, snapshot (snapshot_size bytes), then run_count runs of
+    { uint8_t buttons, uint16_t frames } with no padding.
+*/
+size_t get_movie_size(Movie *movie);
+
+/*
+    @return -> Bytes written, or 0 if the buffer is too small.
+*/
+size_t save_movie(Movie *movie, uint8_t *buffer, size_t size);
+
+/*
+    @return -> NULL on bad magic, version or truncated runs.
+*/
+Movie *load_movie(const uint8_t *buffer, size_t size);
+
+bool write_movie_file(Movie *movie, const char *file_path);
+
+Movie *read_movie_file(const char *file_path);
+
+#endif
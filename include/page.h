@@ -0,0 +1,38 @@
+#ifndef PAGE_H
+#define PAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    Reference counted, copy-on-write memory pages.
+    Callers only ever hold the data pointer, so banks can keep being indexed as plain uint8_t arrays.
+    @note -> Counts are atomic; machines sharing a page may run on different threads.
+*/
+
+/*
+    Allocates a zeroed page with one reference.
+*/
+uint8_t *alloc_page(size_t size);
+
+/*
+    Adds a reference, e.g. when a forked child starts sharing its parent's bank.
+    @return -> The same data pointer. NULL passes through.
+*/
+uint8_t *share_page(uint8_t *data);
+
+/*
+    Drops a reference, freeing the page with the last one. NULL is ignored.
+*/
+void release_page(uint8_t *data);
+
+/*
+    Makes a page safe to write.
+    @return -> data itself when this is the only reference, otherwise a private copy
+               (the shared page loses one reference).
+*/
+uint8_t *own_page(uint8_t *data);
+
+size_t get_page_size(uint8_t *data);
+
+#endif
@@ -1,8 +1,16 @@
 #ifndef PPU_H
 #define PPU_H
 
-#define DOTS_PER_FRAME (uint32_t) 70224
-#define DOTS_PER_LINE  (uint16_t)   456
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct GbcMachine GbcMachine;
+
+#define DOTS_PER_FRAME  (uint32_t) 70224
+#define DOTS_PER_LINE   (uint16_t)   456
+#define LINES_PER_FRAME  (uint8_t)   154
+#define OAM_SCAN_DOTS   (uint16_t)    80
+#define DRAWING_DOTS    (uint16_t)   289 // Fixed, the whole line is rendered when it ends.
 
 typedef enum
 {
@@ -38,14 +46,64 @@ typedef enum
 
 } VRAMAddresses;
 
-bool init_graphics();
+bool init_graphics(GbcMachine *gb);
+
+void tidy_graphics(GbcMachine *gb);
+
+/*
+    Runs the PPU through the next 'dots' dots, changing mode, rendering and raising interrupts on the way.
+    @note -> Each mode counts down its own length, so a span without a mode change costs a subtraction.
+*/
+void ppu_advance(GbcMachine *gb, uint32_t dots);
+
+/*
+    The PPU runs lazily, behind gb->clock, and catches up when something could tell the difference.
+    sync_ppu() runs it through the dot the CPU is in: call before the bus touches PPU registers, VRAM or OAM.
+    catch_up_ppu() stops short of that dot, for callers between CPU slots (snapshots, the scheduler).
+*/
+void sync_ppu(GbcMachine *gb);
+
+void catch_up_ppu(GbcMachine *gb);
+
+/*
+    Counts the dots from gb->clock before the PPU changes mode, and with it LY or STAT.
+    @return -> 0 when the current dot starts a mode.
+*/
+uint32_t get_ppu_countdown(GbcMachine *gb);
+
+/*
+    Counts the dots from gb->clock before the PPU raises VBLANK or a rising edge of the STAT line, or starts an
+    HBlank while an HBlank HDMA waits for it.
+    @note -> Assumes STAT, LYC and HDMA5 keep their values, writes to them have to ask again.
+*/
+uint32_t get_ppu_deadline(GbcMachine *gb);
+
+/*
+    Re-evaluates LY=LYC and the combined STAT interrupt line after a write to STAT or LYC.
+    @note -> Requests LCD_STAT only on a rising edge of the line, like the hardware. Sync the PPU before the write.
+*/
+void refresh_stat_line(GbcMachine *gb);
+
+/*
+    Marks the tiles covering [offset, offset + length) of a VRAM bank for decoding again.
+    The PPU keeps every tile decoded to 2-bit color ids, plain and x-flipped, until its bytes change.
+    @note -> Whatever writes VRAM has to call this, the bus, HDMA and snapshot loads do.
+             Offsets past the tile data ($9800 onwards) are ignored.
+*/
+void invalidate_tiles(GbcMachine *gb, uint8_t bank, uint16_t offset, uint16_t length);
+
+void *render_frame(GbcMachine *gb);
 
-void tidy_graphics();
+bool is_frame_ready(GbcMachine *gb);
 
-void dot(uint32_t current_dot);
+size_t get_graphics_snapshot_size(GbcMachine *gb);
 
-void *render_frame();
+/*
+    Serializes PPU progress, the LCD buffer and the objects found by OAM scan into dest.
+    @return -> Cursor advanced past the PPU section.
+*/
+uint8_t *save_graphics_snapshot(GbcMachine *gb, uint8_t *dest);
 
-bool is_frame_ready();
+const uint8_t *load_graphics_snapshot(GbcMachine *gb, const uint8_t *src);
 
 #endif
\ No newline at end of file
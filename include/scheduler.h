@@ -0,0 +1,57 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct Scheduler Scheduler;
+
+typedef struct
+{
+    uint32_t  index; // Instance to advance.
+    uint32_t frames; // Frames to advance it by.
+
+} SchedulerTask;
+
+typedef void (*TaskHandler)(void *context, SchedulerTask *task);
+
+/*
+    Starts a pool of workers, each with its own task deque.
+    @param num_workers -> pool size (0 = one per logical CPU)
+    @param handler     -> runs one task; called concurrently, but never twice for the same task
+    @param context     -> passed through to the handler untouched
+    @return            -> The scheduler, or NULL if a worker thread could not be started.
+    @note              -> Workers pop their own deque from the bottom and, once it runs dry,
+                          steal from the top of a randomly chosen victim.
+*/
+Scheduler *init_scheduler(uint16_t num_workers, TaskHandler handler, void *context);
+
+void tidy_scheduler(Scheduler *scheduler);
+
+/*
+    Queues "advance instance index by frames".
+    @note -> Tasks are dealt to worker deques round-robin by index; stealing evens out the rest.
+*/
+void submit_task(Scheduler *scheduler, uint32_t index, uint32_t frames);
+
+/*
+    Blocks until every submitted task has finished.
+*/
+void wait_scheduler(Scheduler *scheduler);
+
+uint16_t get_worker_count(Scheduler *scheduler);
+
+/*
+    Fraction of wall time a worker has spent inside the handler since the last reset.
+    @return -> 0.0 (idle) to 1.0 (fully busy)
+*/
+double get_worker_utilization(Scheduler *scheduler, uint16_t worker);
+
+void reset_scheduler_stats(Scheduler *scheduler);
+
+/*
+    Logs utilization, tasks run and tasks stolen for every worker.
+*/
+void print_scheduler_stats(Scheduler *scheduler);
+
+#endif
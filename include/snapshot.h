@@ -0,0 +1,71 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SNAPSHOT_MAGIC   0x53434247 // "GBCS"
+#define SNAPSHOT_VERSION 7
+
+typedef struct GbcMachine GbcMachine;
+
+typedef struct
+{
+    uint32_t    magic;
+    uint16_t  version;
+    uint16_t reserved;
+    uint32_t     size; // Whole buffer, header included.
+    uint32_t rom_hash; // Snapshots only load into machines running the same ROM.
+
+} SnapshotHeader;
+
+/*
+    Bytes needed to snapshot this machine.
+    @note -> Constant for the lifetime of a machine, so callers can allocate once and reuse.
+*/
+size_t gbc_snapshot_size(GbcMachine *gb);
+
+/*
+    Serializes the whole machine into a flat versioned buffer.
+    @param buffer -> caller-owned, at least gbc_snapshot_size() bytes
+    @param size   -> capacity of buffer
+    @return       -> Bytes written, or 0 if the buffer is too small.
+    @note         -> Sections are written in a fixed order: CPU, MMU, PPU, TIMER, CARTRIDGE.
+                     Joypad input is front-end state and is not captured.
+*/
+size_t gbc_snapshot_save(GbcMachine *gb, uint8_t *buffer, size_t size);
+
+/*
+    Restores a machine from a buffer written by gbc_snapshot_save().
+    @return -> false (machine untouched) on bad magic, version, size or ROM.
+    @note   -> Plain copies into existing allocations; nothing is re-initialized or read from disk.
+*/
+bool gbc_snapshot_load(GbcMachine *gb, const uint8_t *buffer, size_t size);
+
+/*
+    Keeps a snapshot of the machine taken right after the BIOS register ($FF50) is written.
+    @note -> Called by the core once the dot that wrote it completes; only the first boot is captured.
+*/
+void capture_boot_snapshot(GbcMachine *gb);
+
+/*
+    Jumps straight to the post-boot state.
+    @return -> false if no boot snapshot has been captured or read for this machine.
+*/
+bool restore_boot_snapshot(GbcMachine *gb);
+
+/*
+    When enabled, captured boot snapshots are also written next to the ROM as <rom>.<hash>.boot.
+*/
+void set_boot_persistence(GbcMachine *gb, bool persist);
+
+bool write_boot_snapshot_file(GbcMachine *gb);
+
+/*
+    Loads a boot snapshot persisted by an earlier run.
+    @return -> false if there is none, or it belongs to a different ROM or snapshot version.
+*/
+bool read_boot_snapshot_file(GbcMachine *gb);
+
+#endif
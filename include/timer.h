@@ -1,18 +1,85 @@
 #ifndef TIMER_H
 #define TIMER_H
 
-void init_timer();
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
-void tidy_timer();
+typedef struct GbcMachine GbcMachine;
 
-void clear_sys();
+typedef enum
+{
+    EVENT_PPU   = 0, // VBLANK, rising edges of STAT and HDMA HBlanks (get_ppu_deadline()), the PPU catches up then.
+    EVENT_TIMER = 1, // The edge that overflows TIMA, then the reload.
+    EVENT_DMA   = 2, // End of an OAM DMA, when the CPU gets the bus back.
+    EVENT_FRAME = 3, // Last dot of the frame.
+    EVENT_BOOT  = 4, // Boot snapshot capture.
+    EVENT_COUNT = 5
 
-void write_tac(uint8_t value);
+} EventKind;
 
-void write_tima(uint8_t value);
+typedef struct
+{
+    uint64_t  halted; // Dots fast-forwarded in HALT.
+    uint64_t polling; // Dots fast-forwarded in loops polling LY, STAT, DIV or TIMA.
+    uint64_t   total; // Dots run since the machine was created.
 
-uint32_t system_clock_pulse();
+} IdleStats;
 
-char *get_emu_time(char *buffer, size_t size);
+void init_timer(GbcMachine *gb);
+
+void tidy_timer(GbcMachine *gb);
+
+void clear_sys(GbcMachine *gb);
+
+void write_tac(GbcMachine *gb, uint8_t value);
+
+void write_tima(GbcMachine *gb, uint8_t value);
+
+/*
+    Runs the CPU slot by slot up to the next dot with a scheduled event, or the end of the frame.
+    @return -> Dot within the frame where it stopped.
+    @note   -> Dots with an event are stepped in full (PPU, DMA, timer, CPU slot); the ones in between only run
+               the CPU's slots and advance SYS, DIV and TIMA in closed form.
+*/
+uint32_t system_clock_pulse(GbcMachine *gb);
+
+/*
+    Runs the machine for exactly 'dots' dots, however many events fall inside them.
+    @note -> For callers that need a machine at a given dot (tests, tools); a FAST_EXECUTION instruction may still owe
+             cycles at the end, paid on its next bus access as usual.
+*/
+void run_machine_dots(GbcMachine *gb, uint64_t dots);
+
+/*
+    Makes the next dot a full step, after which the event is scheduled again from the new state.
+    @note -> Call after writing anything an event's timing depends on (TIMA/TAC/DIV, DMA, BIOS).
+*/
+void refresh_event(GbcMachine *gb, EventKind kind);
+
+/*
+    Runs the PPU, DMA and timer through the M-cycles a FAST_EXECUTION instruction has already executed,
+    stopping at the CPU's slot of the current one.
+    @note -> Called on every bus access and interrupt check, so a no-op unless owed_cycles is set.
+*/
+void sync_machine_cycles(GbcMachine *gb);
+
+/*
+    Fast-forwarding skips dots where the CPU is halted or spinning in a polling loop, straight to the next
+    dot that can wake it or change what it reads. On by default.
+    @note -> Skipped stretches are replayed in closed form and come out identical; turn it off for accuracy
+             tests that want every dot stepped anyway. Kept across power cycles.
+*/
+void set_idle_skipping(GbcMachine *gb, bool enabled);
+
+IdleStats get_idle_stats(GbcMachine *gb);
+
+char *get_emu_time(GbcMachine *gb, char *buffer, size_t size);
+
+size_t get_timer_snapshot_size(GbcMachine *gb);
+
+uint8_t *save_timer_snapshot(GbcMachine *gb, uint8_t *dest);
+
+const uint8_t *load_timer_snapshot(GbcMachine *gb, const uint8_t *src);
 
 #endif
\ No newline at end of file
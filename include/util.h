@@ -1,7 +1,9 @@
 #ifndef UTIL_H
 #define UTIL_H
 
-typedef struct
+#include <stddef.h>
+
+typedef struct GbcPixel
 {
     uint16_t oam_address;
     uint8_t     color_id;
@@ -19,7 +21,7 @@ typedef struct
 
 } GbcPixel; 
 
-typedef struct
+typedef struct Queue
 {
     GbcPixel **items;
     int        front;
@@ -51,4 +53,22 @@ uint8_t queue_size(Queue *queue);
 
 void print_queue(Queue *queue);
 
+/*
+    Queue contents are machine state (e.g. objects found during OAM scan), so snapshots carry them.
+    @return -> Cursor advanced past the queue.
+*/
+uint8_t *save_queue(Queue *queue, uint8_t *dest);
+
+const uint8_t *load_queue(Queue *queue, const uint8_t *src);
+
+size_t get_queue_snapshot_size(Queue *queue);
+
+/*
+    Cursor helpers for flat snapshot buffers.
+    @return -> Cursor advanced by size bytes.
+*/
+uint8_t *pack_bytes(uint8_t *dest, const void *src, size_t size);
+
+const uint8_t *unpack_bytes(const uint8_t *src, void *dest, size_t size);
+
 #endif
@@ -0,0 +1,70 @@
+#ifndef VEC_ENV_H
+#define VEC_ENV_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "common.h"
+#include "mmu.h"
+
+#define VEC_ENV_FRAME_SIZE (GBC_WIDTH * GBC_HEIGHT) // Pixels (ARGB8888) per framebuffer.
+#define VEC_ENV_RAM_SIZE   WRAM_VIEW_SIZE           // Bytes per RAM view.
+
+typedef struct GbcMachine GbcMachine;
+
+typedef struct GbcVecEnv GbcVecEnv;
+
+typedef struct Scheduler Scheduler;
+
+/*
+    Creates a batch of headless machines that all boot the same ROM.
+    @param file_path   -> location of ROM file shared by every instance
+    @param num_envs    -> number of emulator instances
+    @param num_workers -> size of the work-stealing pool (0 = one per logical CPU)
+    @return            -> The environment, or NULL if the ROM could not be loaded or the worker pool could not be started.
+*/
+GbcVecEnv *init_vec_env(char *file_path, uint16_t num_envs, uint16_t num_workers);
+
+/*
+    Stops the worker pool and tidies every instance.
+*/
+void tidy_vec_env(GbcVecEnv *env);
+
+/*
+    Advances every instance by the same number of frames.
+    @param actions      -> num_envs JoypadButton bitmasks, held for the whole step (NULL = keep current input)
+    @param frames       -> frames to run per instance
+    @param framebuffers -> caller-owned, num_envs * VEC_ENV_FRAME_SIZE pixels (NULL = skip)
+    @param ram          -> caller-owned, num_envs * VEC_ENV_RAM_SIZE bytes (NULL = skip)
+    @note               -> Blocks until every instance is done. Each instance is one scheduler task, and
+                           observations are copied by whichever worker ran it, landing at offset k.
+*/
+void step_vec_env
+(
+    GbcVecEnv     *env,
+    const uint8_t *actions,
+    uint32_t       frames,
+    uint32_t      *framebuffers,
+    uint8_t       *ram
+);
+
+/*
+    Puts one instance back at the start of the game, e.g. when its episode ends.
+    @note -> Uses fast_reset_emulator(), so after the first boot this is a snapshot restore.
+             Only safe while no step is in flight.
+*/
+void reset_vec_env(GbcVecEnv *env, uint16_t index);
+
+uint16_t get_vec_env_size(GbcVecEnv *env);
+
+/*
+    The scheduler stepping this environment, e.g. for print_scheduler_stats().
+*/
+Scheduler *get_vec_env_scheduler(GbcVecEnv *env);
+
+/*
+    Direct access to one instance, e.g. for snapshots or debugging between steps.
+    @note -> Only safe while no step is in flight.
+*/
+GbcMachine *get_vec_env_machine(GbcVecEnv *env, uint16_t index);
+
+#endif
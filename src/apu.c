@@ -89,38 +89,38 @@ typedef struct
 
 static Apu *apu;
 
-init_apu()
+init_apu(GbcMachine *gb)
 {
     ch1 = (CH1*) malloc(sizeof(CH1));
-    ch1->nr10 = get_memory_pointer(NR10);
-    ch1->nr11 = get_memory_pointer(NR11);
-    ch1->nr12 = get_memory_pointer(NR12);
-    ch1->nr13 = get_memory_pointer(NR13);
-    ch1->nr14 = get_memory_pointer(NR14);
+    ch1->nr10 = get_memory_pointer(gb, NR10);
+    ch1->nr11 = get_memory_pointer(gb, NR11);
+    ch1->nr12 = get_memory_pointer(gb, NR12);
+    ch1->nr13 = get_memory_pointer(gb, NR13);
+    ch1->nr14 = get_memory_pointer(gb, NR14);
 
     ch2 = (CH2*) malloc(sizeof(CH2));
-    ch2->nr21 = get_memory_pointer(NR21);
-    ch2->nr22 = get_memory_pointer(NR22);
-    ch2->nr23 = get_memory_pointer(NR23);
-    ch2->nr24 = get_memory_pointer(NR24);
+    ch2->nr21 = get_memory_pointer(gb, NR21);
+    ch2->nr22 = get_memory_pointer(gb, NR22);
+    ch2->nr23 = get_memory_pointer(gb, NR23);
+    ch2->nr24 = get_memory_pointer(gb, NR24);
 
     ch3 = (CH3*) malloc(sizeof(CH3));
-    ch3->nr30 = get_memory_pointer(NR30);
-    ch3->nr31 = get_memory_pointer(NR31);
-    ch3->nr32 = get_memory_pointer(NR32);
-    ch3->nr33 = get_memory_pointer(NR33);
-    ch3->nr34 = get_memory_pointer(NR34);
+    ch3->nr30 = get_memory_pointer(gb, NR30);
+    ch3->nr31 = get_memory_pointer(gb, NR31);
+    ch3->nr32 = get_memory_pointer(gb, NR32);
+    ch3->nr33 = get_memory_pointer(gb, NR33);
+    ch3->nr34 = get_memory_pointer(gb, NR34);
 
     ch4 = (CH4*) malloc(sizeof(CH4));
-    ch4->nr41 = get_memory_pointer(NR41);
-    ch4->nr42 = get_memory_pointer(NR42);
-    ch4->nr43 = get_memory_pointer(NR43);
-    ch4->nr44 = get_memory_pointer(NR44);
+    ch4->nr41 = get_memory_pointer(gb, NR41);
+    ch4->nr42 = get_memory_pointer(gb, NR42);
+    ch4->nr43 = get_memory_pointer(gb, NR43);
+    ch4->nr44 = get_memory_pointer(gb, NR44);
 
     apu = (Apu*) malloc(sizeof(Apu));
-    apu->nr50 = get_memory_pointer(NR50);
-    apu->nr51 = get_memory_pointer(NR51);
-    apu->nr52 = get_memory_pointer(NR52);
+    apu->nr50 = get_memory_pointer(gb, NR50);
+    apu->nr51 = get_memory_pointer(gb, NR51);
+    apu->nr52 = get_memory_pointer(gb, NR52);
 }
 
 tidy_apu()
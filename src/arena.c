@@ -0,0 +1,95 @@
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include "arena.h"
+#include "logger.h"
+
+#define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
+
+#define HUGE_PAGE_SIZE   0x200000
+#define ARENA_HOT_SIZE     0x1000 // First 4 KB, bookkeeping included.
+#define ARENA_HOT_LIMIT       512 // Largest piece still considered hot.
+
+typedef struct Arena
+{
+    uint8_t   *mapping; // What munmap() gets back, may start before the arena when aligned for a huge page.
+    size_t     mapped;
+    size_t       size;
+    size_t        hot; // Next free byte of the hot region.
+    size_t       bulk; // Next free byte of the bulk region.
+
+} Arena;
+
+static atomic_bool huge_pages = false;
+
+static size_t align_up(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+void set_huge_pages(bool enabled)
+{
+    atomic_store(&huge_pages, enabled);
+}
+
+Arena *init_arena(size_t size)
+{
+    bool   huge   = atomic_load(&huge_pages);
+    size          = align_up((size > ARENA_HOT_SIZE) ? size : 2 * ARENA_HOT_SIZE, huge ? HUGE_PAGE_SIZE : CACHE_LINE_SIZE);
+    size_t mapped = huge ? size + HUGE_PAGE_SIZE : size; // Slack to align the start on a huge page.
+
+    uint8_t *mapping = (uint8_t*) mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+        LOG_MESSAGE(ERROR, "Could not map a %zu byte arena.", size);
+        return NULL;
+    }
+
+    uint8_t *base = huge ? (uint8_t*) align_up((size_t) mapping, HUGE_PAGE_SIZE) : mapping;
+#ifdef MADV_HUGEPAGE
+    if (huge && (madvise(base, size, MADV_HUGEPAGE) != 0))
+    {
+        LOG_MESSAGE(WARNING, "Huge pages refused, the arena stays on regular pages.");
+    }
+#endif
+
+    Arena *arena   = (Arena*) base; // Anonymous mappings come zeroed.
+    arena->mapping = mapping;
+    arena->mapped  = mapped;
+    arena->size    = size;
+    arena->hot     = align_up(sizeof(Arena), CACHE_LINE_SIZE);
+    arena->bulk    = ARENA_HOT_SIZE;
+    return arena;
+}
+
+void tidy_arena(Arena *arena)
+{
+    if (arena == NULL) return;
+    munmap(arena->mapping, arena->mapped);
+}
+
+void *arena_alloc(Arena *arena, size_t size)
+{
+    size = align_up(size, CACHE_LINE_SIZE);
+    if ((size <= ARENA_HOT_LIMIT) && (arena->hot + size <= ARENA_HOT_SIZE))
+    {
+        void *piece = (uint8_t*) arena + arena->hot;
+        arena->hot += size;
+        return piece;
+    }
+    if (arena->bulk + size > arena->size)
+    {
+        LOG_MESSAGE(ERROR, "Arena exhausted, %zu more bytes requested with %zu left.", size, arena->size - arena->bulk);
+        return NULL;
+    }
+    void *piece  = (uint8_t*) arena + arena->bulk;
+    arena->bulk += size;
+    return piece;
+}
+
+size_t get_arena_used(Arena *arena)
+{
+    return arena->bulk - ARENA_HOT_SIZE + arena->hot;
+}
@@ -2,10 +2,15 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include "arena.h"
 #include "mmu.h"
 #include "cart.h"
 #include "common.h"
 #include "logger.h"
+#include "image.h"
+#include "machine.h"
+#include "page.h"
+#include "util.h"
 
 #define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
 #define DEFAULT_BANK 1
@@ -79,7 +84,7 @@ typedef enum
 
 /* STATE MANGEMENT */
 
-typedef struct
+typedef struct Header
 { 
     char     title[15]; // Game Title        | 0x0134 - 0x0143
     uint8_t   cgb_code; // Enable Color Mode | 0x0143 - 0x0144
@@ -92,10 +97,13 @@ typedef struct
 
 } Header;
 
-typedef struct
+typedef struct Cartridge
 {
     unsigned long    file_size;
     CartridgeCode    cart_code;
+    const uint8_t         *rom; // Mapped once per process, see image.c.
+    uint8_t               *ram; // Per-instance page, forks share it until written.
+    bool             ram_dirty;
     
     bool           ram_enabled;
     uint8_t          bank_mode;
@@ -105,69 +113,21 @@ typedef struct
     uint8_t           ram_code;
     uint8_t  ram_bank_quantity;
     
+    uint32_t          rom_hash;
     uint8_t           rom_code;
     uint16_t rom_bank_quantity;
     uint8_t      rom_bank_mask;
 
 } Cartridge;
 
-/* GLOBAL STATE POINTERS */
-
-static Cartridge   *cart;
-static Header    *header;
-static uint8_t      *rom;
-static uint8_t *dmg_bios;
-static uint8_t *cgb_bios;
-static uint8_t     *bios;
-static char   *main_file;
-
 /* STATIC (PRIVATE) HELPERS FUNCTIONS */
 
-bool is_gbc() // $80 or $C0
+bool is_gbc(GbcMachine *gb) // $80 or $C0
 {
-    return ((header->cgb_code == 0x80) || (header->cgb_code == 0xC0));
+    return ((gb->header->cgb_code == 0x80) || (gb->header->cgb_code == 0xC0));
 }
 
-static uint8_t *get_rom_content(char *file_path, Cartridge *cart) // Reads file and returns pointer to loaded content.
-{
-    // Open file with fopen() in "r"ead "b"inary mode.
-    //LOG_MESSAGE(INFO, "Reading file at %s", file_path);
-    FILE *file = fopen(file_path, "rb");
-    if (file == NULL) {
-        LOG_MESSAGE(ERROR, "Failed to open file.");
-        return NULL;
-    }
-
-    // Move to end of file to find its size.
-    fseek(file, 0, SEEK_END);
-    long file_size = ftell(file);
-    rewind(file);
-
-    // Allocate memory to a buffer.
-    uint8_t *buffer = (uint8_t*) malloc(file_size);
-    if (buffer == NULL) {
-       // LOG_MESSAGE(ERROR, "Memory allocation failed.");
-        fclose(file);
-        return NULL;
-    }
-
-    // Read value into buffer.
-    size_t bytesRead = fread(buffer, 1, file_size, file);
-    if (bytesRead != file_size) {
-       // LOG_MESSAGE(ERROR, "Error reading ROM file.");
-        fclose(file);
-        return NULL;
-    }
-
-   // LOG_MESSAGE(INFO, "Successfully loaded %ld bytes from %s.", file_size, file_path);
-    cart->file_size = file_size;
-    // Tidy up.
-    fclose(file);
-
-    return buffer;
-}
-
-static void load_rom_title(Header *header, uint8_t *rom)          // Loads cartridge title from ROM.
+static void load_rom_title(Header *header, const uint8_t *rom)          // Loads cartridge title from ROM.
 {
     int size = 15; 
     for (int i = 0; i < size - 1; i++) 
@@ -177,7 +137,7 @@ static void load_rom_title(Header *header, uint8_t *rom)          // Loads cartr
     header->title[size - 1] = '\0';
 }
 
-static void load_header(Header *header, uint8_t *rom)             // Load header data into struct.
+static void load_header(Header *header, const uint8_t *rom)             // Load header data into struct.
 {
     header->cart_code = rom[MBC_SCHEMA_ADDRESS];
     header-> cgb_code = rom[COLOR_MODE_ENABLE_ADDRESS];
@@ -285,6 +245,19 @@ static void encode_rom_settings(Cartridge *cart)
     cart->rom_bank_mask = get_bank_mask(cart->rom_bank_quantity);
 }
 
+static void encode_cart_code(Cartridge *cart, Header *header)
+{
+    switch (header->cart_code)
+    {
+        case ROM_ONLY:
+        case MBC1:
+        case MBC1_RAM:
+        case MBC1_RAM_BATTERY: cart->cart_code = header->cart_code; return;
+    }
+    LOG_MESSAGE(WARNING, "%s is not implemented, running as ROM ONLY.", get_cartridge_name(header->cart_code));
+    cart->cart_code = ROM_ONLY; // The other handlers are still stubs.
+}
+
 static void encode_ram_settings(Cartridge *cart, Header *header)
 {
     cart->ram_enabled = 
@@ -313,6 +286,44 @@ static void encode_ram_settings(Cartridge *cart, Header *header)
     }
 }
 
+static uint32_t hash_rom(const uint8_t *rom, unsigned long size)        // FNV-1a, identifies a ROM image for snapshots.
+{
+    uint32_t hash = 0x811C9DC5;
+    for (unsigned long i = 0; i < size; i++)
+    {
+        hash ^= rom[i];
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+static size_t get_ram_size(Cartridge *cart)
+{
+    return (size_t) cart->ram_bank_quantity * RAM_BANK_SIZE;
+}
+
+static uint32_t get_ram_offset(Cartridge *cart, uint16_t address)  // Banked offset into cart->ram.
+{
+    uint8_t bank = (cart->bank_mode == MBC1_RAM_BANK_MODE) ? cart->upper_bits : 0;
+    return ((bank % cart->ram_bank_quantity) * RAM_BANK_SIZE) + (address - EXT_RAM_ADDRESS_START);
+}
+
+static uint32_t get_mbc1_rom_offset(Cartridge *cart, uint16_t address) // Offset into cart->rom for $4000-$7FFF.
+{
+    uint8_t rom_bank = (cart->upper_bits << 5) + cart->rom_bank_sel;
+    return ((uint32_t) rom_bank * ROM_BANK_SIZE) + (address - BANK_N_ADDRESS_START);
+}
+
+static uint8_t *get_writable_ram(Cartridge *cart)                 // First write since a fork takes a private copy.
+{
+    if (!cart->ram_dirty)
+    {
+        cart->ram       = own_page(cart->ram);
+        cart->ram_dirty = true;
+    }
+    return cart->ram;
+}
+
 /* CLIENT (PUBLIC) FUNCTIONS */
 
 typedef uint8_t (*MbcReadHandler)(Cartridge*, uint16_t); /* CARTRIDGE MEMORY READING */
@@ -321,7 +332,7 @@ static uint8_t rom_only_read(Cartridge *cart, uint16_t address)
 {
     if (address <= BANK_N_ADDRESS_END)
     {
-        return rom[address];
+        return cart->rom[address];
     }
 }
 
@@ -329,14 +340,13 @@ static uint8_t mbc1_read(Cartridge *cart, uint16_t address)
 {
     if ((address >= 0x0000) && (address <= 0x3FFF)) // Static Bank
     {
-        return rom[address];
+        return cart->rom[address];
     }
 
     if ((address >= 0x4000) && (address <= 0x7FFF)) // Dynamic Bank
     {
-        uint8_t rom_bank = (cart->upper_bits << 5) + cart->rom_bank_sel;
-        uint16_t  offset = rom_bank * ROM_BANK_SIZE;
-        return rom[address + offset];
+        uint32_t offset = get_mbc1_rom_offset(cart, address);
+        return (offset < cart->file_size) ? cart->rom[offset] : 0xFF; // Header can claim more banks than the file has.
     }
 }
 static uint8_t mbc1_ram_read(Cartridge *cart, uint16_t address)
@@ -346,17 +356,11 @@ static uint8_t mbc1_ram_read(Cartridge *cart, uint16_t address)
         return mbc1_read(cart, address);
     }
 
-    if (is_ram_accessible(cart, address) && (cart->bank_mode == MBC1_ROM_BANK_MODE)) // RAM Read
-    {
-        return rom[address];
-    }
-
-    if (is_ram_accessible(cart, address) && (cart->bank_mode == MBC1_RAM_BANK_MODE)) // RAM Read
+    if (is_ram_accessible(cart, address) && cart->ram) // RAM Read
     {
-        uint16_t      offset = (cart->upper_bits * RAM_BANK_SIZE);
-        uint16_t ext_address = (address + offset);
-        return rom[ext_address];        
+        return cart->ram[get_ram_offset(cart, address)];
     }
+    return 0xFF; // Open bus.
 }
 
 static uint8_t mbc2_read(Cartridge *cart, uint16_t address)
@@ -458,24 +462,61 @@ const MbcReadHandler mbc_read_table[0x23] =
     [MBC7_SENSOR_RUMBLE_RAM_BATTERY] =         mbc7_read,
 };
 
-uint8_t read_rom_memory(uint16_t address) // Public API
+uint8_t read_rom_memory(GbcMachine *gb, uint16_t address) // Public API
 {   
-    if ((*bios) == 1)
+    if ((*gb->bios) == 1)
     {
-        return mbc_read_table[cart->cart_code](cart, address);
+        return mbc_read_table[gb->cart->cart_code](gb->cart, address);
     }
 
-    if (((*bios) == 0) && (is_gbc()) && ((address < 0x0100) || (address >= 0x0200)))
+    if (((*gb->bios) == 0) && (is_gbc(gb)) && ((address < 0x0100) || (address >= 0x0200)))
     {
-        return cgb_bios[address];
+        return gb->cgb_bios[address];
     }
 
-    if (((*bios) ==  0) && (!is_gbc()) && (address < 0x0100))
+    if (((*gb->bios) ==  0) && (!is_gbc(gb)) && (address < 0x0100))
     {
-        return dmg_bios[address];
+        return gb->dmg_bios[address];
     }
     
-    return mbc_read_table[cart->cart_code](cart, address);
+    return mbc_read_table[gb->cart->cart_code](gb->cart, address);
+}
+
+static bool has_mapped_banks(Cartridge *cart) // MBCs whose handlers resolve to plain ROM and RAM offsets.
+{
+    switch (cart->cart_code)
+    {
+        case ROM_ONLY:
+        case MBC1:
+        case MBC1_RAM:
+        case MBC1_RAM_BATTERY: return true;
+        default:               return false;
+    }
+}
+
+static uint8_t *get_ram_page(Cartridge *cart, uint16_t address)
+{
+    bool has_ram = (cart->cart_code == MBC1_RAM) || (cart->cart_code == MBC1_RAM_BATTERY);
+    if (!has_ram || !cart->ram || !is_ram_accessible(cart, address)) return NULL; // Open bus takes the handler.
+    return cart->ram + get_ram_offset(cart, address);
+}
+
+const uint8_t *get_cart_read_page(GbcMachine *gb, uint16_t address) // Public API
+{
+    Cartridge *cart = gb->cart;
+    if (((*gb->bios) == 0) || !has_mapped_banks(cart)) return NULL;
+    if (address > BANK_N_ADDRESS_END) return get_ram_page(cart, address);
+
+    uint32_t offset = address;
+    if ((address >= BANK_N_ADDRESS_START) && (cart->cart_code != ROM_ONLY)) offset = get_mbc1_rom_offset(cart, address);
+    return ((offset + MEMORY_PAGE_SIZE) <= cart->file_size) ? (cart->rom + offset) : NULL;
+}
+
+uint8_t *get_cart_write_page(GbcMachine *gb, uint16_t address) // Public API
+{
+    Cartridge *cart = gb->cart;
+    if ((address < EXT_RAM_ADDRESS_START) || ((*gb->bios) == 0) || !cart->ram_dirty) return NULL;
+    return get_ram_page(cart, address);
 }
 
 typedef void (*MbcWriteHandler)(Cartridge*, uint16_t, uint8_t); /* CARTRIDGE MEMORY WRITING */
@@ -521,17 +562,9 @@ static void mbc1_ram_write(Cartridge *cart, uint16_t address, uint8_t value)
         return;
     }
 
-    if (is_ram_accessible(cart, address) && (cart->bank_mode == MBC1_ROM_BANK_MODE))
-    {
-        rom[address] = value;
-        return;
-    }
-
-    if (is_ram_accessible(cart, address) && (cart->bank_mode == MBC1_RAM_BANK_MODE))
+    if (is_ram_accessible(cart, address) && cart->ram)
     {
-        uint16_t          offset = (cart->upper_bits * RAM_BANK_SIZE);
-        uint16_t ext_ram_address = (address + offset);
-        rom[ext_ram_address] = value;
+        get_writable_ram(cart)[get_ram_offset(cart, address)] = value;
         return;
     }
 }
@@ -627,31 +660,118 @@ const MbcWriteHandler mbc_write_table[0x23] =
     [MBC7_SENSOR_RUMBLE_RAM_BATTERY] =         mbc7_write,
 };
 
-void write_rom_memory(uint16_t address, uint8_t value) // Public API
+void write_rom_memory(GbcMachine *gb, uint16_t address, uint8_t value) // Public API
 {
-    if ((*bios) == 0) return;
-    mbc_write_table[cart->cart_code](cart, address, value);
+    if ((*gb->bios) == 0) return;
+    mbc_write_table[gb->cart->cart_code](gb->cart, address, value);
 }
 
-void init_cartridge(char *file_path)
+bool init_cartridge(GbcMachine *gb, char *file_path)
 {
-    header    = (Header*) malloc(sizeof(Header));
-    cart      = (Cartridge*) malloc(sizeof(Cartridge));
-    dmg_bios  = get_rom_content(DMG_BIOS,  cart);
-    cgb_bios  = get_rom_content(CGB_BIOS,  cart);
-    rom       = get_rom_content(file_path, cart);
-    bios      = get_memory_pointer(BIOS);
-    main_file = file_path;
-    load_header(header, rom);
+    size_t      size = 0;
+    Cartridge *cart = (Cartridge*) arena_alloc(gb->arena, sizeof(Cartridge));
+    gb->header      = (Header*) arena_alloc(gb->arena, sizeof(Header));
+    gb->cart        = cart;
+    gb->dmg_bios    = map_image(DMG_BIOS,  &size);
+    gb->cgb_bios    = map_image(CGB_BIOS,  &size);
+    cart->rom       = map_image(file_path, &size);
+    cart->file_size = size;
+    if ((gb->dmg_bios == NULL) || (gb->cgb_bios == NULL) || (cart->rom == NULL))
+    { // map_image() logged which file, tidy_cartridge() drops whatever did map.
+        LOG_MESSAGE(ERROR, "Cartridge %s not loaded, it or a BIOS image could not be mapped.", file_path);
+        return false;
+    }
+    gb->bios        = get_memory_pointer(gb, BIOS);
+    gb->main_file   = file_path;
+    cart->rom_hash  = hash_rom(cart->rom, cart->file_size);
+    cart->rom_code  = cart->rom[ROM_SETTINGS_ADDRESS]; // Sizes the bank registers.
+    cart->ram_code  = cart->rom[RAM_SETTINGS_ADDRESS]; // Sizes the RAM split out of the ROM image.
+    load_header(gb->header, cart->rom);
+    encode_cart_code(cart, gb->header);
     encode_rom_settings(cart);
-    encode_ram_settings(cart, header);
+    encode_ram_settings(cart, gb->header);
+    cart->ram       = get_ram_size(cart) ? alloc_page(get_ram_size(cart)) : NULL;
+    remap_memory(gb);
+    return true;
+}
+
+void fork_cartridge(GbcMachine *gb, GbcMachine *parent)
+{
+    Cartridge *cart = (Cartridge*) arena_alloc(gb->arena, sizeof(Cartridge));
+    (*cart)         = (*parent->cart);
+    gb->header      = (Header*) arena_alloc(gb->arena, sizeof(Header));
+    (*gb->header)   = (*parent->header);
+    gb->cart        = cart;
+    gb->dmg_bios    = share_image(parent->dmg_bios);
+    gb->cgb_bios    = share_image(parent->cgb_bios);
+    cart->rom       = share_image(parent->cart->rom);
+    cart->ram       = share_page(parent->cart->ram);
+    gb->bios        = get_memory_pointer(gb, BIOS);
+    gb->main_file   = parent->main_file;
+
+    cart->ram_dirty         = false;
+    parent->cart->ram_dirty = false; // The parent's RAM is shared now too.
+    remap_memory(gb);
+    remap_memory(parent);
 }
 
-void tidy_cartridge()
+void tidy_cartridge(GbcMachine *gb)
 {
-    free(header);     header = NULL;
-    free(cart);         cart = NULL;
-    free(dmg_bios); dmg_bios = NULL;
-    free(cgb_bios); cgb_bios = NULL;
-    free(rom);           rom = NULL;
-}
\ No newline at end of file
+    unmap_image(gb->cart->rom);  gb->cart->rom = NULL;
+    release_page(gb->cart->ram); gb->cart->ram = NULL;
+    gb->header = NULL; // Both live in the arena.
+    gb->cart   = NULL;
+    unmap_image(gb->dmg_bios);    gb->dmg_bios = NULL;
+    unmap_image(gb->cgb_bios);    gb->cgb_bios = NULL;
+}
+
+const uint8_t *get_rom_image(GbcMachine *gb)
+{
+    return gb->cart->rom;
+}
+
+uint32_t get_rom_hash(GbcMachine *gb)
+{
+    return gb->cart->rom_hash;
+}
+
+uint16_t get_rom_bank(GbcMachine *gb)
+{
+    Cartridge *cart = gb->cart;
+    switch (cart->cart_code)
+    {
+        case ROM_ONLY:         return DEFAULT_BANK;
+        case MBC1:
+        case MBC1_RAM:
+        case MBC1_RAM_BATTERY: return (uint16_t) ((cart->upper_bits << 5) + cart->rom_bank_sel); // As mbc1_read().
+        default:               return cart->rom_bank_sel;
+    }
+}
+
+size_t get_cartridge_snapshot_size(GbcMachine *gb)
+{
+    return sizeof(bool) + (3 * sizeof(uint8_t)) + get_ram_size(gb->cart);
+}
+
+uint8_t *save_cartridge_snapshot(GbcMachine *gb, uint8_t *dest)
+{
+    Cartridge *cart = gb->cart;
+    dest = pack_bytes(dest, &cart->ram_enabled,  sizeof(bool));
+    dest = pack_bytes(dest, &cart->bank_mode,    sizeof(uint8_t));
+    dest = pack_bytes(dest, &cart->rom_bank_sel, sizeof(uint8_t));
+    dest = pack_bytes(dest, &cart->upper_bits,   sizeof(uint8_t));
+    if (cart->ram) dest = pack_bytes(dest, cart->ram, get_ram_size(cart));
+    return dest;
+}
+
+const uint8_t *load_cartridge_snapshot(GbcMachine *gb, const uint8_t *src)
+{
+    Cartridge *cart = gb->cart;
+    src = unpack_bytes(src, &cart->ram_enabled,  sizeof(bool));
+    src = unpack_bytes(src, &cart->bank_mode,    sizeof(uint8_t));
+    src = unpack_bytes(src, &cart->rom_bank_sel, sizeof(uint8_t));
+    src = unpack_bytes(src, &cart->upper_bits,   sizeof(uint8_t));
+    if (cart->ram) src = unpack_bytes(src, get_writable_ram(cart), get_ram_size(cart));
+    remap_memory(gb);
+    return src;
+}
@@ -1,16 +1,23 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdlib.h> 
 #include <string.h>
+#include "arena.h"
 #include "common.h"
 #include "cpu.h"
 #include "cart.h"
 #include "disassembler.h"
+#include "jit.h"
 #include "logger.h"
+#include "machine.h"
 #include "mmu.h"
+#include "ppu.h"
 #include "timer.h"
+#include "util.h"
 
 #define STR_BUFFER_SIZE 128
+#define MAX_INS_DURATION  6 // M-cycles of CALL nn, the longest instruction.
 #define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
 
 typedef struct InstructionEntity
@@ -23,12 +30,14 @@ typedef struct InstructionEntity
     uint8_t    opcode;
     char       *label;
     bool     executed;
+    const uint8_t *operands; // Immediates from the block cache, served by fetch() instead of the bus.
+    uint8_t   operands_left;
 
-    bool (*handler)(struct InstructionEntity*);
+    bool (*handler)(GbcMachine*, struct InstructionEntity*);
 
 } InstructionEntity;
 
-typedef bool (*OpcodeHandler)(InstructionEntity*);
+typedef bool (*OpcodeHandler)(GbcMachine*, InstructionEntity*);
 
 /* CONSTANTS FOR READABILITY */
 
@@ -51,31 +60,47 @@ typedef enum
 
 /* STATE MANGEMENT */
 
-typedef struct
+typedef struct CPU
 {
     bool              ime;
     bool    speed_enabled;
     bool          running;
     bool           halted;
     bool  halt_bug_active;
+    uint16_t      stalled; // M-cycles left without the bus, an HDMA block is being copied.
 
 } CPU;
 
-typedef struct
+typedef enum
+{
+    FLAGS_SETTLED = 0, // R->F is current.
+    FLAGS_ADD,         // ADD, ADC
+    FLAGS_SUB,         // SUB, SBC, CP
+    FLAGS_AND,
+    FLAGS_OR,          // OR, XOR
+    FLAGS_INC,
+    FLAGS_DEC,
+    FLAGS_SHIFT        // CB rotates and shifts, SWAP
+
+} FlagSource;
+
+typedef struct LazyFlags
+{
+    uint8_t source; // FlagSource of the last ALU operation, F is derived from it when read.
+    uint8_t   left;
+    uint8_t  right;
+    uint8_t result;
+    uint8_t  carry; // 0/1: carry in for ADD/SUB, carry kept by INC/DEC, carry out of a shift.
+
+} LazyFlags;
+
+typedef struct InterruptEnableEvent
 {
     uint8_t delay;
     bool   active;
 
 } InterruptEnableEvent;
 
-/* GLOBAL STATE POINTERS */
-
-static CPU                  *cpu;
-static Register               *R;
-static InterruptEnableEvent *iee;
-static InstructionEntity    *ins;
-static bool          cb_prefixed;
-
 /* STATIC (PRIVATE) HELPERS FUNCTIONS */
 
 static uint16_t form_address(InstructionEntity *ins)
@@ -86,93 +111,223 @@ static uint16_t form_address(InstructionEntity *ins)
     return address;
 }
 
-static void write_flag_reg(uint8_t value)
-{
-    R->F = (value & 0xF0); // Only the upper nibble.
+/* DECODED OPCODES */
+
+// Opcodes whose handlers are generated from a shared body (see DECODED_HANDLER), listed as hex literals for token pasting.
+#define OPCODE_ROW(X, r)     X(0x##r##0) X(0x##r##1) X(0x##r##2) X(0x##r##3) X(0x##r##4) X(0x##r##5) X(0x##r##6) X(0x##r##7) \
+                             X(0x##r##8) X(0x##r##9) X(0x##r##A) X(0x##r##B) X(0x##r##C) X(0x##r##D) X(0x##r##E) X(0x##r##F)
+#define LD_R_R_OPCODES(X)    /* LD r, r' but LD r, r (NOP) and HALT */ \
+    X(0x41) X(0x42) X(0x43) X(0x44) X(0x45) X(0x46) X(0x47) X(0x48) X(0x4A) X(0x4B) X(0x4C) X(0x4D) X(0x4E) X(0x4F) \
+    X(0x50) X(0x51) X(0x53) X(0x54) X(0x55) X(0x56) X(0x57) X(0x58) X(0x59) X(0x5A) X(0x5C) X(0x5D) X(0x5E) X(0x5F) \
+    X(0x60) X(0x61) X(0x62) X(0x63) X(0x65) X(0x66) X(0x67) X(0x68) X(0x69) X(0x6A) X(0x6B) X(0x6C) X(0x6E) X(0x6F) \
+    X(0x70) X(0x71) X(0x72) X(0x73) X(0x74) X(0x75) X(0x77) X(0x78) X(0x79) X(0x7A) X(0x7B) X(0x7C) X(0x7D) X(0x7E)
+#define ALU_A_R_OPCODES(X)   OPCODE_ROW(X, 8) OPCODE_ROW(X, 9) OPCODE_ROW(X, A) OPCODE_ROW(X, B)
+#define CB_OPCODES(X)        OPCODE_ROW(X, 0) OPCODE_ROW(X, 1) OPCODE_ROW(X, 2) OPCODE_ROW(X, 3) \
+                             OPCODE_ROW(X, 4) OPCODE_ROW(X, 5) OPCODE_ROW(X, 6) OPCODE_ROW(X, 7) \
+                             OPCODE_ROW(X, 8) OPCODE_ROW(X, 9) OPCODE_ROW(X, A) OPCODE_ROW(X, B) \
+                             OPCODE_ROW(X, C) OPCODE_ROW(X, D) OPCODE_ROW(X, E) OPCODE_ROW(X, F)
+
+/* FLAG TABLES */
+
+// Expand F(i) for every index of a table, so the tables below are built by the compiler, not at startup.
+#define TABLE_2(F, i)     F(i), F((i) + 1)
+#define TABLE_8(F, i)     TABLE_2(F, i), TABLE_2(F, (i) + 2), TABLE_2(F, (i) + 4), TABLE_2(F, (i) + 6)
+#define TABLE_32(F, i)    TABLE_8(F, i), TABLE_8(F, (i) + 8), TABLE_8(F, (i) + 16), TABLE_8(F, (i) + 24)
+#define TABLE_256(F, i)   TABLE_32(F, i), TABLE_32(F, (i) + 32), TABLE_32(F, (i) + 64), TABLE_32(F, (i) + 96), \
+                          TABLE_32(F, (i) + 128), TABLE_32(F, (i) + 160), TABLE_32(F, (i) + 192), TABLE_32(F, (i) + 224)
+#define TABLE_2048(F)     TABLE_256(F, 0), TABLE_256(F, 256), TABLE_256(F, 512), TABLE_256(F, 768), \
+                          TABLE_256(F, 1024), TABLE_256(F, 1280), TABLE_256(F, 1536), TABLE_256(F, 1792)
+
+// Carry out of bit 3 (or 7) from that bit of both operands and of the result, whatever the carry in was.
+// Indexed by carry_index() & 7 for H, carry_index() >> 4 for C.
+static const uint8_t half_carry_add[8] = { 0, HALF_CARRY_FLAG, HALF_CARRY_FLAG, HALF_CARRY_FLAG, 0, 0, 0, HALF_CARRY_FLAG };
+static const uint8_t half_carry_sub[8] = { 0, 0, HALF_CARRY_FLAG, 0, HALF_CARRY_FLAG, 0, HALF_CARRY_FLAG, HALF_CARRY_FLAG };
+static const uint8_t      carry_add[8] = { 0, CARRY_FLAG, CARRY_FLAG, CARRY_FLAG, 0, 0, 0, CARRY_FLAG };
+static const uint8_t      carry_sub[8] = { 0, 0, CARRY_FLAG, 0, CARRY_FLAG, 0, CARRY_FLAG, CARRY_FLAG };
+
+// Z N H of INC/DEC by result; C is kept.
+#define INC_FLAGS(r) (((r) == 0 ? ZERO_FLAG : 0) | (((r) & LOWER_4_MASK) == 0 ? HALF_CARRY_FLAG : 0))
+#define DEC_FLAGS(r) (((r) == 0 ? ZERO_FLAG : 0) | (((r) & LOWER_4_MASK) == LOWER_4_MASK ? HALF_CARRY_FLAG : 0) | SUBTRACT_FLAG)
+static const uint8_t inc_flags[256] = { TABLE_256(INC_FLAGS, 0) };
+static const uint8_t dec_flags[256] = { TABLE_256(DEC_FLAGS, 0) };
+
+// DAA by (N H C << 8) | A: corrected A in the high byte, F in the low one.
+#define DAA_N(i)     (((i) >> 10) & 1)
+#define DAA_H(i)     (((i) >> 9) & 1)
+#define DAA_C(i)     (((i) >> 8) & 1)
+#define DAA_A(i)     ((i) & LOWER_BYTE_MASK)
+#define DAA_CARRY(i) (DAA_C(i) || (!DAA_N(i) && (DAA_A(i) > 0x99)))
+#define DAA_FIX(i)   (((DAA_H(i) || (!DAA_N(i) && ((DAA_A(i) & LOWER_4_MASK) > 9))) ? 0x06 : 0) | (DAA_CARRY(i) ? 0x60 : 0))
+#define DAA_RESULT(i) ((uint8_t) (DAA_N(i) ? (DAA_A(i) - DAA_FIX(i)) : (DAA_A(i) + DAA_FIX(i))))
+#define DAA_ENTRY(i) (uint16_t) ((DAA_RESULT(i) << BYTE) | (DAA_RESULT(i) == 0 ? ZERO_FLAG : 0) | \
+                                 (DAA_N(i) ? SUBTRACT_FLAG : 0) | (DAA_CARRY(i) ? CARRY_FLAG : 0))
+static const uint16_t daa_table[2048] = { TABLE_2048(DAA_ENTRY) };
+
+/* LAZY FLAGS */
+
+static uint8_t carry_index(const LazyFlags *lazy)
+{ // Bits 3 of left, right and result in bits 0-2, bits 7 in bits 4-6.
+    return ((lazy->left & 0x88) >> 3) | ((lazy->right & 0x88) >> 2) | ((lazy->result & 0x88) >> 1);
+}
+
+static void record_flags(GbcMachine *gb, FlagSource source, uint8_t left, uint8_t right, uint8_t result, uint8_t carry)
+{ // Most F values are overwritten unread, so ALU helpers leave the operation here instead of building F.
+    LazyFlags *lazy = gb->flags;
+    lazy->source = source;
+    lazy->  left = left;
+    lazy-> right = right;
+    lazy->result = result;
+    lazy-> carry = carry;
+}
+
+static uint8_t get_carry(GbcMachine *gb)
+{ // 0/1, without settling the other flags.
+    LazyFlags *lazy = gb->flags;
+    switch (lazy->source)
+    {
+        case FLAGS_SETTLED: return (gb->R->F & CARRY_FLAG) ? 1 : 0;
+        case FLAGS_ADD:     return carry_add[carry_index(lazy) >> 4] ? 1 : 0;
+        case FLAGS_SUB:     return carry_sub[carry_index(lazy) >> 4] ? 1 : 0;
+        case FLAGS_AND:
+        case FLAGS_OR:      return 0;
+        default:            return lazy->carry;
+    }
 }
 
-static void set_flag(bool is_set, Flag flag_mask)
+void settle_flags(GbcMachine *gb)
 {
-    uint8_t value = is_set ? (R->F | flag_mask) : (R->F & ~flag_mask);
-    write_flag_reg(value);
+    LazyFlags *lazy = gb->flags;
+    if (lazy->source == FLAGS_SETTLED) return;
+
+    uint8_t index = carry_index(lazy);
+    uint8_t  zero = (lazy->result == 0) ? ZERO_FLAG : 0;
+    uint8_t  kept = lazy->carry ? CARRY_FLAG : 0;
+    uint8_t     f = 0;
+    switch (lazy->source)
+    {
+        case FLAGS_ADD:   f = zero | half_carry_add[index & 7] | carry_add[index >> 4];                 break;
+        case FLAGS_SUB:   f = zero | SUBTRACT_FLAG | half_carry_sub[index & 7] | carry_sub[index >> 4]; break;
+        case FLAGS_AND:   f = zero | HALF_CARRY_FLAG;                                                    break;
+        case FLAGS_OR:    f = zero;                                                                      break;
+        case FLAGS_INC:   f = inc_flags[lazy->result] | kept;                                            break;
+        case FLAGS_DEC:   f = dec_flags[lazy->result] | kept;                                            break;
+        default:          f = zero | kept;                                                               break;
+    }
+    gb->R->F     = f;
+    lazy->source = FLAGS_SETTLED;
+}
+
+static void write_flag_reg(GbcMachine *gb, uint8_t value)
+{
+    gb->R->F          = (value & 0xF0); // Only the upper nibble.
+    gb->flags->source = FLAGS_SETTLED;
 }
 
-static bool is_flag_set(Flag flag)
+static void set_flag(GbcMachine *gb, bool is_set, Flag flag_mask)
 {
-    return ((R->F & flag) != 0);
+    settle_flags(gb); // The other three bits are kept.
+    uint8_t value = is_set ? (gb->R->F | flag_mask) : (gb->R->F & ~flag_mask);
+    write_flag_reg(gb, value);
+}
+
+static bool is_flag_set(GbcMachine *gb, Flag flag)
+{ // Conditional jumps only ask for Z or C, neither needs F built.
+    if (flag == ZERO_FLAG)  return (gb->flags->source == FLAGS_SETTLED) ? ((gb->R->F & flag) != 0) : (gb->flags->result == 0);
+    if (flag == CARRY_FLAG) return get_carry(gb);
+    settle_flags(gb);
+    return ((gb->R->F & flag) != 0);
 }
 
-static uint8_t fetch()
+static uint8_t fetch(GbcMachine *gb)
 { // Fetch next instruction to be executed.
+    InstructionEntity *ins = gb->ins;
+    if (ins->operands_left)
+    {
+        ins->operands_left -= 1;
+        gb->R->PC          += 1;
+        return *(ins->operands++);
+    }
     uint8_t rom_byte = 0x00; // Jusssssst in case...
-    if (cpu->halt_bug_active)
+    if (gb->cpu->halt_bug_active)
     {
-        cpu->halt_bug_active = false;
-        rom_byte = read_memory(R->PC);
-        cpu_log(DEBUG, "Halt Bug Fetch %02X", rom_byte);
+        gb->cpu->halt_bug_active = false;
+        rom_byte = read_memory(gb, gb->R->PC);
+        cpu_log(gb, DEBUG, "Halt Bug Fetch %02X", rom_byte);
     }
     else
     {
-        rom_byte = read_memory(R->PC++);
+        rom_byte = read_memory(gb, gb->R->PC++);
     }
     return rom_byte;
 }
 
-static uint16_t getDR(DualRegister dr)
+static uint16_t getDR(GbcMachine *gb, DualRegister dr)
 {
     switch(dr)
     {
-        case AF_REG: return (uint16_t)((R->A << BYTE) | R->F);
-        case BC_REG: return (uint16_t)((R->B << BYTE) | R->C);
-        case DE_REG: return (uint16_t)((R->D << BYTE) | R->E);
-        case HL_REG: return (uint16_t)((R->H << BYTE) | R->L);
-        case SP_REG: return R->SP;
+        case AF_REG: settle_flags(gb); return (uint16_t)((gb->R->A << BYTE) | gb->R->F);
+        case BC_REG: return (uint16_t)((gb->R->B << BYTE) | gb->R->C);
+        case DE_REG: return (uint16_t)((gb->R->D << BYTE) | gb->R->E);
+        case HL_REG: return (uint16_t)((gb->R->H << BYTE) | gb->R->L);
+        case SP_REG: return gb->R->SP;
         default: 
             LOG_MESSAGE(ERROR, "Dual Register Not Selected");
             return 0;
     }
 }
 
-static void setDR(DualRegister dr, uint16_t source)
+static const uint8_t operand_offset[8] = // Bits 0-2 (source) or 3-5 (destination) of an opcode: B C D E H L [HL] A
+{
+    offsetof(Register, B), offsetof(Register, C), offsetof(Register, D), offsetof(Register, E),
+    offsetof(Register, H), offsetof(Register, L), 0,                     offsetof(Register, A)
+};
+
+static uint8_t *get_operand(GbcMachine *gb, uint8_t field)
+{ // NULL for [HL], which takes the bus instead.
+    if (field == 6) return NULL;
+    return ((uint8_t*) gb->R) + operand_offset[field];
+}
+
+static void setDR(GbcMachine *gb, DualRegister dr, uint16_t source)
 {
     switch(dr)
     {
         case AF_REG:
-            R->A = ((uint8_t) (source >> BYTE));
-            R->F = ((uint8_t) (source & 0xF0));            
+            gb->R->A = ((uint8_t) (source >> BYTE));
+            write_flag_reg(gb, (uint8_t) source);
             break;
         case BC_REG:
-            R->B = ((uint8_t) (source >> BYTE));
-            R->C = ((uint8_t) source & 0xFF);
+            gb->R->B = ((uint8_t) (source >> BYTE));
+            gb->R->C = ((uint8_t) source & 0xFF);
             break;
         case DE_REG:
-            R->D = ((uint8_t) (source >> BYTE));
-            R->E = ((uint8_t) source & 0xFF);
+            gb->R->D = ((uint8_t) (source >> BYTE));
+            gb->R->E = ((uint8_t) source & 0xFF);
             break;
         case HL_REG:
-            R->H = ((uint8_t) (source >> BYTE));
-            R->L = ((uint8_t) source & 0xFF);
+            gb->R->H = ((uint8_t) (source >> BYTE));
+            gb->R->L = ((uint8_t) source & 0xFF);
             break;
         case SP_REG:
-            R->SP = source;
+            gb->R->SP = source;
             break;
         default:
-            LOG_MESSAGE(ERROR, "Invalid Dual Register for setDR()");
+            LOG_MESSAGE(ERROR, "Invalid Dual Register for setDR(gb)");
             break;
     }
 }
 
-static uint8_t pop_stack()
+static uint8_t pop_stack(GbcMachine *gb)
 {
-    uint8_t result = read_memory(R->SP);
-    R->SP += 1; 
+    uint8_t result = read_memory(gb, gb->R->SP);
+    gb->R->SP += 1; 
     return result;
 }
 
-static void push_stack(uint8_t value)
+static void push_stack(GbcMachine *gb, uint8_t value)
 {
-    R->SP -= 1;
-    write_memory(R->SP, value);
+    gb->R->SP -= 1;
+    write_memory(gb, gb->R->SP, value);
 }
 
 static void schedule_ime(InterruptEnableEvent *iee)
@@ -181,39 +336,40 @@ static void schedule_ime(InterruptEnableEvent *iee)
     iee->active = true;
 }
 
-static uint8_t get_pending_interrupts()
+static uint8_t get_pending_interrupts(GbcMachine *gb)
 {
-    uint8_t ifr = *R->IFR & LOWER_5_MASK;
-    uint8_t ier = *R->IER & LOWER_5_MASK;
+    if (gb->owed_cycles) sync_machine_cycles(gb); // IE/IF are read off the bus directly.
+    uint8_t ifr = *gb->R->IFR & LOWER_5_MASK;
+    uint8_t ier = *gb->R->IER & LOWER_5_MASK;
     return ifr & ier;
 }
 
-void write_ifr(uint8_t value)
+void write_ifr(GbcMachine *gb, uint8_t value)
 {
-    (*R->IFR) = (0xE0 | (value & LOWER_5_MASK));
+    (*gb->R->IFR) = (0xE0 | (value & LOWER_5_MASK));
 }
 
-char *get_cpu_state(char *buffer, size_t size)
+char *get_cpu_state(GbcMachine *gb, char *buffer, size_t size)
 {
     snprintf(
         buffer, 
         size,
         "IME-%d | PC-$%04X | SP-$%04X | INT-($%02X & $%02X : $%02X) ||$%02X|| - %-17s ->",
-        cpu->ime, 
-        R->PC, 
-        R->SP,
-        (*R->IER),
-        (*R->IFR),
-        get_pending_interrupts(), 
-        ins->opcode, 
-        ins->label
+        gb->cpu->ime, 
+        gb->R->PC, 
+        gb->R->SP,
+        (*gb->R->IER),
+        (*gb->R->IFR),
+        get_pending_interrupts(gb), 
+        gb->ins->opcode, 
+        gb->ins->label
     );
     
     // snprintf(
     //     buffer,
     //     size,
     //     "A-$%02X%02X-F || B-$%02X%02X-C || D-$%02X%02X-E || H-$%02X%02X-L [PC=%04X] $%02X- %-17s ->",
-    //     R->A,   R->F,  R->B,  R->C,  R->D,  R->E,  R->H,  R->L,  R->PC, ins->opcode, ins->label
+    //     gb->R->A,   gb->R->F,  gb->R->B,  gb->R->C,  gb->R->D,  gb->R->E,  gb->R->H,  gb->R->L,  gb->R->PC, gb->ins->opcode, gb->ins->label
     // );
     
     return buffer;
@@ -222,5706 +378,2366 @@ char *get_cpu_state(char *buffer, size_t size)
 /* CPU OPCODE IMPLEMENTATION  */
 
 // Checked
-static bool nop(InstructionEntity *ins)        // 0x00 (- - - -) 1M
+static bool nop(GbcMachine *gb, InstructionEntity *ins)        // 0x00 (- - - -) 1M
 {
-    cpu_log(DEBUG, "...");
+    cpu_log(gb, DEBUG, "...");
     return true;
 }
-static bool halt(InstructionEntity *ins)       // 0x76 (- - - -) 1M
+static bool halt(GbcMachine *gb, InstructionEntity *ins)       // 0x76 (- - - -) 1M
 {
-    uint8_t pending = get_pending_interrupts();
+    uint8_t pending = get_pending_interrupts(gb);
 
-    if ((cpu->ime == 0) && (pending != 0))
+    if ((gb->cpu->ime == 0) && (pending != 0))
     {
-        cpu->halt_bug_active = true;
-        cpu->halted = false;
-        cpu_log(DEBUG, "Halt Bug!");
+        gb->cpu->halt_bug_active = true;
+        gb->cpu->halted = false;
+        cpu_log(gb, DEBUG, "Halt Bug!");
     }
     else
     {
-        cpu->halted = (pending == 0);
-        cpu_log(DEBUG, "Halt set based on pending interrupts.");
+        gb->cpu->halted = (pending == 0);
+        cpu_log(gb, DEBUG, "Halt set based on pending interrupts.");
     }
 
     return true;
 }
 
-static bool stop(InstructionEntity *ins) // 0x10
+static bool stop(GbcMachine *gb, InstructionEntity *ins) // 0x10
 {
-    fetch(); // STOP is a 2-byte instruction; second byte is unused
+    fetch(gb); // STOP is a 2-byte instruction; second byte is unused
 
-    uint8_t key1 = read_memory(KEY1);
-    clear_sys();
+    uint8_t key1 = read_memory(gb, KEY1);
+    clear_sys(gb);
 
-    if (is_gbc() && ((key1 & BIT_0_MASK) != cpu->speed_enabled)) // Prepare Speed Switch set
+    if (is_gbc(gb) && ((key1 & BIT_0_MASK) != gb->cpu->speed_enabled)) // Prepare Speed Switch set
     {
-        cpu->speed_enabled = !cpu->speed_enabled;
+        gb->cpu->speed_enabled = !gb->cpu->speed_enabled;
 
         // Set bit 7 = speed, clear bit 0 = handshake complete
-        uint8_t new_key1 = (cpu->speed_enabled << 7);
-        write_memory(KEY1, new_key1);
+        uint8_t new_key1 = (gb->cpu->speed_enabled << 7);
+        write_memory(gb, KEY1, new_key1);
 
-        cpu_log(DEBUG, "Speed Mode toggled to: %d", cpu->speed_enabled);
+        cpu_log(gb, DEBUG, "Speed Mode toggled to: %d", gb->cpu->speed_enabled);
         return true;
     }
 
-    cpu_log(DEBUG, "STOP executed without speed toggle.");
+    cpu_log(gb, DEBUG, "STOP executed without speed toggle.");
     return true;
 }
 
 // Checked
-static bool ld_bc_nn(InstructionEntity *ins)   // 0x01 (- - - -) 3M
+static bool ld_bc_nn(GbcMachine *gb, InstructionEntity *ins)   // 0x01 (- - - -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        R->C = fetch();
-        cpu_log(DEBUG, "Loaded $%02X into C", R->C);
+        gb->R->C = fetch(gb);
+        cpu_log(gb, DEBUG, "Loaded $%02X into C", gb->R->C);
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        R->B = fetch();
-        cpu_log(DEBUG, "Loaded $%02X into B", R->B);
+        gb->R->B = fetch(gb);
+        cpu_log(gb, DEBUG, "Loaded $%02X into B", gb->R->B);
         return true; // Instruction complete
     }
 
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_de_nn(InstructionEntity *ins)   // 0x11 (- - - -) 3M
+static bool ld_de_nn(GbcMachine *gb, InstructionEntity *ins)   // 0x11 (- - - -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        R->E = fetch();
-        cpu_log(DEBUG, "Loaded $%02X into E", R->E);
+        gb->R->E = fetch(gb);
+        cpu_log(gb, DEBUG, "Loaded $%02X into E", gb->R->E);
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        R->D = fetch();
-        cpu_log(DEBUG, "Loaded $%02X into D", R->D);
+        gb->R->D = fetch(gb);
+        cpu_log(gb, DEBUG, "Loaded $%02X into D", gb->R->D);
         return true; // Instruction complete
     }
 
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_hl_nn(InstructionEntity *ins)   // 0x21 (- - - -) 3M
+static bool ld_hl_nn(GbcMachine *gb, InstructionEntity *ins)   // 0x21 (- - - -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        R->L = fetch();
-        cpu_log(DEBUG, "Loaded $%02X into L", R->L);
+        gb->R->L = fetch(gb);
+        cpu_log(gb, DEBUG, "Loaded $%02X into L", gb->R->L);
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        R->H = fetch();
-        cpu_log(DEBUG, "Loaded $%02X into H", R->H);
+        gb->R->H = fetch(gb);
+        cpu_log(gb, DEBUG, "Loaded $%02X into H", gb->R->H);
         return true; // Instruction complete
     }
 
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_sp_nn(InstructionEntity *ins)   // 0x31 (- - - -) 3M
+static bool ld_sp_nn(GbcMachine *gb, InstructionEntity *ins)   // 0x31 (- - - -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched and Loaded byte $%02X", ins->low);
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched and Loaded byte $%02X", ins->low);
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        ins->   high = fetch();
+        ins->   high = fetch(gb);
         ins->address = form_address(ins);
-        R->SP = ins->address;
-        cpu_log(DEBUG, "Fetched and Loaded byte $%02X", ins->high);
+        gb->R->SP = ins->address;
+        cpu_log(gb, DEBUG, "Fetched and Loaded byte $%02X", ins->high);
         return true; // Instruction complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
 // Checked
-static void reg_inc_16(DualRegister dr)
+static void reg_inc_16(GbcMachine *gb, DualRegister dr)
 {
     switch(dr)
     {
         case BC_REG: 
-            R->C += 1;
-            if (R->C == 0) R->B += 1; 
+            gb->R->C += 1;
+            if (gb->R->C == 0) gb->R->B += 1; 
             break;
         case DE_REG: 
-            R->E += 1;
-            if (R->E == 0) R->D += 1; 
+            gb->R->E += 1;
+            if (gb->R->E == 0) gb->R->D += 1; 
             break;
         case HL_REG:
-            R->L += 1;
-            if (R->L == 0) R->H += 1; 
+            gb->R->L += 1;
+            if (gb->R->L == 0) gb->R->H += 1; 
             break;
         case SP_REG:
-            R->SP += 1;
+            gb->R->SP += 1;
             break;
     }
 }
-static bool reg_inc_16_handler(InstructionEntity *ins, DualRegister dr)
+static bool reg_inc_16_handler(GbcMachine *gb, InstructionEntity *ins, DualRegister dr)
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        reg_inc_16(dr);
-        cpu_log(DEBUG, "Incremented $%04X", getDR(dr));
+        reg_inc_16(gb, dr);
+        cpu_log(gb, DEBUG, "Incremented $%04X", getDR(gb, dr));
         return true; // Instruction Complete
     }
 
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool inc_bc(InstructionEntity *ins)     // 0x03 (- - - -) 2M
+static bool inc_bc(GbcMachine *gb, InstructionEntity *ins)     // 0x03 (- - - -) 2M
 {
-    return reg_inc_16_handler(ins, BC_REG);
+    return reg_inc_16_handler(gb, ins, BC_REG);
 }
-static bool inc_de(InstructionEntity *ins)     // 0x13 (- - - -) 2M
+static bool inc_de(GbcMachine *gb, InstructionEntity *ins)     // 0x13 (- - - -) 2M
 { 
-    return reg_inc_16_handler(ins, DE_REG);
+    return reg_inc_16_handler(gb, ins, DE_REG);
 }
-static bool inc_hl(InstructionEntity *ins)     // 0x23 (- - - -) 2M
+static bool inc_hl(GbcMachine *gb, InstructionEntity *ins)     // 0x23 (- - - -) 2M
 {
-    return reg_inc_16_handler(ins, HL_REG);
+    return reg_inc_16_handler(gb, ins, HL_REG);
 }
-static bool inc_sp(InstructionEntity *ins)     // 0x33 (- - - -) 2M
+static bool inc_sp(GbcMachine *gb, InstructionEntity *ins)     // 0x33 (- - - -) 2M
 { 
-    return reg_inc_16_handler(ins, SP_REG);
+    return reg_inc_16_handler(gb, ins, SP_REG);
 }
 // Checked
-static void reg_dec_16(DualRegister dr)
+static void reg_dec_16(GbcMachine *gb, DualRegister dr)
 {
     switch(dr)
     {
         case BC_REG:
-            R->C -= 1;
-            if (R->C == BYTE_UNDERFLOW) R->B -= 1; 
+            gb->R->C -= 1;
+            if (gb->R->C == BYTE_UNDERFLOW) gb->R->B -= 1; 
             break;
         case DE_REG: 
-            R->E -= 1;
-            if (R->E == BYTE_UNDERFLOW) R->D -= 1;
+            gb->R->E -= 1;
+            if (gb->R->E == BYTE_UNDERFLOW) gb->R->D -= 1;
             break;
         case HL_REG:
-            R->L -= 1;
-            if (R->L == BYTE_UNDERFLOW) R->H -= 1;
+            gb->R->L -= 1;
+            if (gb->R->L == BYTE_UNDERFLOW) gb->R->H -= 1;
             break;
         case SP_REG:
-            R->SP -= 1;
+            gb->R->SP -= 1;
             break;
     }
 }
-static bool reg_dec_16_handler(InstructionEntity *ins, DualRegister dr)
+static bool reg_dec_16_handler(GbcMachine *gb, InstructionEntity *ins, DualRegister dr)
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        reg_dec_16(dr);
-        cpu_log(DEBUG, "Decremented $%04X", getDR(dr));
+        reg_dec_16(gb, dr);
+        cpu_log(gb, DEBUG, "Decremented $%04X", getDR(gb, dr));
         return true; // Instruction Complete
     }
 
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return false;
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
+    return true;
 }
-static bool dec_bc(InstructionEntity *ins)     // 0x0B (- - - -) 2M
+static bool dec_bc(GbcMachine *gb, InstructionEntity *ins)     // 0x0B (- - - -) 2M
 {
-    reg_dec_16_handler(ins, BC_REG);
+    return reg_dec_16_handler(gb, ins, BC_REG);
 }
-static bool dec_de(InstructionEntity *ins)     // 0x1B (- - - -) 2M
+static bool dec_de(GbcMachine *gb, InstructionEntity *ins)     // 0x1B (- - - -) 2M
 {
-    reg_dec_16_handler(ins, DE_REG);
+    return reg_dec_16_handler(gb, ins, DE_REG);
 }
-static bool dec_hl(InstructionEntity *ins)     // 0x2B (- - - -) 2M
+static bool dec_hl(GbcMachine *gb, InstructionEntity *ins)     // 0x2B (- - - -) 2M
 {
-    reg_dec_16_handler(ins, HL_REG);
+    return reg_dec_16_handler(gb, ins, HL_REG);
 }
-static bool dec_sp(InstructionEntity *ins)     // 0x3B (- - - -) 2M
+static bool dec_sp(GbcMachine *gb, InstructionEntity *ins)     // 0x3B (- - - -) 2M
 { 
-    reg_dec_16_handler(ins, SP_REG);
+    return reg_dec_16_handler(gb, ins, SP_REG);
 }
 // Checked
-static bool pop_bc(InstructionEntity *ins)     // 0xC1 (- - - -) 3M
+static bool pop_bc(GbcMachine *gb, InstructionEntity *ins)     // 0xC1 (- - - -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        R->C = pop_stack();
-        cpu_log(DEBUG, "Popped $%02X into C", R->C);
+        gb->R->C = pop_stack(gb);
+        cpu_log(gb, DEBUG, "Popped $%02X into C", gb->R->C);
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        R->B = pop_stack();
-        cpu_log(DEBUG, "Popped $%02X into B", R->B);
+        gb->R->B = pop_stack(gb);
+        cpu_log(gb, DEBUG, "Popped $%02X into B", gb->R->B);
         return true; // Instruction complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool pop_de(InstructionEntity *ins)     // 0xD1 (- - - -) 3M
+static bool pop_de(GbcMachine *gb, InstructionEntity *ins)     // 0xD1 (- - - -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        R->E = pop_stack();
-        cpu_log(DEBUG, "Popped $%02X into E", R->E);
+        gb->R->E = pop_stack(gb);
+        cpu_log(gb, DEBUG, "Popped $%02X into E", gb->R->E);
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        R->D = pop_stack();
-        cpu_log(DEBUG, "Popped $%02X into D", R->D);
+        gb->R->D = pop_stack(gb);
+        cpu_log(gb, DEBUG, "Popped $%02X into D", gb->R->D);
         return true; // Instruction complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool pop_hl(InstructionEntity *ins)     // 0xE1 (- - - -) 3M
+static bool pop_hl(GbcMachine *gb, InstructionEntity *ins)     // 0xE1 (- - - -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        R->L = pop_stack();
-        cpu_log(DEBUG, "Popped $%02X into L", R->L);
+        gb->R->L = pop_stack(gb);
+        cpu_log(gb, DEBUG, "Popped $%02X into L", gb->R->L);
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        R->H = pop_stack();
-        cpu_log(DEBUG, "Popped $%02X into H", R->H);
+        gb->R->H = pop_stack(gb);
+        cpu_log(gb, DEBUG, "Popped $%02X into H", gb->R->H);
         return true; // Instruction complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool pop_af(InstructionEntity *ins)     // 0xF1 (Z N H C) 3M
+static bool pop_af(GbcMachine *gb, InstructionEntity *ins)     // 0xF1 (Z N H C) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        write_flag_reg(pop_stack());
-        cpu_log(DEBUG, "Popped $%02X into F", R->F);
+        write_flag_reg(gb, pop_stack(gb));
+        cpu_log(gb, DEBUG, "Popped $%02X into F", gb->R->F);
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        R->A = pop_stack();
-        cpu_log(DEBUG, "Popped $%02X into A", R->A);
+        gb->R->A = pop_stack(gb);
+        cpu_log(gb, DEBUG, "Popped $%02X into A", gb->R->A);
         return true; // Instruction complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
 // Checked
-static bool push_bc(InstructionEntity *ins)    // 0xC5 (- - - -) 4M
+static bool push_bc(GbcMachine *gb, InstructionEntity *ins)    // 0xC5 (- - - -) 4M
 {
     if (ins->duration <= 2) // First - Second Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        push_stack(R->B);
-        cpu_log(DEBUG, "Pushed B-$%02X onto stack", R->B);
+        push_stack(gb, gb->R->B);
+        cpu_log(gb, DEBUG, "Pushed B-$%02X onto stack", gb->R->B);
         return false;
     }
 
     if (ins->duration == 4) // Fourth Cycle
     {
-        push_stack(R->C);
-        cpu_log(DEBUG, "Pushed C-$%02X onto stack", R->C);
+        push_stack(gb, gb->R->C);
+        cpu_log(gb, DEBUG, "Pushed C-$%02X onto stack", gb->R->C);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool push_de(InstructionEntity *ins)    // 0xD5 (- - - -) 4M
+static bool push_de(GbcMachine *gb, InstructionEntity *ins)    // 0xD5 (- - - -) 4M
 {
     if (ins->duration <= 2) // First - Second Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        push_stack(R->D);
-        cpu_log(DEBUG, "Pushed D-$%02X onto stack", R->D);
+        push_stack(gb, gb->R->D);
+        cpu_log(gb, DEBUG, "Pushed D-$%02X onto stack", gb->R->D);
         return false;
     }
 
     if (ins->duration == 4) // Fourth Cycle
     {
-        push_stack(R->E);
-        cpu_log(DEBUG, "Pushed E-$%02X onto stack", R->E);
+        push_stack(gb, gb->R->E);
+        cpu_log(gb, DEBUG, "Pushed E-$%02X onto stack", gb->R->E);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool push_hl(InstructionEntity *ins)    // 0xE5 (- - - -) 4M
+static bool push_hl(GbcMachine *gb, InstructionEntity *ins)    // 0xE5 (- - - -) 4M
 {
     if (ins->duration <= 2) // First - Second Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        push_stack(R->H);
-        cpu_log(DEBUG, "Pushed H-$%02X onto stack", R->H);
+        push_stack(gb, gb->R->H);
+        cpu_log(gb, DEBUG, "Pushed H-$%02X onto stack", gb->R->H);
         return false;
     }
 
     if (ins->duration == 4) // Fourth Cycle
     {
-        push_stack(R->L);
-        cpu_log(DEBUG, "Pushed L-$%02X onto stack", R->L);
+        push_stack(gb, gb->R->L);
+        cpu_log(gb, DEBUG, "Pushed L-$%02X onto stack", gb->R->L);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool push_af(InstructionEntity *ins)    // 0xF5 (- - - -) 4M
+static bool push_af(GbcMachine *gb, InstructionEntity *ins)    // 0xF5 (- - - -) 4M
 {
     if (ins->duration <= 2) // First - Second Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        push_stack(R->A);
-        cpu_log(DEBUG, "Pushed A-$%02X onto stack", R->A);
+        push_stack(gb, gb->R->A);
+        cpu_log(gb, DEBUG, "Pushed A-$%02X onto stack", gb->R->A);
         return false;
     }
 
     if (ins->duration == 4) // Fourth Cycle
     {
-        push_stack(R->F);
-        cpu_log(DEBUG, "Pushed F-$%02X onto stack", R->F);
+        settle_flags(gb);
+        push_stack(gb, gb->R->F);
+        cpu_log(gb, DEBUG, "Pushed F-$%02X onto stack", gb->R->F);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
 // Checked
-static bool ld_hli_a(InstructionEntity *ins)   // 0x22 (- - - -) 2M
+static bool ld_hli_a(GbcMachine *gb, InstructionEntity *ins)   // 0x22 (- - - -) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        write_memory(hl, R->A);
-        setDR(HL_REG, (hl + 1));
-        cpu_log(DEBUG, "Wrote $%02X into [$%04X], Incremented", R->A, hl);
+        uint16_t hl = getDR(gb, HL_REG);
+        write_memory(gb, hl, gb->R->A);
+        setDR(gb, HL_REG, (hl + 1));
+        cpu_log(gb, DEBUG, "Wrote $%02X into [$%04X], Incremented", gb->R->A, hl);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_a_hli(InstructionEntity *ins)   // 0x2A (- - - -) 2M
+static bool ld_a_hli(GbcMachine *gb, InstructionEntity *ins)   // 0x2A (- - - -) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        R->A = read_memory(hl);
-        setDR(HL_REG, (hl + 1));
-        cpu_log(DEBUG, "Loaded $%02X from [$%04X], incremented", R->A, hl);
+        uint16_t hl = getDR(gb, HL_REG);
+        gb->R->A = read_memory(gb, hl);
+        setDR(gb, HL_REG, (hl + 1));
+        cpu_log(gb, DEBUG, "Loaded $%02X from [$%04X], incremented", gb->R->A, hl);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_hld_a(InstructionEntity *ins)   // 0x32 (- - - -) 2M
+static bool ld_hld_a(GbcMachine *gb, InstructionEntity *ins)   // 0x32 (- - - -) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        write_memory(hl, R->A);
-        setDR(HL_REG, (hl - 1));
-        cpu_log(DEBUG, "Wrote $%02X into [$%04X], decremented", R->A, hl);
+        uint16_t hl = getDR(gb, HL_REG);
+        write_memory(gb, hl, gb->R->A);
+        setDR(gb, HL_REG, (hl - 1));
+        cpu_log(gb, DEBUG, "Wrote $%02X into [$%04X], decremented", gb->R->A, hl);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_a_hld(InstructionEntity *ins)   // 0x3A (- - - -) 2M
+static bool ld_a_hld(GbcMachine *gb, InstructionEntity *ins)   // 0x3A (- - - -) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        R->A = read_memory(hl);
-        setDR(HL_REG, (hl - 1));
-        cpu_log(DEBUG, "Loaded $%02X from [$%04X], decremented", R->A, hl);
+        uint16_t hl = getDR(gb, HL_REG);
+        gb->R->A = read_memory(gb, hl);
+        setDR(gb, HL_REG, (hl - 1));
+        cpu_log(gb, DEBUG, "Loaded $%02X from [$%04X], decremented", gb->R->A, hl);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
 // Checked
-static bool ld_bc_a(InstructionEntity *ins)    // 0x02 (- - - -) 2M
+static bool ld_bc_a(GbcMachine *gb, InstructionEntity *ins)    // 0x02 (- - - -) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t bc = getDR(BC_REG);
-        write_memory(bc, R->A);
-        cpu_log(DEBUG, "Loaded $%02X into [$%04X]", R->A, bc);
+        uint16_t bc = getDR(gb, BC_REG);
+        write_memory(gb, bc, gb->R->A);
+        cpu_log(gb, DEBUG, "Loaded $%02X into [$%04X]", gb->R->A, bc);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_de_a(InstructionEntity *ins)    // 0x12 (- - - -) 2M
+static bool ld_de_a(GbcMachine *gb, InstructionEntity *ins)    // 0x12 (- - - -) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t de = getDR(DE_REG);
-        write_memory(de, R->A);
-        cpu_log(DEBUG, "Loaded $%02X into [$%04X]", R->A, de);
+        uint16_t de = getDR(gb, DE_REG);
+        write_memory(gb, de, gb->R->A);
+        cpu_log(gb, DEBUG, "Loaded $%02X into [$%04X]", gb->R->A, de);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_nn_sp(InstructionEntity *ins)   // 0x08 (- - - -) 5M
+static bool ld_nn_sp(GbcMachine *gb, InstructionEntity *ins)   // 0x08 (- - - -) 5M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched byte $%02X", ins->low);
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched byte $%02X", ins->low);
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        ins->   high = fetch();
+        ins->   high = fetch(gb);
         ins->address = form_address(ins);
-        cpu_log(DEBUG, "Fetched byte $%02X", ins->high);
+        cpu_log(gb, DEBUG, "Fetched byte $%02X", ins->high);
         return false;
     }
 
     if (ins->duration == 4) // Fourth Cycle
     {
-        uint8_t sp_low = R->SP & LOWER_BYTE_MASK;
-        write_memory(ins->address, sp_low);
-        cpu_log(DEBUG, "Wrote $%02X into [$%04X]", sp_low, ins->address);
+        uint8_t sp_low = gb->R->SP & LOWER_BYTE_MASK;
+        write_memory(gb, ins->address, sp_low);
+        cpu_log(gb, DEBUG, "Wrote $%02X into [$%04X]", sp_low, ins->address);
         return false;
     }
 
     if (ins->duration == 5) // Fifth Cycle
     {
-        uint8_t sp_high = (R->SP >> BYTE) & LOWER_BYTE_MASK;
-        write_memory(ins->address + 1, sp_high);
-        cpu_log(DEBUG, "Wrote $%02X into [$%04X]", sp_high, ins->address);
+        uint8_t sp_high = (gb->R->SP >> BYTE) & LOWER_BYTE_MASK;
+        write_memory(gb, ins->address + 1, sp_high);
+        cpu_log(gb, DEBUG, "Wrote $%02X into [$%04X]", sp_high, ins->address);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
 // Checked
-static bool ld_hl_reg(InstructionEntity *ins, uint8_t reg)
+static inline __attribute__((always_inline))
+bool ld_r_r(GbcMachine *gb, InstructionEntity *ins, uint8_t opcode) // 0x40-0x7F (- - - -) 1M, 2M with [HL]
+{ // Shared by every LD r, r' but HALT. Each caller passes its own opcode, so the operands fold to constants.
+    uint8_t *dest = get_operand(gb, (opcode >> 3) & LOWER_3_MASK);
+    uint8_t  *src = get_operand(gb, opcode & LOWER_3_MASK);
+    if (dest && src)
+    {
+        (*dest) = (*src);
+        cpu_log(gb, DEBUG, "Loaded $%02X", (*dest));
+        return true;
+    }
+
+    if (ins->duration == 1) // First Cycle
+    {
+        cpu_log(gb, DEBUG, "...");
+        return false;
+    }
+
+    uint16_t hl = getDR(gb, HL_REG); // Second Cycle
+    if (dest)
+    {
+        (*dest) = read_memory(gb, hl);
+        cpu_log(gb, DEBUG, "Loaded $%02X from [$%04X]", (*dest), hl);
+    }
+    else
+    {
+        write_memory(gb, hl, (*src));
+        cpu_log(gb, DEBUG, "Wrote $%02X into [$%04X]", (*src), hl);
+    }
+    return true; // Instruction Complete
+}
+static bool ld_a_bc(GbcMachine *gb, InstructionEntity *ins)    // 0x0A (- - - -) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        write_memory(hl, reg);
-        cpu_log(DEBUG, "Wrote $%02X into [$%04X]", reg, hl);
+        uint16_t bc = getDR(gb, BC_REG);
+        gb->R->A = read_memory(gb, bc);
+        cpu_log(gb, DEBUG, "Loaded $%02X from [$%04X]", gb->R->A, bc);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_hl_b(InstructionEntity *ins)    // 0x70 (- - - -) 2M
+static bool ld_a_de(GbcMachine *gb, InstructionEntity *ins)    // 0x1A (- - - -) 2M
 {
-    return ld_hl_reg(ins, R->B);
-}
-static bool ld_hl_c(InstructionEntity *ins)    // 0x71 (- - - -) 2M
-{
-    return ld_hl_reg(ins, R->C);
-}
-static bool ld_hl_d(InstructionEntity *ins)    // 0x72 (- - - -) 2M
-{
-    return ld_hl_reg(ins, R->D);
-}
-static bool ld_hl_e(InstructionEntity *ins)    // 0x63 (- - - -) 2M
-{
-    return ld_hl_reg(ins, R->E);
-}
-static bool ld_hl_h(InstructionEntity *ins)    // 0x64 (- - - -) 2M
-{
-    return ld_hl_reg(ins, R->H);
+    if (ins->duration == 1) // First Cycle
+    {
+        cpu_log(gb, DEBUG, "...");
+        return false;
+    }
+
+    if (ins->duration == 2) // Second Cycle
+    {
+        uint16_t de = getDR(gb, DE_REG);
+        gb->R->A = read_memory(gb, de);
+        cpu_log(gb, DEBUG, "Loaded $%02X from [$%04X]", gb->R->A, de);
+        return true; // Instruction Complete
+    }
+    
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
+    return true;
 }
-static bool ld_hl_l(InstructionEntity *ins)    // 0x65 (- - - -) 2M
+// Checked
+static bool reg_ld_n_8(GbcMachine *gb, InstructionEntity *ins, uint8_t *reg)
 {
-    return ld_hl_reg(ins, R->L);
+    if (ins->duration == 1) // First Cycle
+    {
+        cpu_log(gb, DEBUG, "...");
+        return false;
+    }
+
+    if (ins->duration == 2) // Second Cycle
+    {
+        *reg = fetch(gb);
+        cpu_log(gb, DEBUG, "Loaded $%02X", *reg);
+        return true; // Instruction Complete
+    }
+    
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
+    return true;
 }
-static bool ld_hl_a(InstructionEntity *ins)    // 0x77 (- - - -) 2M
+static bool ld_b_n(GbcMachine *gb, InstructionEntity *ins)     // 0x06 (- - - -) 2M
 {
-    return ld_hl_reg(ins, R->A);
+    return reg_ld_n_8(gb, ins, &(gb->R->B));
 }
-// Checked
-static bool ld_b_c(InstructionEntity *ins)     // 0x41 (- - - -) 1M
+static bool ld_c_n(GbcMachine *gb, InstructionEntity *ins)     // 0x0E (- - - -) 2M
 {
-    R->B = R->C;
-    cpu_log(DEBUG, "Loaded $%02X", R->B);
-    return true;
+    return reg_ld_n_8(gb, ins, &(gb->R->C));
 }
-static bool ld_b_d(InstructionEntity *ins)     // 0x42 (- - - -) 1M
+static bool ld_d_n(GbcMachine *gb, InstructionEntity *ins)     // 0x16 (- - - -) 2M
 {
-    R->B = R->D;
-    cpu_log(DEBUG, "Loaded $%02X", R->B);
-    return true;
+    return reg_ld_n_8(gb, ins, &(gb->R->D));
 }
-static bool ld_b_e(InstructionEntity *ins)     // 0x43 (- - - -) 1M
+static bool ld_e_n(GbcMachine *gb, InstructionEntity *ins)     // 0x1E (- - - -) 2M
 {
-    R->B = R->E;
-    cpu_log(DEBUG, "Loaded $%02X", R->B);
-    return true;
+    return reg_ld_n_8(gb, ins, &(gb->R->E));
 }
-static bool ld_b_h(InstructionEntity *ins)     // 0x44 (- - - -) 1M
+static bool ld_h_n(GbcMachine *gb, InstructionEntity *ins)     // 0x26 (- - - -) 2M
 {
-    R->B = R->H;
-    cpu_log(DEBUG, "Loaded $%02X", R->B);
-    return true;
+    return reg_ld_n_8(gb, ins, &(gb->R->H));
 }
-static bool ld_b_l(InstructionEntity *ins)     // 0x45 (- - - -) 1M
+static bool ld_l_n(GbcMachine *gb, InstructionEntity *ins)     // 0x2E (- - - -) 2M
 {
-    R->B = R->L;
-    cpu_log(DEBUG, "Loaded $%02X", R->B);
-    return true;
+    return reg_ld_n_8(gb, ins, &(gb->R->L));
 }
-static bool ld_b_hl(InstructionEntity *ins)    // 0x46 (- - - -) 2M
+static bool ld_hl_n(GbcMachine *gb, InstructionEntity *ins)    // 0x36 (- - - -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        R->B = read_memory(hl);
-        cpu_log(DEBUG, "Loaded $%02X from [$%04X]", R->B, hl);
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched byte $%02X", ins->low);
+        return false;
+    }
+
+    if (ins->duration == 3) // Third Cycle
+    {
+        uint16_t hl = getDR(gb, HL_REG);
+        write_memory(gb, hl, ins->low);
+        cpu_log(gb, DEBUG, "Wrote $%02X into [$%04X]", ins->low, hl);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool ld_b_a(InstructionEntity *ins)     // 0x47 (- - - -) 1M
-{
-    R->B = R->A;
-    cpu_log(DEBUG, "Loaded $%02X", R->B);
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_c_b(InstructionEntity *ins)     // 0x48 (- - - -) 1M
+static bool ld_a_n(GbcMachine *gb, InstructionEntity *ins)     // 0x3E (- - - -) 2M
 {
-    R->C = R->B;
-    cpu_log(DEBUG, "Loaded $%02X", R->C);
-    return true;
+    return reg_ld_n_8(gb, ins, &(gb->R->A));
 }
-static bool ld_c_d(InstructionEntity *ins)     // 0x4A (- - - -) 1M
+// Checked
+static uint8_t reg_inc_8(GbcMachine *gb, uint8_t r)
 {
-    R->C = R->D;
-    cpu_log(DEBUG, "Loaded $%02X", R->C);
-    return true;
+    uint8_t result = r + 1;
+    record_flags(gb, FLAGS_INC, r, 1, result, get_carry(gb));
+    return result;
 }
-static bool ld_c_e(InstructionEntity *ins)     // 0x4B (- - - -) 1M
+static bool inc_b(GbcMachine *gb, InstructionEntity *ins)      // 0x04 (Z 0 H -) 1M
 {
-    R->C = R->E;
-    cpu_log(DEBUG, "Loaded $%02X", R->C);
+    gb->R->B = reg_inc_8(gb, gb->R->B);
+    cpu_log(gb, DEBUG, "Incremented $%02X", gb->R->B);
     return true;
 }
-static bool ld_c_h(InstructionEntity *ins)     // 0x4C (- - - -) 1M
+static bool inc_d(GbcMachine *gb, InstructionEntity *ins)      // 0x14 (Z 0 H -) 1M
 {
-    R->C = R->H;
-    cpu_log(DEBUG, "Loaded $%02X", R->C);
+    gb->R->D = reg_inc_8(gb, gb->R->D);
+    cpu_log(gb, DEBUG, "Incremented $%02X", gb->R->D);
     return true;
 }
-static bool ld_c_l(InstructionEntity *ins)     // 0x4D (- - - -) 1M
+static bool inc_h(GbcMachine *gb, InstructionEntity *ins)      // 0x24 (Z 0 H -) 1M
 {
-    R->C = R->L;
-    cpu_log(DEBUG, "Loaded $%02X", R->C);
+    gb->R->H = reg_inc_8(gb, gb->R->H);
+    cpu_log(gb, DEBUG, "Incremented $%02X", gb->R->H);
     return true;
 }
-static bool ld_c_hl(InstructionEntity *ins)    // 0x4E (- - - -) 2M
+static bool inc_hl_mem(GbcMachine *gb, InstructionEntity *ins) // 0x34 (Z 0 H -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        R->C = read_memory(hl);
-        cpu_log(DEBUG, "Loaded $%02X from [$%04X]", R->C, hl);
+        uint16_t hl = getDR(gb, HL_REG);
+        ins->low = read_memory(gb, hl);
+        ins->address = hl;
+        cpu_log(gb, DEBUG, "Read $%02X from [$%04X]", ins->low, hl);
+        return false;
+    }
+
+    if (ins->duration == 3) // Third Cycle
+    {
+        uint8_t result = reg_inc_8(gb, ins->low);
+        write_memory(gb, ins->address, result);
+        cpu_log(gb, DEBUG, "Incremented [$%04X] - $%02X", ins->address, result);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_c_a(InstructionEntity *ins)     // 0x4F (- - - -) 1M
+static bool inc_c(GbcMachine *gb, InstructionEntity *ins)      // 0x0C (Z 0 H -) 1M
 {
-    R->C = R->A;
-    cpu_log(DEBUG, "Loaded $%02X", R->C);
+    gb->R->C = reg_inc_8(gb, gb->R->C);
+    cpu_log(gb, DEBUG, "Incremented $%02X", gb->R->C);
     return true;
 }
-// Checked
-static bool ld_d_b(InstructionEntity *ins)     // 0x50 (- - - -) 1M
+static bool inc_e(GbcMachine *gb, InstructionEntity *ins)      // 0x1C (Z 0 H -) 1M
+{
+    gb->R->E = reg_inc_8(gb, gb->R->E);
+    cpu_log(gb, DEBUG, "Incremented $%02X", gb->R->E);
+    return true;
+}
+static bool inc_l(GbcMachine *gb, InstructionEntity *ins)      // 0x2C (Z 0 H -) 1M
 {
-    R->D = R->B;
-    cpu_log(DEBUG, "Loaded $%02X", R->D);
+    gb->R->L = reg_inc_8(gb, gb->R->L);
+    cpu_log(gb, DEBUG, "Incremented $%02X", gb->R->L);
     return true;
 }
-static bool ld_d_c(InstructionEntity *ins)     // 0x51 (- - - -) 1M
+static bool inc_a(GbcMachine *gb, InstructionEntity *ins)      // 0x3C (Z 0 H -) 1M
 {
-    R->D = R->C;
-    cpu_log(DEBUG, "Loaded $%02X", R->D);
+    gb->R->A = reg_inc_8(gb, gb->R->A);
+    cpu_log(gb, DEBUG, "Incremented $%02X", gb->R->A);
     return true;
 }
-static bool ld_d_e(InstructionEntity *ins)     // 0x53 (- - - -) 1M
+// Checked
+static uint8_t reg_dec_8(GbcMachine *gb, uint8_t r)
+{
+    uint8_t result = r - 1;
+    record_flags(gb, FLAGS_DEC, r, 1, result, get_carry(gb));
+    return result;
+}
+static bool dec_b(GbcMachine *gb, InstructionEntity *ins)      // 0x05 (Z 1 H -) 1M
 {
-    R->D = R->E;
-    cpu_log(DEBUG, "Loaded $%02X", R->D);
+    gb->R->B = reg_dec_8(gb, gb->R->B);
+    cpu_log(gb, DEBUG, "Decremented $%02X", gb->R->B);
     return true;
 }
-static bool ld_d_h(InstructionEntity *ins)     // 0x54 (- - - -) 1M
+static bool dec_d(GbcMachine *gb, InstructionEntity *ins)      // 0x15 (Z 1 H -) 1M
 {
-    R->D = R->H;
-    cpu_log(DEBUG, "Loaded $%02X", R->D);
+    gb->R->D = reg_dec_8(gb, gb->R->D);
+    cpu_log(gb, DEBUG, "Decremented $%02X", gb->R->D);
     return true;
 }
-static bool ld_d_l(InstructionEntity *ins)     // 0x55 (- - - -) 1M
+static bool dec_h(GbcMachine *gb, InstructionEntity *ins)      // 0x25 (Z 1 H -) 1M
 {
-    R->D = R->L;
-    cpu_log(DEBUG, "Loaded $%02X", R->D);
+    gb->R->H = reg_dec_8(gb, gb->R->H);
+    cpu_log(gb, DEBUG, "Decremented $%02X", gb->R->H);
     return true;
 }
-static bool ld_d_hl(InstructionEntity *ins)    // 0x56 (- - - -) 2M
+static bool dec_hl_mem(GbcMachine *gb, InstructionEntity *ins) // 0x35 (Z 1 H -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        R->D = read_memory(hl);
-        cpu_log(DEBUG, "Loaded $%02X from [$%04X]", R->D, hl);
+        uint16_t  hl = getDR(gb, HL_REG);
+        ins->    low = read_memory(gb, hl);
+        ins->address = hl;
+        cpu_log(gb, DEBUG, "Read $%02X from [$%04X]", ins->low, hl);
+        return false;
+    }
+
+    if (ins->duration == 3) // Third Cycle
+    {
+        uint8_t result = reg_dec_8(gb, ins->low);
+        write_memory(gb, ins->address, result);
+        cpu_log(gb, DEBUG, "Decremented [$%04X] - $%02X", ins->address, result);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
+    return true;
+}
+static bool dec_c(GbcMachine *gb, InstructionEntity *ins)      // 0x0D (Z 1 H -) 1M
+{
+    gb->R->C = reg_dec_8(gb, gb->R->C);
+    cpu_log(gb, DEBUG, "Decremented $%02X", gb->R->C);
+    return true;
+}
+static bool dec_e(GbcMachine *gb, InstructionEntity *ins)      // 0x1D (Z 1 H -) 1M
+{
+    gb->R->E = reg_dec_8(gb, gb->R->E);
+    cpu_log(gb, DEBUG, "Decremented $%02X", gb->R->E);
     return true;
 }
-static bool ld_d_a(InstructionEntity *ins)     // 0x57 (- - - -) 1M
+static bool dec_l(GbcMachine *gb, InstructionEntity *ins)      // 0x2D (Z 1 H -) 1M
 {
-    R->D = R->A;
-    cpu_log(DEBUG, "Loaded $%02X", R->D);
+    gb->R->L = reg_dec_8(gb, gb->R->L);
+    cpu_log(gb, DEBUG, "Decremented $%02X", gb->R->L);
     return true;
 }
-static bool ld_e_b(InstructionEntity *ins)     // 0x58 (- - - -) 1M
+static bool dec_a(GbcMachine *gb, InstructionEntity *ins)      // 0x3D (Z 1 H -) 1M
 {
-    R->E = R->B;
-    cpu_log(DEBUG, "Loaded $%02X", R->E);
+    gb->R->A = reg_dec_8(gb, gb->R->A);
+    cpu_log(gb, DEBUG, "Decremented $%02X", gb->R->A);
     return true;
 }
-static bool ld_e_c(InstructionEntity *ins)     // 0x59 (- - - -) 1M
+// Checked
+static bool rlca(GbcMachine *gb, InstructionEntity *ins)       // 0x07 (0 0 0 C) 1M
 {
-    R->E = R->C;
-    cpu_log(DEBUG, "Loaded $%02X", R->E);
+    bool c_exists = (gb->R->A & BIT_7_MASK) != 0;
+    gb->R->A = ((gb->R->A >> 7) | (gb->R->A << 1));
+    set_flag(gb, false, ZERO_FLAG);
+    set_flag(gb, false, SUBTRACT_FLAG);
+    set_flag(gb, false, HALF_CARRY_FLAG);
+    set_flag(gb, c_exists, CARRY_FLAG);
+    cpu_log(gb, DEBUG, "A-$%02X", gb->R->A);
     return true;
 }
-static bool ld_e_d(InstructionEntity *ins)     // 0x5A (- - - -) 1M
+static bool rla(GbcMachine *gb, InstructionEntity *ins)        // 0x17 (0 0 0 C) 1M
 {
-    R->E = R->D;
-    cpu_log(DEBUG, "Loaded $%02X", R->E);
+    bool c_exists = (gb->R->A & BIT_7_MASK) != 0;
+    uint8_t carry_in = is_flag_set(gb, CARRY_FLAG) ? 1 : 0;
+    gb->R->A = ((gb->R->A << 1) | carry_in);
+    set_flag(gb, false, ZERO_FLAG);
+    set_flag(gb, false, SUBTRACT_FLAG);
+    set_flag(gb, false, HALF_CARRY_FLAG);
+    set_flag(gb, c_exists, CARRY_FLAG);
+    cpu_log(gb, DEBUG, "A-$%02X", gb->R->A);
     return true;
 }
-static bool ld_e_h(InstructionEntity *ins)     // 0x5C (- - - -) 1M
+static bool rrca(GbcMachine *gb, InstructionEntity *ins)       // 0x0F (0 0 0 C) 1M
 {
-    R->E = R->H;
-    cpu_log(DEBUG, "Loaded $%02X", R->E);
+    bool c_exists = (gb->R->A & BIT_0_MASK) != 0;
+    gb->R->A = ((gb->R->A << 7) | (gb->R->A >> 1));
+    set_flag(gb, false, ZERO_FLAG);
+    set_flag(gb, false, SUBTRACT_FLAG);
+    set_flag(gb, false, HALF_CARRY_FLAG);
+    set_flag(gb, c_exists, CARRY_FLAG);
+    cpu_log(gb, DEBUG, "A-$%02X", gb->R->A);
     return true;
 }
-static bool ld_e_l(InstructionEntity *ins)     // 0x5D (- - - -) 1M
+static bool rra(GbcMachine *gb, InstructionEntity *ins)        // 0x1F (0 0 0 C) 1M
 {
-    R->E = R->L;
-    cpu_log(DEBUG, "Loaded $%02X", R->E);
+    bool c_exists = (gb->R->A & BIT_0_MASK) != 0;
+    uint8_t carry_in = is_flag_set(gb, CARRY_FLAG) ? 1 : 0;
+    gb->R->A = ((carry_in << 7) | (gb->R->A >> 1));
+    set_flag(gb, false, ZERO_FLAG);
+    set_flag(gb, false, SUBTRACT_FLAG);
+    set_flag(gb, false, HALF_CARRY_FLAG);
+    set_flag(gb, c_exists, CARRY_FLAG);
+    cpu_log(gb, DEBUG, "A-$%02X", gb->R->A);
     return true;
 }
-static bool ld_e_hl(InstructionEntity *ins)    // 0x5E (- - - -) 2M
+// Checked
+static uint16_t reg_add_16(GbcMachine *gb, uint16_t dest, uint16_t source)
+{
+    bool hc_exists = ((dest & LOWER_12_MASK) + (source & LOWER_12_MASK)) > LOWER_12_MASK;
+    bool  c_exists = (dest + source) > MAX_INT_16;
+    set_flag(gb, false, SUBTRACT_FLAG);
+    set_flag(gb, hc_exists, HALF_CARRY_FLAG);
+    set_flag(gb, c_exists, CARRY_FLAG);
+    uint16_t result = dest + source;
+    return result;
+}
+static bool reg_add_16_handler(GbcMachine *gb, InstructionEntity *ins, DualRegister source)
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        R->E = read_memory(hl);
-        cpu_log(DEBUG, "Loaded $%02X from [$%04X]", R->E, hl);
+        uint16_t       hl = getDR(gb, HL_REG);
+        uint16_t  operand = getDR(gb, source);
+        uint16_t   result = reg_add_16(gb, hl, operand);
+        setDR(gb, HL_REG, result);
+        cpu_log(gb, DEBUG, "Result - $%04X", result);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool ld_e_a(InstructionEntity *ins)     // 0x5F (- - - -) 1M
-{
-    R->E = R->A;
-    cpu_log(DEBUG, "Loaded $%02X", R->E);
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-// Checked
-static bool ld_h_b(InstructionEntity *ins)     // 0x60 (- - - -) 1M
+static bool add_hl_bc(GbcMachine *gb, InstructionEntity *ins)  // 0x09 (- 0 H C) 2M
 {
-    R->H = R->B;
-    cpu_log(DEBUG, "Loaded $%02X", R->H);
-    return true;
+    return reg_add_16_handler(gb, ins, BC_REG);
 }
-static bool ld_h_c(InstructionEntity *ins)     // 0x61 (- - - -) 1M)
+static bool add_hl_de(GbcMachine *gb, InstructionEntity *ins)  // 0x19 (- 0 H C) 2M
 {
-    R->H = R->C;
-    cpu_log(DEBUG, "Loaded $%02X", R->H);
-    return true;
+    return reg_add_16_handler(gb, ins, DE_REG);
 }
-static bool ld_h_d(InstructionEntity *ins)     // 0x62 (- - - -) 1M
+static bool add_hl_hl(GbcMachine *gb, InstructionEntity *ins)  // 0x29 (- 0 H C) 2M
 {
-    R->H = R->D;
-    cpu_log(DEBUG, "Loaded $%02X", R->H);
-    return true;
+    return reg_add_16_handler(gb, ins, HL_REG);
 }
-static bool ld_h_e(InstructionEntity *ins)     // 0x63 (- - - -) 1M
+static bool add_hl_sp(GbcMachine *gb, InstructionEntity *ins)  // 0x39 (- 0 H C) 2M
 {
-    R->H = R->E;
-    cpu_log(DEBUG, "Loaded $%02X", R->H);
-    return true;
+    return reg_add_16_handler(gb, ins, SP_REG);
 }
-static bool ld_h_l(InstructionEntity *ins)     // 0x65 (- - - -) 1M
-{
-    R->H = R->L;
-    cpu_log(DEBUG, "Loaded $%02X", R->H);
-    return true;
+// Checked
+static uint8_t reg_add_8(GbcMachine *gb, uint8_t dest, uint8_t source)
+{ // 0x8X
+    uint8_t result = dest + source;
+    record_flags(gb, FLAGS_ADD, dest, source, result, 0);
+    return result;
 }
-static bool ld_h_hl(InstructionEntity *ins)    // 0x66 (- - - -) 2M
+static bool add_a_n(GbcMachine *gb, InstructionEntity *ins)    // 0xC6 (Z 0 H C) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        R->H = read_memory(hl);
-        cpu_log(DEBUG, "Loaded $%02X from [$%04X]", R->H, hl);
+        gb->R->A = reg_add_8(gb, gb->R->A, ins->low); 
+        cpu_log(gb, DEBUG, "Result - $%02X", gb->R->A);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool ld_h_a(InstructionEntity *ins)     // 0x67 (- - - -) 1M
-{
-    R->H = R->A;
-    cpu_log(DEBUG, "Loaded $%02X", R->H);
-    return true;
-}
-static bool ld_l_b(InstructionEntity *ins)     // 0x68 (- - - -) 1M
-{
-    R->L = R->B;
-    cpu_log(DEBUG, "Loaded $%02X", R->L);
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_l_c(InstructionEntity *ins)     // 0x69 (- - - -) 1M
-{
-    R->L = R->C;
-    cpu_log(DEBUG, "Loaded $%02X", R->L);
-    return true;
-}
-static bool ld_l_d(InstructionEntity *ins)     // 0x6A (- - - -) 1M
-{
-    R->L = R->D;
-    cpu_log(DEBUG, "Loaded $%02X", R->L);
-    return true;
+// Checked
+static uint8_t reg_adc_8(GbcMachine *gb, uint8_t dest, uint8_t source)
+{ // 0x8X
+    uint8_t  carry = get_carry(gb);
+    uint8_t result = dest + source + carry;
+    record_flags(gb, FLAGS_ADD, dest, source, result, carry);
+    return result;
 }
-static bool ld_l_e(InstructionEntity *ins)     // 0x6B (- - - -) 1M
+static bool adc_a_n(GbcMachine *gb, InstructionEntity *ins)    // 0xCE (Z 0 H C) 2M
 {
-    R->L = R->E;
-    cpu_log(DEBUG, "Loaded $%02X", R->L);
+    if (ins->duration == 1) // First Cycle
+    {
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
+        return false;
+    }
+
+    if (ins->duration == 2) // Second Cycle
+    {
+        gb->R->A = reg_adc_8(gb, gb->R->A, ins->low);
+        cpu_log(gb, DEBUG, "Result - $%02X", gb->R->A);
+        return true; // Instruction Complete
+    }
+    
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_l_h(InstructionEntity *ins)     // 0x6C (- - - -) 1M
+// Checked
+static uint8_t reg_sub_8(GbcMachine *gb, uint8_t dest, uint8_t source)
 {
-    R->L = R->H;
-    cpu_log(DEBUG, "Loaded $%02X", R->L);
-    return true;
+    uint8_t result = (dest - source);
+    record_flags(gb, FLAGS_SUB, dest, source, result, 0);
+    return result;
 }
-static bool ld_l_hl(InstructionEntity *ins)    // 0x6E (- - - -) 2M
+static bool sub_a_n(GbcMachine *gb, InstructionEntity *ins)    // 0xD6 (Z 1 H C) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        R->L = read_memory(hl);
-        cpu_log(DEBUG, "Loaded $%02X from [$%04X]", R->L, hl);
+        gb->R->A = reg_sub_8(gb, gb->R->A, ins->low);
+        cpu_log(gb, DEBUG, "Result - $%02X", gb->R->A);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool ld_l_a(InstructionEntity *ins)     // 0x6F (- - - -) 1M
-{ 
-    R->L = R->A;
-    cpu_log(DEBUG, "Loaded $%02X", R->L);
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
 // Checked
-static bool ld_a_b(InstructionEntity *ins)     // 0x78 (- - - -) 1M
+static uint8_t reg_sbc_8(GbcMachine *gb, uint8_t dest, uint8_t source)
 {
-    R->A = R->B;
-    cpu_log(DEBUG, "Loaded $%02X", R->A);
-    return true;
-}
-static bool ld_a_c(InstructionEntity *ins)     // 0x79 (- - - -) 1M
-{ 
-    R->A = R->C;
-    cpu_log(DEBUG, "Loaded $%02X", R->A);
-    return true;
+    uint8_t  carry = get_carry(gb);
+    uint8_t result = (dest - source - carry);
+    record_flags(gb, FLAGS_SUB, dest, source, result, carry);
+    return result;
 }
-static bool ld_a_d(InstructionEntity *ins)     // 0x7A (- - - -) 1M
+static bool sbc_a_n(GbcMachine *gb, InstructionEntity *ins)    // 0xDE (Z 1 H C) 2M
 {
-    R->A = R->D;
-    cpu_log(DEBUG, "Loaded $%02X", R->A);
+    if (ins->duration == 1) // First Cycle
+    {
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
+        return false;
+    }
+
+    if (ins->duration == 2) // Second Cycle
+    {
+        gb->R->A = reg_sbc_8(gb, gb->R->A, ins->low);
+        cpu_log(gb, DEBUG, "Result - $%02X", gb->R->A);
+        return true; // Instruction Complete
+    }
+    
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_a_e(InstructionEntity *ins)     // 0x7B (- - - -) 1M
+// Checked
+static uint8_t reg_and_8(GbcMachine *gb, uint8_t dest, uint8_t source)
 {
-    R->A = R->E;
-    cpu_log(DEBUG, "Loaded $%02X", R->A);
-    return true;
+    uint8_t result = dest & source;
+    record_flags(gb, FLAGS_AND, dest, source, result, 0);
+    return result;
 }
-static bool ld_a_h(InstructionEntity *ins)     // 0x7C (- - - -) 1M
+static bool and_a_n(GbcMachine *gb, InstructionEntity *ins)    // 0xE6 (Z 0 1 0) 2M
 {
-    R->A = R->H;
-    cpu_log(DEBUG, "Loaded $%02X", R->A);
+    if (ins->duration == 1) // First Cycle
+    {
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
+        return false;
+    }
+
+    if (ins->duration == 2) // Second Cycle
+    {
+        gb->R->A = reg_and_8(gb, gb->R->A, ins->low);
+        cpu_log(gb, DEBUG, "Result - $%02X", gb->R->A);
+        return true; // Instruction Complete
+    }
+    
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_a_l(InstructionEntity *ins)     // 0x7D (- - - -) 1M
+// Checked
+static uint8_t reg_xor_8(GbcMachine *gb, uint8_t dest, uint8_t source)
 {
-    R->A = R->L;
-    cpu_log(DEBUG, "Loaded $%02X", R->A);
-    return true;
+    uint8_t result = dest ^ source;
+    record_flags(gb, FLAGS_OR, dest, source, result, 0);
+    return result;
 }
-static bool ld_a_hl(InstructionEntity *ins)    // 0x7E (- - - -) 2M
+static bool xor_a_n(GbcMachine *gb, InstructionEntity *ins)    // 0xEE (Z 0 0 0) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        R->A = read_memory(hl);
-        cpu_log(DEBUG, "Loaded $%02X from [$%04X]", R->A, hl);
+        gb->R->A = reg_xor_8(gb, gb->R->A, ins->low);
+        cpu_log(gb, DEBUG, "Result - $%02X", gb->R->A);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_a_bc(InstructionEntity *ins)    // 0x0A (- - - -) 2M
+// Checked
+static uint8_t reg_or_8(GbcMachine *gb, uint8_t dest, uint8_t source)
+{
+    uint8_t result = dest | source;
+    record_flags(gb, FLAGS_OR, dest, source, result, 0);
+    return result;
+}
+static bool or_a_n(GbcMachine *gb, InstructionEntity *ins)     // 0xF6 (Z 0 0 0) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t bc = getDR(BC_REG);
-        R->A = read_memory(bc);
-        cpu_log(DEBUG, "Loaded $%02X from [$%04X]", R->A, bc);
+        gb->R->A = reg_or_8(gb, gb->R->A, ins->low);
+        cpu_log(gb, DEBUG, "Result - $%02X", gb->R->A);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_a_de(InstructionEntity *ins)    // 0x1A (- - - -) 2M
+// Checked
+static void reg_cp_8(GbcMachine *gb, uint8_t dest, uint8_t source)
+{
+    record_flags(gb, FLAGS_SUB, dest, source, (uint8_t) (dest - source), 0);
+}
+static bool cp_a_n(GbcMachine *gb, InstructionEntity *ins)     // 0xFE (Z 1 H C) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t de = getDR(DE_REG);
-        R->A = read_memory(de);
-        cpu_log(DEBUG, "Loaded $%02X from [$%04X]", R->A, de);
+        reg_cp_8(gb, gb->R->A, ins->low);
+        cpu_log(gb, DEBUG, "%02X < %02X %d", gb->R->A, ins->low, is_flag_set(gb, CARRY_FLAG));
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
+static inline __attribute__((always_inline))
+bool alu_a_r(GbcMachine *gb, InstructionEntity *ins, uint8_t opcode) // 0x80-0xBF (Z N H C) 1M, 2M with [HL]
+{ // Bits 3-5 pick the operation, bits 0-2 the operand; both are constant in each generated handler.
+    uint8_t *src = get_operand(gb, opcode & LOWER_3_MASK);
+    if (src == NULL)
+    {
+        if (ins->duration == 1) // First Cycle
+        {
+            cpu_log(gb, DEBUG, "...");
+            return false;
+        }
+        ins->low = read_memory(gb, getDR(gb, HL_REG)); // Second Cycle
+        src      = &ins->low;
+    }
+    uint8_t value = (*src);
+    switch ((opcode >> 3) & LOWER_3_MASK)
+    {
+        case 0: gb->R->A = reg_add_8(gb, gb->R->A, value); break;
+        case 1: gb->R->A = reg_adc_8(gb, gb->R->A, value); break;
+        case 2: gb->R->A = reg_sub_8(gb, gb->R->A, value); break;
+        case 3: gb->R->A = reg_sbc_8(gb, gb->R->A, value); break;
+        case 4: gb->R->A = reg_and_8(gb, gb->R->A, value); break;
+        case 5: gb->R->A = reg_xor_8(gb, gb->R->A, value); break;
+        case 6: gb->R->A =  reg_or_8(gb, gb->R->A, value); break;
+        case 7: reg_cp_8(gb, gb->R->A, value);             break;
+    }
+    cpu_log(gb, DEBUG, "Result - $%02X", gb->R->A);
+    return true; // Instruction Complete
+}
 // Checked
-static bool reg_ld_n_8(InstructionEntity *ins, uint8_t *reg)
+static bool return_handler(GbcMachine *gb, InstructionEntity *ins, bool returning)
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        *reg = fetch();
-        cpu_log(DEBUG, "Loaded $%02X", *reg);
+        if (!returning)
+        {
+            cpu_log(gb, DEBUG, "Condition not met, stopping early.");
+        }
+        return !returning;
+    }
+
+    if (ins->duration == 3) // Third Cycle
+    {
+        ins->low = pop_stack(gb);
+        cpu_log(gb, DEBUG, "Popped $%02X", ins->low);
+        return false;
+    }
+
+    if (ins->duration == 4) // Fourth Cycle
+    {
+        ins->high = pop_stack(gb);
+        cpu_log(gb, DEBUG, "Popped $%02X", ins->high);
+        return false;
+    }
+
+    if (ins->duration == 5) // Fifth Cycle
+    {
+        ins->address = form_address(ins);
+        gb->R->PC = ins->address;
+        cpu_log(gb, DEBUG, "Address - [$%04X]", gb->R->PC);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_b_n(InstructionEntity *ins)     // 0x06 (- - - -) 2M
+static bool ret_nz(GbcMachine *gb, InstructionEntity *ins)     // 0xC0 (- - - -) 5M
 {
-    return reg_ld_n_8(ins, &(R->B));
+    return return_handler(gb, ins, !is_flag_set(gb, ZERO_FLAG));
 }
-static bool ld_c_n(InstructionEntity *ins)     // 0x0E (- - - -) 2M
+static bool ret_nc(GbcMachine *gb, InstructionEntity *ins)     // 0xD0 (- - - -) 5M
 {
-    return reg_ld_n_8(ins, &(R->C));
+    return return_handler(gb, ins, !is_flag_set(gb, CARRY_FLAG));
 }
-static bool ld_d_n(InstructionEntity *ins)     // 0x16 (- - - -) 2M
+static bool ret_c(GbcMachine *gb, InstructionEntity *ins)      // 0xD8 (- - - -) 5M
 {
-    return reg_ld_n_8(ins, &(R->D));
+    return return_handler(gb, ins, is_flag_set(gb, CARRY_FLAG));
 }
-static bool ld_e_n(InstructionEntity *ins)     // 0x1E (- - - -) 2M
+static bool ret_z(GbcMachine *gb, InstructionEntity *ins)      // 0xC8 (- - - -) 5M
 {
-    return reg_ld_n_8(ins, &(R->E));
+    return return_handler(gb, ins, is_flag_set(gb, ZERO_FLAG));
 }
-static bool ld_h_n(InstructionEntity *ins)     // 0x26 (- - - -) 2M
+static bool ret(GbcMachine *gb, InstructionEntity *ins)        // 0xC9 (- - - -) 4M
 {
-    return reg_ld_n_8(ins, &(R->H));
+    if (ins->duration == 2) ins->duration += 1; // Skips check cycle
+    return return_handler(gb, ins, true);
 }
-static bool ld_l_n(InstructionEntity *ins)     // 0x2E (- - - -) 2M
+static bool reti(GbcMachine *gb, InstructionEntity *ins)       // 0xD9 (- - - -) 4M
 {
-    return reg_ld_n_8(ins, &(R->L));
+    if (ins->duration == 2) ins->duration += 1; // Skips check cycle
+    bool result = return_handler(gb, ins, true);
+    if (ins->duration == 4) schedule_ime(gb->iee);
+    return result;
 }
-static bool ld_hl_n(InstructionEntity *ins)    // 0x36 (- - - -) 3M
+// Checked
+static bool rst_handler(GbcMachine *gb, InstructionEntity *ins, uint16_t rst_vector)
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched byte $%02X", ins->low);
+        ins->high = (gb->R->PC >> BYTE) & LOWER_BYTE_MASK;
+        push_stack(gb, ins->high);
+        cpu_log(gb, DEBUG, "Pushed $%02X", ins->high);
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        write_memory(hl, ins->low);
-        cpu_log(DEBUG, "Wrote $%02X into [$%04X]", ins->low, hl);
+        ins->low = gb->R->PC & LOWER_BYTE_MASK;
+        push_stack(gb, ins->low);
+        cpu_log(gb, DEBUG, "Pushed $%02X", ins->low);
+        return false;
+    }
+
+    if (ins->duration == 4) // Fourth Cycle
+    {
+        gb->R->PC = rst_vector;
+        cpu_log(gb, DEBUG, "Subroutine $%02X", rst_vector);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool ld_a_n(InstructionEntity *ins)     // 0x3E (- - - -) 2M
+static bool rst_00(GbcMachine *gb, InstructionEntity *ins)     // 0xC7 (- - - -) 4M
 {
-    return reg_ld_n_8(ins, &(R->A));
+    return rst_handler(gb, ins, 0x00);
 }
-// Checked
-static uint8_t reg_inc_8(uint8_t r)
+static bool rst_10(GbcMachine *gb, InstructionEntity *ins)     // 0xD7 (- - - -) 4M
 {
-    uint8_t result = r + 1;
-    bool   is_zero = (result == 0);
-    bool hc_exists = ((r & LOWER_4_MASK) == LOWER_4_MASK);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(hc_exists, HALF_CARRY_FLAG);
-    return result;
+    return rst_handler(gb, ins, 0x10);
 }
-static bool inc_b(InstructionEntity *ins)      // 0x04 (Z 0 H -) 1M
+static bool rst_20(GbcMachine *gb, InstructionEntity *ins)     // 0xE7 (- - - -) 4M
 {
-    R->B = reg_inc_8(R->B);
-    cpu_log(DEBUG, "Incremented $%02X", R->B);
-    return true;
+    return rst_handler(gb, ins, 0x20);
 }
-static bool inc_d(InstructionEntity *ins)      // 0x14 (Z 0 H -) 1M
+static bool rst_30(GbcMachine *gb, InstructionEntity *ins)     // 0xF7 (- - - -) 4M
 {
-    R->D = reg_inc_8(R->D);
-    cpu_log(DEBUG, "Incremented $%02X", R->D);
-    return true;
+    return rst_handler(gb, ins, 0x30);
 }
-static bool inc_h(InstructionEntity *ins)      // 0x24 (Z 0 H -) 1M
+static bool rst_08(GbcMachine *gb, InstructionEntity *ins)     // 0xCF (- - - -) 4M
 {
-    R->H = reg_inc_8(R->H);
-    cpu_log(DEBUG, "Incremented $%02X", R->H);
-    return true;
+    return rst_handler(gb, ins, 0x08);
+}
+static bool rst_18(GbcMachine *gb, InstructionEntity *ins)     // 0xDF (- - - -) 4M
+{ 
+    return rst_handler(gb, ins, 0x18);
+}
+static bool rst_28(GbcMachine *gb, InstructionEntity *ins)     // 0xEF (- - - -) 4M
+{
+    return rst_handler(gb, ins, 0x28);
 }
-static bool inc_hl_mem(InstructionEntity *ins) // 0x34 (Z 0 H -) 3M
+static bool rst_38(GbcMachine *gb, InstructionEntity *ins)     // 0xFF (- - - -) 4M
+{
+    return rst_handler(gb, ins, 0x38);
+}
+// Checked
+static bool call_handler(GbcMachine *gb, InstructionEntity *ins, bool calling)
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        ins->low = read_memory(hl);
-        ins->address = hl;
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, hl);
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        uint8_t result = reg_inc_8(ins->low);
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Incremented [$%04X] - $%02X", ins->address, result);
+        ins->high = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->high);
+        if (!calling)
+        {
+            cpu_log(gb, DEBUG, "Condition not met, stopping early.");
+            return true;
+        }
+        return false;
+    }
+
+    if (ins->duration == 4) // Fourth Cycle
+    {
+        uint8_t pc_high = (gb->R->PC >> BYTE) & LOWER_BYTE_MASK;
+        push_stack(gb, pc_high);
+        cpu_log(gb, DEBUG, "Pushed $%02X", pc_high);
+        return false;
+    }
+
+    if (ins->duration == 5) // Fifth Cycle
+    {
+        uint8_t pc_low = gb->R->PC & LOWER_BYTE_MASK;
+        push_stack(gb, pc_low);
+        cpu_log(gb, DEBUG, "Pushed $%02X", pc_low);
+        return false;
+    }
+
+    if (ins->duration == 6) // Sixth Cycle
+    {   
+        ins->address = form_address(ins);
+        gb->R->PC = ins->address;
+        cpu_log(gb, DEBUG, "Address [$%04X]", ins->address);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool inc_c(InstructionEntity *ins)      // 0x0C (Z 0 H -) 1M
+static bool call_nz_nn(GbcMachine *gb, InstructionEntity *ins) // 0xC4 (- - - -) 6M
 {
-    R->C = reg_inc_8(R->C);
-    cpu_log(DEBUG, "Incremented $%02X", R->C);
-    return true;
-}
-static bool inc_e(InstructionEntity *ins)      // 0x1C (Z 0 H -) 1M
-{
-    R->E = reg_inc_8(R->E);
-    cpu_log(DEBUG, "Incremented $%02X", R->E);
-    return true;
-}
-static bool inc_l(InstructionEntity *ins)      // 0x2C (Z 0 H -) 1M
-{
-    R->L = reg_inc_8(R->L);
-    cpu_log(DEBUG, "Incremented $%02X", R->L);
-    return true;
-}
-static bool inc_a(InstructionEntity *ins)      // 0x3C (Z 0 H -) 1M
-{
-    R->A = reg_inc_8(R->A);
-    cpu_log(DEBUG, "Incremented $%02X", R->A);
-    return true;
+    return call_handler(gb, ins, !is_flag_set(gb, ZERO_FLAG));
 }
-// Checked
-static uint8_t reg_dec_8(uint8_t r)
+static bool call_nc_nn(GbcMachine *gb, InstructionEntity *ins) // 0xD4 (- - - -) 6M
 {
-    uint8_t result = r - 1;
-    bool   is_zero = (result == 0);
-    bool hc_exists = ((r & LOWER_4_MASK) == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(true, SUBTRACT_FLAG);
-    set_flag(hc_exists, HALF_CARRY_FLAG);
-    return result;
+    return call_handler(gb, ins, !is_flag_set(gb, CARRY_FLAG));
 }
-static bool dec_b(InstructionEntity *ins)      // 0x05 (Z 1 H -) 1M
+static bool call_z_nn(GbcMachine *gb, InstructionEntity *ins)  // 0xCC (- - - -) 6M
 {
-    R->B = reg_dec_8(R->B);
-    cpu_log(DEBUG, "Decremented $%02X", R->B);
-    return true;
+    return call_handler(gb, ins, is_flag_set(gb, ZERO_FLAG));
 }
-static bool dec_d(InstructionEntity *ins)      // 0x15 (Z 1 H -) 1M
+static bool call_c_nn(GbcMachine *gb, InstructionEntity *ins)  // 0xDC (- - - -) 6M
 {
-    R->D = reg_dec_8(R->D);
-    cpu_log(DEBUG, "Decremented $%02X", R->D);
-    return true;
+    return call_handler(gb, ins, is_flag_set(gb, CARRY_FLAG));
 }
-static bool dec_h(InstructionEntity *ins)      // 0x25 (Z 1 H -) 1M
+static bool call_nn(GbcMachine *gb, InstructionEntity *ins)    // 0xCD (- - - -) 6M
 {
-    R->H = reg_dec_8(R->H);
-    cpu_log(DEBUG, "Decremented $%02X", R->H);
-    return true;
+    return call_handler(gb, ins, true);
 }
-static bool dec_hl_mem(InstructionEntity *ins) // 0x35 (Z 1 H -) 3M
+// Checked
+static bool jump_relative_handler(GbcMachine *gb, InstructionEntity *ins, bool jumping)
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t  hl = getDR(HL_REG);
-        ins->    low = read_memory(hl);
-        ins->address = hl;
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, hl);
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
+        if (!jumping)
+        {
+            cpu_log(gb, DEBUG, "Condition not met, stopping early.");
+            return true;
+        }
         return false;
     }
 
     if (ins->duration == 3) // Third Cycle
     {
-        uint8_t result = reg_dec_8(ins->low);
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Decremented [$%04X] - $%02X", ins->address, result);
-        return true; // Instruction Complete
+        int8_t offset = (int8_t) ins->low;
+        uint16_t old_pc = gb->R->PC;
+        gb->R->PC += offset;
+        cpu_log(gb, DEBUG, "$%04X to $%04X (offset %d)", old_pc, gb->R->PC, offset); 
+        return true;      
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool dec_c(InstructionEntity *ins)      // 0x0D (Z 1 H -) 1M
-{
-    R->C = reg_dec_8(R->C);
-    cpu_log(DEBUG, "Decremented $%02X", R->C);
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool dec_e(InstructionEntity *ins)      // 0x1D (Z 1 H -) 1M
+static bool jr_n(GbcMachine *gb, InstructionEntity *ins)       // 0x18 (- - - -) 3M
 {
-    R->E = reg_dec_8(R->E);
-    cpu_log(DEBUG, "Decremented $%02X", R->E);
-    return true;
-}
-static bool dec_l(InstructionEntity *ins)      // 0x2D (Z 1 H -) 1M
-{
-    R->L = reg_dec_8(R->L);
-    cpu_log(DEBUG, "Decremented $%02X", R->L);
-    return true;
+    return jump_relative_handler(gb, ins, true);
 }
-static bool dec_a(InstructionEntity *ins)      // 0x3D (Z 1 H -) 1M
+static bool jr_z_n(GbcMachine *gb, InstructionEntity *ins)     // 0x28 (- - - -) 3M
 {
-    R->A = reg_dec_8(R->A);
-    cpu_log(DEBUG, "Decremented $%02X", R->A);
-    return true;
-}
-// Checked
-static bool rlca(InstructionEntity *ins)       // 0x07 (0 0 0 C) 1M
-{
-    bool c_exists = (R->A & BIT_7_MASK) != 0;
-    R->A = ((R->A >> 7) | (R->A << 1));
-    set_flag(false, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    cpu_log(DEBUG, "A-$%02X", R->A);
-    return true;
+    return jump_relative_handler(gb, ins, is_flag_set(gb, ZERO_FLAG));
 }
-static bool rla(InstructionEntity *ins)        // 0x17 (0 0 0 C) 1M
+static bool jr_c_n(GbcMachine *gb, InstructionEntity *ins)     // 0x38 (- - - -) 3M
 {
-    bool c_exists = (R->A & BIT_7_MASK) != 0;
-    uint8_t carry_in = is_flag_set(CARRY_FLAG) ? 1 : 0;
-    R->A = ((R->A << 1) | carry_in);
-    set_flag(false, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    cpu_log(DEBUG, "A-$%02X", R->A);
-    return true;
+    return jump_relative_handler(gb, ins, is_flag_set(gb, CARRY_FLAG));
 }
-static bool rrca(InstructionEntity *ins)       // 0x0F (0 0 0 C) 1M
+static bool jr_nz_n(GbcMachine *gb, InstructionEntity *ins)    // 0x20 (- - - -) 3M
 {
-    bool c_exists = (R->A & BIT_0_MASK) != 0;
-    R->A = ((R->A << 7) | (R->A >> 1));
-    set_flag(false, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    cpu_log(DEBUG, "A-$%02X", R->A);
-    return true;
+    return jump_relative_handler(gb, ins, !is_flag_set(gb, ZERO_FLAG));
 }
-static bool rra(InstructionEntity *ins)        // 0x1F (0 0 0 C) 1M
+static bool jr_nc_n(GbcMachine *gb, InstructionEntity *ins)    // 0x30 (- - - -) 3M
 {
-    bool c_exists = (R->A & BIT_0_MASK) != 0;
-    uint8_t carry_in = is_flag_set(CARRY_FLAG) ? 1 : 0;
-    R->A = ((carry_in << 7) | (R->A >> 1));
-    set_flag(false, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    cpu_log(DEBUG, "A-$%02X", R->A);
-    return true;
+    return jump_relative_handler(gb, ins, !is_flag_set(gb, CARRY_FLAG));
 }
 // Checked
-static uint16_t reg_add_16(uint16_t dest, uint16_t source)
-{
-    bool hc_exists = ((dest & LOWER_12_MASK) + (source & LOWER_12_MASK)) > LOWER_12_MASK;
-    bool  c_exists = (dest + source) > MAX_INT_16;
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(hc_exists, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    uint16_t result = dest + source;
-    return result;
-}
-static bool reg_add_16_handler(InstructionEntity *ins, DualRegister source)
+static bool jump_position_handler(GbcMachine *gb, InstructionEntity *ins, bool jumping)
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t       hl = getDR(HL_REG);
-        uint16_t  operand = getDR(source);
-        uint16_t   result = reg_add_16(hl, operand);
-        setDR(HL_REG, result);
-        cpu_log(DEBUG, "Result - $%04X", result);
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
+        return false;
+    }
+
+    if (ins->duration == 3) // Third Cycle
+    {
+        ins->high = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->high);
+        if (!jumping)
+        {
+            cpu_log(gb, DEBUG, "Condition not met, stopping early.");
+            return true;
+        }
+        return false;
+    }
+
+    if (ins->duration == 4) // Fourth Cycle
+    {
+        ins->address = form_address(ins);
+        uint16_t old_pc = gb->R->PC;
+        gb->R->PC = ins->address;
+        cpu_log(gb, DEBUG, "$%04X to $%04X", old_pc, gb->R->PC);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool add_hl_bc(InstructionEntity *ins)  // 0x09 (- 0 H C) 2M
+static bool jp_nz_nn(GbcMachine *gb, InstructionEntity *ins)   // 0xC2 (- - - -) 4M
 {
-    return reg_add_16_handler(ins, BC_REG);
+    return jump_position_handler(gb, ins, !is_flag_set(gb, ZERO_FLAG));
 }
-static bool add_hl_de(InstructionEntity *ins)  // 0x19 (- 0 H C) 2M
+static bool jp_nc_nn(GbcMachine *gb, InstructionEntity *ins)   // 0xD2 (- - - -) 4M
 {
-    return reg_add_16_handler(ins, DE_REG);
+    return jump_position_handler(gb, ins, !is_flag_set(gb, CARRY_FLAG));
 }
-static bool add_hl_hl(InstructionEntity *ins)  // 0x29 (- 0 H C) 2M
+static bool jp_nn(GbcMachine *gb, InstructionEntity *ins)      // 0xC3 (- - - -) 4M
 {
-    return reg_add_16_handler(ins, HL_REG);
+    return jump_position_handler(gb, ins, true);
 }
-static bool add_hl_sp(InstructionEntity *ins)  // 0x39 (- 0 H C) 2M
+static bool jp_z_nn(GbcMachine *gb, InstructionEntity *ins)    // 0xCA (- - - -) 4M
 {
-    return reg_add_16_handler(ins, SP_REG);
+    return jump_position_handler(gb, ins, is_flag_set(gb, ZERO_FLAG));
 }
-// Checked
-static uint8_t reg_add_8(uint8_t dest, uint8_t source)
-{ // 0x8X
-    uint8_t  result = dest + source;
-    bool    is_zero = (result == 0);
-    bool  hc_exists = ((dest & LOWER_4_MASK) + (source & LOWER_4_MASK)) > LOWER_4_MASK;
-    bool   c_exists = (((uint16_t) dest) + ((uint16_t) source)) > LOWER_BYTE_MASK;
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(hc_exists, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    return (uint8_t) result;
-}
-static bool add_a_b(InstructionEntity *ins)    // 0x80 (Z 0 H C) 1M
-{
-    R->A = reg_add_8(R->A, R->B);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
+static bool jp_c_nn(GbcMachine *gb, InstructionEntity *ins)    // 0xDA (- - - -) 4M
+{
+    return jump_position_handler(gb, ins, is_flag_set(gb, CARRY_FLAG));
 }
-static bool add_a_c(InstructionEntity *ins)    // 0x81 (Z 0 H C) 1M
+static bool jp_hl(GbcMachine *gb, InstructionEntity *ins)      // 0xE9 (- - - -) 1M
 {
-    R->A = reg_add_8(R->A, R->C);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    gb->R->PC = getDR(gb, HL_REG);
+    cpu_log(gb, DEBUG, "Address $%04X", gb->R->PC);
     return true;
 }
-static bool add_a_d(InstructionEntity *ins)    // 0x82 (Z 0 H C) 1M
+// Checked
+static bool daa(GbcMachine *gb, InstructionEntity *ins)        // 0x27 (Z - 0 C) 1M
 {
-    R->A = reg_add_8(R->A, R->D);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    settle_flags(gb);
+    uint16_t nhc = (gb->R->F & (SUBTRACT_FLAG | HALF_CARRY_FLAG | CARRY_FLAG)) << NIBBLE;
+    uint16_t entry = daa_table[nhc | gb->R->A];
+    gb->R->A = (uint8_t) (entry >> BYTE);
+    write_flag_reg(gb, (uint8_t) entry);
+    cpu_log(gb, DEBUG, "A=$%02X", gb->R->A);
     return true;
 }
-static bool add_a_e(InstructionEntity *ins)    // 0x83 (Z 0 H C) 1M
+
+static bool cpl(GbcMachine *gb, InstructionEntity *ins)        // 0x2F (- 1 1 -) 1M
 {
-    R->A = reg_add_8(R->A, R->E);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    gb->R->A = ~gb->R->A;
+    set_flag(gb, true, SUBTRACT_FLAG);
+    set_flag(gb, true, HALF_CARRY_FLAG);
+    cpu_log(gb, DEBUG, "$%02X", gb->R->A);
     return true;
 }
-static bool add_a_h(InstructionEntity *ins)    // 0x84 (Z 0 H C) 1M
+static bool scf(GbcMachine *gb, InstructionEntity *ins)        // 0x07 (- 0 0 1) 1M
 {
-    R->A = reg_add_8(R->A, R->H);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    set_flag(gb, false, SUBTRACT_FLAG);
+    set_flag(gb, false, HALF_CARRY_FLAG);
+    set_flag(gb, true, CARRY_FLAG);
+    cpu_log(gb, DEBUG, "...");
     return true;
 }
-static bool add_a_l(InstructionEntity *ins)    // 0x85 (Z 0 H C) 1M
+static bool ccf(GbcMachine *gb, InstructionEntity *ins)        // 0x3F (- 0 0 C) 1M
 {
-    R->A = reg_add_8(R->A, R->L);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    set_flag(gb, false, SUBTRACT_FLAG);
+    set_flag(gb, false, HALF_CARRY_FLAG);
+    set_flag(gb, !is_flag_set(gb, CARRY_FLAG), CARRY_FLAG);
+    cpu_log(gb, DEBUG, "...");
     return true;
 }
-static bool add_a_hl(InstructionEntity *ins)   // 0x86 (Z 0 H C) 2M
+// Checked
+static bool ldh_n_a(GbcMachine *gb, InstructionEntity *ins)    // 0xE0 (- - - -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        ins->low = read_memory(hl);
-        uint8_t prev_a = R->A;
-        R->A = reg_add_8(R->A, ins->low);
-        cpu_log(DEBUG, "$%02X ADD $%02X = %02X", prev_a, ins->low, R->A);
+        ins->    low = fetch(gb);
+        ins->address = (0xFF00 | ins->low);
+        cpu_log(gb, DEBUG, "Fetched $%02X, Address [$%04X]", ins->low, ins->address);
+        return false;
+    }
+
+    if (ins->duration == 3) // Third Cycle
+    {
+        write_memory(gb, ins->address, gb->R->A);
+        cpu_log(gb, DEBUG, "Wrote $%02X into [$%04X]", gb->R->A, ins->address);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool add_a_a(InstructionEntity *ins)    // 0x87 (Z 0 H C) 1M
-{
-    R->A = reg_add_8(R->A, R->A);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool add_a_n(InstructionEntity *ins)    // 0xC6 (Z 0 H C) 2M
+static bool ldh_a_n(GbcMachine *gb, InstructionEntity *ins)    // 0xF0 (- - - -) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        R->A = reg_add_8(R->A, ins->low); 
-        cpu_log(DEBUG, "Result - $%02X", R->A);
+        ins->    low = fetch(gb);
+        ins->address = (0xFF00 | ins->low);
+        cpu_log(gb, DEBUG, "Fetched $%02X, Address [$%04X]", ins->low, ins->address);
+        return false;
+    }
+
+    if (ins->duration == 3) // Third Cycle
+    {
+        gb->R->A = read_memory(gb, ins->address);
+        cpu_log(gb, DEBUG, "Read $%02X from [$%04X]", gb->R->A, ins->address);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-// Checked
-static uint8_t reg_adc_8(uint8_t dest, uint8_t source)
-{ // 0x8X
-    uint8_t  carry = is_flag_set(CARRY_FLAG) ? 1 : 0;
-    uint8_t result = dest + source + carry;
-    bool is_zero   = (result  == 0);
-    bool hc_exists = ((dest & LOWER_4_MASK) + (source & LOWER_4_MASK) + carry) > LOWER_4_MASK;
-    bool c_exists  = (((uint16_t) dest) + ((uint16_t) source) + ((uint16_t) carry)) > LOWER_BYTE_MASK;
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(hc_exists, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    return (uint8_t) result;
-}
-static bool adc_a_b(InstructionEntity *ins)    // 0x88 (Z 0 H C) 1M
-{
-    R->A = reg_adc_8(R->A, R->B);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool adc_a_c(InstructionEntity *ins)    // 0x89 (Z 0 H C) 1M
-{
-    R->A = reg_adc_8(R->A, R->C);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool adc_a_d(InstructionEntity *ins)    // 0x8A (Z 0 H C) 1M
-{
-    R->A = reg_adc_8(R->A, R->D);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool adc_a_e(InstructionEntity *ins)    // 0x8B (Z 0 H C) 1M
-{
-    R->A = reg_adc_8(R->A, R->E);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool adc_a_h(InstructionEntity *ins)    // 0x8C (Z 0 H C) 1M
+static bool ldh_c_a(GbcMachine *gb, InstructionEntity *ins)    // 0xE1 (- - - -) 2M
 {
-    R->A = reg_adc_8(R->A, R->H);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool adc_a_l(InstructionEntity *ins)    // 0x8D (Z 0 H C) 1M
-{
-    R->A = reg_adc_8(R->A, R->L);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool adc_a_hl(InstructionEntity *ins)   // 0x8E (Z 0 H C) 2M
-{ 
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        ins->address = (0xFF00 | gb->R->C);
+        cpu_log(gb, DEBUG, "Address [$%04X]", ins->address);
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        ins->low = read_memory(hl);
-        uint8_t prev_a = R->A;
-        R->A = reg_adc_8(R->A, ins->low);
-        cpu_log(DEBUG, "$%02X ADC $%02X = %02X", prev_a, ins->low, R->A);
+        write_memory(gb, ins->address, gb->R->A);
+        cpu_log(gb, DEBUG, "Wrote $%02X into [$%04X]", gb->R->A, ins->address);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool adc_a_a(InstructionEntity *ins)    // 0x8F (Z 0 H C) 1M
-{
-    R->A = reg_adc_8(R->A, R->A);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool adc_a_n(InstructionEntity *ins)    // 0xCE (Z 0 H C) 2M
+static bool ldh_a_c(GbcMachine *gb, InstructionEntity *ins)    // 0xF1 (- - - -) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
+        ins->address = (0xFF00 | gb->R->C);
+        cpu_log(gb, DEBUG, "Address [$%04X]", ins->address);
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        R->A = reg_adc_8(R->A, ins->low);
-        cpu_log(DEBUG, "Result - $%02X", R->A);
+        gb->R->A = read_memory(gb, ins->address);
+        cpu_log(gb, DEBUG, "Read $%02X from [$%04X]", gb->R->A, ins->address);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
 // Checked
-static uint8_t reg_sub_8(uint8_t dest, uint8_t source)
-{
-    uint8_t result = (dest - source);
-    bool    is_zero = (result == 0);
-    bool  hc_exists = ((dest & LOWER_4_MASK) < (source & LOWER_4_MASK));
-    bool   c_exists = dest < source;
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(true, SUBTRACT_FLAG);
-    set_flag(hc_exists, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    return (uint8_t) result;
-}
-static bool sub_a_b(InstructionEntity *ins)    // 0x90 (Z 1 H C) 1M
-{
-    R->A = reg_sub_8(R->A, R->B);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sub_a_c(InstructionEntity *ins)    // 0x91 (Z 1 H C) 1M
-{
-    R->A = reg_sub_8(R->A, R->C);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sub_a_d(InstructionEntity *ins)    // 0x92 (Z 1 H C) 1M
-{
-    R->A = reg_sub_8(R->A, R->D);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sub_a_e(InstructionEntity *ins)    // 0x93 (Z 1 H C) 1M
-{
-    R->A = reg_sub_8(R->A, R->E);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sub_a_h(InstructionEntity *ins)    // 0x94 (Z 1 H C) 1M
-{
-    R->A = reg_sub_8(R->A, R->H);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sub_a_l(InstructionEntity *ins)    // 0x95 (Z 1 H C) 1M
-{
-    R->A = reg_sub_8(R->A, R->L);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sub_a_hl(InstructionEntity *ins)   // 0x96 (Z 1 H C) 2M
+static bool ld_nn_a(GbcMachine *gb, InstructionEntity *ins)    // 0xEA (- - - -) 4M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        ins->low = read_memory(hl);
-        uint8_t prev_a = R->A;
-        R->A = reg_sub_8(R->A, ins->low);
-        cpu_log(DEBUG, "$%02X SUB $%02X = %02X", prev_a, ins->low, R->A);
-        return true; // Instruction Complete
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
+        return false;
     }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool sub_a_a(InstructionEntity *ins)    // 0x97 (Z 1 H C) 1M
-{
-    R->A = reg_sub_8(R->A, R->A);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sub_a_n(InstructionEntity *ins)    // 0xD6 (Z 1 H C) 2M
-{
-    if (ins->duration == 1) // First Cycle
+
+    if (ins->duration == 3) // Third Cycle
     {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
+        ins->high = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->high);
         return false;
     }
 
-    if (ins->duration == 2) // Second Cycle
+    if (ins->duration == 4) // Fourth Cycle
     {
-        R->A = reg_sub_8(R->A, ins->low);
-        cpu_log(DEBUG, "Result - $%02X", R->A);
+        ins->address = form_address(ins);
+        write_memory(gb, ins->address, gb->R->A);
+        cpu_log(gb, DEBUG, "Wrote $%02X into [$%04X]", gb->R->A, ins->address);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-// Checked
-static uint8_t reg_sbc_8(uint8_t dest, uint8_t source)
-{
-    uint8_t   carry = is_flag_set(CARRY_FLAG) ? 1 : 0;
-    uint8_t  result = (dest - source - carry);
-    bool    is_zero = (result == 0);
-    bool  hc_exists = ((dest & LOWER_4_MASK) < ((source & LOWER_4_MASK) + carry));
-    bool   c_exists = dest < (source + carry);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(true, SUBTRACT_FLAG);
-    set_flag(hc_exists, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    return (uint8_t) result;
-}
-static bool sbc_a_b(InstructionEntity *ins)    // 0x98 (Z 1 H C) 1M
-{
-    R->A = reg_sbc_8(R->A, R->B);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sbc_a_c(InstructionEntity *ins)    // 0x99 (Z 1 H C) 1M
-{
-    R->A = reg_sbc_8(R->A, R->C);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sbc_a_d(InstructionEntity *ins)    // 0x9A (Z 1 H C) 1M
-{
-    R->A = reg_sbc_8(R->A, R->D);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sbc_a_e(InstructionEntity *ins)    // 0x9B (Z 1 H C) 1M
-{
-    R->A = reg_sbc_8(R->A, R->E);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sbc_a_h(InstructionEntity *ins)    // 0x9C (Z 1 H C) 1M
-{
-    R->A = reg_sbc_8(R->A, R->H);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sbc_a_l(InstructionEntity *ins)    // 0x9D (Z 1 H C) 1M
-{
-    R->A = reg_sbc_8(R->A, R->L);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool sbc_a_hl(InstructionEntity *ins)   // 0x9E (Z 1 H C) 2M
+static bool ld_a_nn(GbcMachine *gb, InstructionEntity *ins)    // 0xFA (- - - -) 4M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        ins->low = read_memory(hl);
-        uint8_t prev_a = R->A;
-        R->A = reg_sbc_8(R->A, ins->low);
-        cpu_log(DEBUG, "$%02X SBC $%02X = %02X", prev_a, ins->low, R->A);
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
+        return false;
+    }
+
+    if (ins->duration == 3) // Third Cycle
+    {
+        ins->high = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->high);
+        return false;
+    }
+
+    if (ins->duration == 4) // Fourth Cycle
+    {
+        ins->address = form_address(ins);
+        gb->R->A = read_memory(gb, ins->address);
+        cpu_log(gb, DEBUG, "Read $%02X from [$%04X]", gb->R->A, ins->address);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool sbc_a_a(InstructionEntity *ins)    // 0x9F (Z 1 H C) 1M
-{
-    R->A = reg_sbc_8(R->A, R->A);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool sbc_a_n(InstructionEntity *ins)    // 0xDE (Z 1 H C) 2M
+static bool ld_hl_sp_n(GbcMachine *gb, InstructionEntity *ins) // 0xF8 (0 0 H C) 3M
 {
     if (ins->duration == 1) // First Cycle
     {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        R->A = reg_sbc_8(R->A, ins->low);
-        cpu_log(DEBUG, "Result - $%02X", R->A);
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
+        return false;
+    }
+
+    if (ins->duration == 3) // Third Cycle
+    {
+        int8_t        n = (int8_t) ins->low;
+        uint16_t result = gb->R->SP + n;
+        bool hc_exists = ((gb->R->SP & LOWER_4_MASK) + (((uint8_t) n) & LOWER_4_MASK)) > LOWER_4_MASK;
+        bool c_exists  = ((gb->R->SP & 0xFF) + (((uint8_t) n) & 0xFF)) > 0xFF;
+        set_flag(gb, false, ZERO_FLAG);
+        set_flag(gb, false, SUBTRACT_FLAG);
+        set_flag(gb, hc_exists, HALF_CARRY_FLAG);
+        set_flag(gb, c_exists, CARRY_FLAG);
+        setDR(gb, HL_REG, result);
+        cpu_log(gb, DEBUG, "HL - $%04X", getDR(gb, HL_REG));
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-// Checked
-static uint8_t reg_and_8(uint8_t dest, uint8_t source)
-{
-    uint8_t result = dest & source;
-    bool   is_zero = (result == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(true, HALF_CARRY_FLAG);
-    set_flag(false, CARRY_FLAG);
-    return result;
-}
-static bool and_a_b(InstructionEntity *ins)    // 0xA0 (Z 0 1 0) 1M
-{
-    R->A = reg_and_8(R->A, R->B);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool and_a_c(InstructionEntity *ins)    // 0xA1 (Z 0 1 0) 1M
-{
-    R->A = reg_and_8(R->A, R->C);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool and_a_d(InstructionEntity *ins)    // 0xA2 (Z 0 1 0) 1M
-{
-    R->A = reg_and_8(R->A, R->D);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool and_a_e(InstructionEntity *ins)    // 0xA3 (Z 0 1 0) 1M
-{
-    R->A = reg_and_8(R->A, R->E);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true; 
-}
-static bool and_a_h(InstructionEntity *ins)    // 0xA4 (Z 0 1 0) 1M
-{
-    R->A = reg_and_8(R->A, R->H);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true; 
-}
-static bool and_a_l(InstructionEntity *ins)    // 0xA5 (Z 0 1 0) 1M
-{
-    R->A = reg_and_8(R->A, R->L);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool and_a_hl(InstructionEntity *ins)   // 0xA6 (Z 0 1 0) 2M
+static bool ld_sp_hl(GbcMachine *gb, InstructionEntity *ins)   // 0xF9 (- - - -) 2M
 {
     if (ins->duration == 1) // First Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
     if (ins->duration == 2) // Second Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        ins->low = read_memory(hl);
-        uint8_t prev_a = R->A;
-        R->A = reg_and_8(R->A, ins->low);
-        cpu_log(DEBUG, "$%02X AND $%02X = %02X", prev_a, ins->low, R->A);
+        gb->R->SP = getDR(gb, HL_REG);
+        cpu_log(gb, DEBUG, "$%02X", gb->R->SP);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool and_a_a(InstructionEntity *ins)    // 0xA7 (Z 0 1 0) 1M
-{
-    R->A = reg_and_8(R->A, R->A);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true; 
-}
-static bool and_a_n(InstructionEntity *ins)    // 0xE6 (Z 0 1 0) 2M
+static bool add_sp_n(GbcMachine *gb, InstructionEntity *ins)   // 0xE8 (0 0 H C) 4M
 {
-    if (ins->duration == 1) // First Cycle
+    if (ins->duration <= 2) // First Cycle
     {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
-    if (ins->duration == 2) // Second Cycle
+    if (ins->duration == 3) // Second Cycle
+    {
+        ins->low = fetch(gb);
+        cpu_log(gb, DEBUG, "Fetched $%02X", ins->low);
+        return false;
+    }
+
+    if (ins->duration == 4) // Third Cycle
     {
-        R->A = reg_and_8(R->A, ins->low);
-        cpu_log(DEBUG, "Result - $%02X", R->A);
+        int8_t        n = (int8_t) ins->low;
+        uint16_t    sum = (gb->R->SP + n);
+        bool  hc_exists = ((gb->R->SP & LOWER_4_MASK) + (((uint8_t) n) & LOWER_4_MASK)) > LOWER_4_MASK;
+        bool  c_exists  = ((gb->R->SP & 0xFF) + (((uint8_t) n) & 0xFF)) > 0xFF;
+        set_flag(gb, false, ZERO_FLAG);
+        set_flag(gb, false, SUBTRACT_FLAG);
+        set_flag(gb, hc_exists, HALF_CARRY_FLAG);
+        set_flag(gb, c_exists, CARRY_FLAG);
+        gb->R->SP = sum;
+        cpu_log(gb, DEBUG, "$%04X", gb->R->SP);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
 // Checked
-static uint8_t reg_xor_8(uint8_t dest, uint8_t source)
-{
-    uint8_t result = dest ^ source;
-    bool   is_zero = (result == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(false, CARRY_FLAG);
-    return result;
-}
-static bool xor_a_b(InstructionEntity *ins)    // 0xA8 (Z 0 0 0) 1M
-{
-    R->A = reg_xor_8(R->A, R->B);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool xor_a_c(InstructionEntity *ins)    // 0xA9 (Z 0 0 0) 1M
+static bool di(GbcMachine *gb, InstructionEntity *ins)         // 0xF3 (- - - -) 1M
 {
-    R->A = reg_xor_8(R->A, R->C);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    gb->cpu->   ime = false;
+    gb->iee->active = false;
+    cpu_log(gb, DEBUG, "Disable Interrupt Request");
     return true;
 }
-static bool xor_a_d(InstructionEntity *ins)    // 0xAA (Z 0 0 0) 1M
+static bool ei(GbcMachine *gb, InstructionEntity *ins)         // 0xFB (- - - -) 1M
 {
-    R->A = reg_xor_8(R->A, R->D);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    schedule_ime(gb->iee);
+    cpu_log(gb, DEBUG, "IEE scheduled, expect after next instruction.");
     return true;
 }
-static bool xor_a_e(InstructionEntity *ins)    // 0xAB (Z 0 0 0) 1M
+static bool cb_prefix(GbcMachine *gb, InstructionEntity *ins)  // 0xCB (- - - -) 1m
 {
-    R->A = reg_xor_8(R->A, R->E);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    cpu_log(gb, DEBUG, "...");
+    gb->cb_prefixed = true;
     return true;
 }
-static bool xor_a_h(InstructionEntity *ins)    // 0xAC (Z 0 0 0) 1M
+// Checked
+static bool vram_print(GbcMachine *gb, InstructionEntity *ins) // 0xXX (- - - -) 1M
 {
-    R->A = reg_xor_8(R->A, R->H);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
+    uint8_t lower  = fetch(gb);
+    uint8_t upper  = fetch(gb);
+    uint16_t start = (upper << BYTE) | lower;
+    lower          = fetch(gb);
+    upper          = fetch(gb);
+    uint16_t end   = (upper << BYTE) | lower;
+    bool bank      = (bool) fetch(gb);
+    print_vram(gb, start, end, bank);
+    return 1; 
 }
-static bool xor_a_l(InstructionEntity *ins)    // 0xAD (Z 0 0 0) 1M
+static bool int_exec(GbcMachine *gb, InstructionEntity *ins)   // 0xXX (- - - -) 5M
 {
-    R->A = reg_xor_8(R->A, R->L);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool xor_a_hl(InstructionEntity *ins)   // 0xAE (Z 0 0 0) 2M
-{
-    if (ins->duration == 1) // First Cycle
+    if (ins->duration <= 2) // First & Second Cycle
     {
-        cpu_log(DEBUG, "...");
+        cpu_log(gb, DEBUG, "...");
         return false;
     }
 
-    if (ins->duration == 2) // Second Cycle
-    {
-        uint16_t hl = getDR(HL_REG);
-        ins->low = read_memory(hl);
-        uint8_t prev_a = R->A;
-        R->A = reg_xor_8(R->A, ins->low);
-        cpu_log(DEBUG, "$%02X XOR $%02X = %02X", prev_a, ins->low, R->A);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool xor_a_a(InstructionEntity *ins)    // 0xAF (Z 0 0 0) 1M
-{
-    R->A = reg_xor_8(R->A, R->A);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool xor_a_n(InstructionEntity *ins)    // 0xEE (Z 0 0 0) 2M
-{
-    if (ins->duration == 1) // First Cycle
+    if (ins->duration == 3) // Third Cycle
     {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
+        uint8_t pc_high = (gb->R->PC >> BYTE) & LOWER_BYTE_MASK;
+        push_stack(gb, pc_high);
+        cpu_log(gb, DEBUG, "Pushed $%02X", pc_high);
         return false;
     }
 
-    if (ins->duration == 2) // Second Cycle
-    {
-        R->A = reg_xor_8(R->A, ins->low);
-        cpu_log(DEBUG, "Result - $%02X", R->A);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-// Checked
-static uint8_t reg_or_8(uint8_t dest, uint8_t source)
-{
-    uint8_t result = dest | source;
-    bool   is_zero = (result == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(false, CARRY_FLAG);
-    return result;
-}
-static bool or_a_b(InstructionEntity *ins)     // 0xB0 (Z 0 0 0) 1M
-{
-    R->A = reg_or_8(R->A, R->B);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool or_a_c(InstructionEntity *ins)     // 0xB1 (Z 0 0 0) 1M
-{
-    R->A = reg_or_8(R->A, R->C);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool or_a_d(InstructionEntity *ins)     // 0xB2 (Z 0 0 0) 1M
-{
-    R->A = reg_or_8(R->A, R->D);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool or_a_e(InstructionEntity *ins)     // 0xB3 (Z 0 0 0) 1M
-{
-    R->A = reg_or_8(R->A, R->E);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool or_a_h(InstructionEntity *ins)     // 0xB4 (Z 0 0 0) 1M
-{
-    R->A = reg_or_8(R->A, R->H);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool or_a_l(InstructionEntity *ins)     // 0xB5 (Z 0 0 0) 1M
-{
-    R->A = reg_or_8(R->A, R->L);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
-    return true;
-}
-static bool or_a_hl(InstructionEntity *ins)    // 0xB6 (Z 0 0 0) 2M
-{
-    if (ins->duration == 1) // First Cycle
+    if (ins->duration == 4) // Fourth Cycle
     {
-        cpu_log(DEBUG, "...");
+        uint8_t pc_low = gb->R->PC & LOWER_BYTE_MASK;
+        push_stack(gb, pc_low);
+        cpu_log(gb, DEBUG, "Pushed $%02X", pc_low);
         return false;
     }
 
-    if (ins->duration == 2) // Second Cycle
+    if (ins->duration == 5) // Fifth Cycle
     {
-        uint16_t hl = getDR(HL_REG);
-        ins->low = read_memory(hl);
-        uint8_t prev_a = R->A;
-        R->A = reg_or_8(R->A, ins->low);
-        cpu_log(DEBUG, "$%02X OR $%02X = %02X", prev_a, ins->low, R->A);
+        gb->R->PC = ins->address;    // Set when serviciing
+        if (gb->owed_cycles) sync_machine_cycles(gb);
+        write_ifr(gb, *gb->R->IFR & ~ins->low);  // Confirm servicing
+        cpu_log(gb, DEBUG, "Address $%04X", ins->address);
         return true; // Instruction Complete
     }
     
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool or_a_a(InstructionEntity *ins)     // 0xB7 (Z 0 0 0) 1M
-{
-    R->A = reg_or_8(R->A, R->A);
-    cpu_log(DEBUG, "Result - $%02X", R->A);
+    cpu_log(gb, ERROR, "Invalid operation, moving on.");
     return true;
 }
-static bool or_a_n(InstructionEntity *ins)     // 0xF6 (Z 0 0 0) 2M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
-        return false;
-    }
+// One handler per opcode of the decoded families, each a call to the shared body with its opcode as a constant.
+#define DECODED_HANDLER(family, op) \
+    static bool family##_##op(GbcMachine *gb, InstructionEntity *ins) { return family(gb, ins, op); }
+#define LD_R_R_HANDLER(op)  DECODED_HANDLER(ld_r_r, op)
+#define ALU_A_R_HANDLER(op) DECODED_HANDLER(alu_a_r, op)
+#define CB_OP_HANDLER(op)   DECODED_HANDLER(cb_op, op)
+#define CB_OP_ENTRY(op)     [op] = cb_op_##op,
+
+LD_R_R_OPCODES(LD_R_R_HANDLER)
+ALU_A_R_OPCODES(ALU_A_R_HANDLER)
 
-    if (ins->duration == 2) // Second Cycle
-    {
-        R->A = reg_or_8(R->A, ins->low);
-        cpu_log(DEBUG, "Result - $%02X", R->A);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
 // Checked
-static void reg_cp_8(uint8_t dest, uint8_t source)
-{
-    bool    is_zero = (dest == source); 
-    bool  hc_exists = ((dest & LOWER_4_MASK) < (source & LOWER_4_MASK));
-    bool   c_exists = dest < source;
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(true, SUBTRACT_FLAG);
-    set_flag(hc_exists, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-}
-static bool cp_a_b(InstructionEntity *ins)     // 0xB8 (Z 1 H C) 1M
-{
-    reg_cp_8(R->A, R->B);
-    cpu_log(DEBUG, "%02X < %02X = %d", R->A, R->B, is_flag_set(CARRY_FLAG));
-    return true;
-}
-static bool cp_a_c(InstructionEntity *ins)     // 0xB9 (Z 1 H C) 1M
-{
-    reg_cp_8(R->A, R->C);
-    cpu_log(DEBUG, "%02X < %02X = %d", R->A, R->C, is_flag_set(CARRY_FLAG));
-    return true;
-}
-static bool cp_a_d(InstructionEntity *ins)     // 0xBA (Z 1 H C) 1M
-{
-    reg_cp_8(R->A, R->D);
-    cpu_log(DEBUG, "%02X < %02X = %d", R->A, R->D, is_flag_set(CARRY_FLAG));
-    return true;
-}
-static bool cp_a_e(InstructionEntity *ins)     // 0xBB (Z 1 H C) 1M
-{
-    reg_cp_8(R->A, R->E);
-    cpu_log(DEBUG, "%02X < %02X = %d", R->A, R->E, is_flag_set(CARRY_FLAG));
-    return true;
-}
-static bool cp_a_h(InstructionEntity *ins)     // 0xBC (Z 1 H C) 1M
+const OpcodeHandler opcode_table[256] = 
 {
-    reg_cp_8(R->A, R->H);
-    cpu_log(DEBUG, "%02X < %02X = %d", R->A, R->H, is_flag_set(CARRY_FLAG));
-    return true;
-}
-static bool cp_a_l(InstructionEntity *ins)     // 0xBD (Z 1 H C) 1M
+    /*              ROW 1               */
+    [0x00] = nop,   
+    [0x01] = ld_bc_nn,
+    [0x02] = ld_bc_a,
+    [0x03] = inc_bc,
+    [0x04] = inc_b,
+    [0x05] = dec_b,
+    [0x06] = ld_b_n,
+    [0x07] = rlca,
+    [0x08] = ld_nn_sp,
+    [0x09] = add_hl_bc,
+    [0x0A] = ld_a_bc,
+    [0x0B] = dec_bc,
+    [0x0C] = inc_c,
+    [0x0D] = dec_c,
+    [0x0E] = ld_c_n,
+    [0x0F] = rrca,
+    /*              ROW 2               */
+    [0x10] = stop,
+    [0x11] = ld_de_nn,
+    [0x12] = ld_de_a,
+    [0x13] = inc_de,
+    [0x14] = inc_d,
+    [0x15] = dec_d,
+    [0x16] = ld_d_n,
+    [0x17] = rla,
+    [0x18] = jr_n,
+    [0x19] = add_hl_de,
+    [0x1A] = ld_a_de,
+    [0x1B] = dec_de,
+    [0x1C] = inc_e,
+    [0x1D] = dec_e,
+    [0x1E] = ld_e_n,
+    [0x1F] = rra,
+    /*              ROW 3               */
+    [0x20] = jr_nz_n,
+    [0x21] = ld_hl_nn,
+    [0x22] = ld_hli_a,
+    [0x23] = inc_hl,
+    [0x24] = inc_h,
+    [0x25] = dec_h,
+    [0x26] = ld_h_n,
+    [0x27] = daa,
+    [0x28] = jr_z_n,
+    [0x29] = add_hl_hl,
+    [0x2A] = ld_a_hli,
+    [0x2B] = dec_hl,
+    [0x2C] = inc_l,
+    [0x2D] = dec_l,
+    [0x2E] = ld_l_n,
+    [0x2F] = cpl,
+    /*              ROW 4               */
+    [0x30] = jr_nc_n,
+    [0x31] = ld_sp_nn,
+    [0x32] = ld_hld_a,
+    [0x33] = inc_sp,
+    [0x34] = inc_hl_mem,
+    [0x35] = dec_hl_mem,
+    [0x36] = ld_hl_n,
+    [0x37] = scf,
+    [0x38] = jr_c_n,
+    [0x39] = add_hl_sp,
+    [0x3A] = ld_a_hld,
+    [0x3B] = dec_sp,
+    [0x3C] = inc_a,
+    [0x3D] = dec_a,
+    [0x3E] = ld_a_n,
+    [0x3F] = ccf,
+    /*              ROW 5               */
+    [0x40] = nop,   
+    [0x41] = ld_r_r_0x41,
+    [0x42] = ld_r_r_0x42,
+    [0x43] = ld_r_r_0x43,
+    [0x44] = ld_r_r_0x44,
+    [0x45] = ld_r_r_0x45,
+    [0x46] = ld_r_r_0x46,
+    [0x47] = ld_r_r_0x47,
+    [0x48] = ld_r_r_0x48,
+    [0x49] = nop,
+    [0x4A] = ld_r_r_0x4A,
+    [0x4B] = ld_r_r_0x4B,
+    [0x4C] = ld_r_r_0x4C,
+    [0x4D] = ld_r_r_0x4D,
+    [0x4E] = ld_r_r_0x4E,
+    [0x4F] = ld_r_r_0x4F,
+    /*              ROW 6               */
+    [0x50] = ld_r_r_0x50,
+    [0x51] = ld_r_r_0x51,
+    [0x52] = nop,
+    [0x53] = ld_r_r_0x53,
+    [0x54] = ld_r_r_0x54,
+    [0x55] = ld_r_r_0x55,
+    [0x56] = ld_r_r_0x56,
+    [0x57] = ld_r_r_0x57,
+    [0x58] = ld_r_r_0x58,
+    [0x59] = ld_r_r_0x59,
+    [0x5A] = ld_r_r_0x5A,
+    [0x5B] = nop,
+    [0x5C] = ld_r_r_0x5C,
+    [0x5D] = ld_r_r_0x5D,
+    [0x5E] = ld_r_r_0x5E,
+    [0x5F] = ld_r_r_0x5F,
+    /*              ROW 7               */
+    [0x60] = ld_r_r_0x60,
+    [0x61] = ld_r_r_0x61,
+    [0x62] = ld_r_r_0x62,
+    [0x63] = ld_r_r_0x63,
+    [0x64] = nop,
+    [0x65] = ld_r_r_0x65,
+    [0x66] = ld_r_r_0x66,
+    [0x67] = ld_r_r_0x67,
+    [0x68] = ld_r_r_0x68,
+    [0x69] = ld_r_r_0x69,
+    [0x6A] = ld_r_r_0x6A,
+    [0x6B] = ld_r_r_0x6B,
+    [0x6C] = ld_r_r_0x6C,
+    [0x6D] = nop,
+    [0x6E] = ld_r_r_0x6E,
+    [0x6F] = ld_r_r_0x6F,
+    /*              ROW 8               */
+    [0x70] = ld_r_r_0x70,
+    [0x71] = ld_r_r_0x71,
+    [0x72] = ld_r_r_0x72,
+    [0x73] = ld_r_r_0x73,
+    [0x74] = ld_r_r_0x74,
+    [0x75] = ld_r_r_0x75,
+    [0x76] = halt,
+    [0x77] = ld_r_r_0x77,
+    [0x78] = ld_r_r_0x78,
+    [0x79] = ld_r_r_0x79,
+    [0x7A] = ld_r_r_0x7A,
+    [0x7B] = ld_r_r_0x7B,
+    [0x7C] = ld_r_r_0x7C,
+    [0x7D] = ld_r_r_0x7D,
+    [0x7E] = ld_r_r_0x7E,
+    [0x7F] = nop,
+    /*              ROW 9               */
+    [0x80] = alu_a_r_0x80,
+    [0x81] = alu_a_r_0x81,
+    [0x82] = alu_a_r_0x82,
+    [0x83] = alu_a_r_0x83,
+    [0x84] = alu_a_r_0x84,
+    [0x85] = alu_a_r_0x85,
+    [0x86] = alu_a_r_0x86,
+    [0x87] = alu_a_r_0x87,
+    [0x88] = alu_a_r_0x88,
+    [0x89] = alu_a_r_0x89,
+    [0x8A] = alu_a_r_0x8A,
+    [0x8B] = alu_a_r_0x8B,
+    [0x8C] = alu_a_r_0x8C,
+    [0x8D] = alu_a_r_0x8D,
+    [0x8E] = alu_a_r_0x8E,
+    [0x8F] = alu_a_r_0x8F,
+    /*              ROW 10              */
+    [0x90] = alu_a_r_0x90,
+    [0x91] = alu_a_r_0x91,
+    [0x92] = alu_a_r_0x92,
+    [0x93] = alu_a_r_0x93,
+    [0x94] = alu_a_r_0x94,
+    [0x95] = alu_a_r_0x95,
+    [0x96] = alu_a_r_0x96,
+    [0x97] = alu_a_r_0x97,
+    [0x98] = alu_a_r_0x98,
+    [0x99] = alu_a_r_0x99,
+    [0x9A] = alu_a_r_0x9A,
+    [0x9B] = alu_a_r_0x9B,
+    [0x9C] = alu_a_r_0x9C,
+    [0x9D] = alu_a_r_0x9D,
+    [0x9E] = alu_a_r_0x9E,
+    [0x9F] = alu_a_r_0x9F,
+    /*              ROW 11              */
+    [0xA0] = alu_a_r_0xA0,
+    [0xA1] = alu_a_r_0xA1,
+    [0xA2] = alu_a_r_0xA2,
+    [0xA3] = alu_a_r_0xA3,
+    [0xA4] = alu_a_r_0xA4,
+    [0xA5] = alu_a_r_0xA5,
+    [0xA6] = alu_a_r_0xA6,
+    [0xA7] = alu_a_r_0xA7,
+    [0xA8] = alu_a_r_0xA8,
+    [0xA9] = alu_a_r_0xA9,
+    [0xAA] = alu_a_r_0xAA,
+    [0xAB] = alu_a_r_0xAB,
+    [0xAC] = alu_a_r_0xAC,
+    [0xAD] = alu_a_r_0xAD,
+    [0xAE] = alu_a_r_0xAE,
+    [0xAF] = alu_a_r_0xAF,
+    /*              ROW 12              */
+    [0xB0] = alu_a_r_0xB0,
+    [0xB1] = alu_a_r_0xB1,
+    [0xB2] = alu_a_r_0xB2,
+    [0xB3] = alu_a_r_0xB3,
+    [0xB4] = alu_a_r_0xB4,
+    [0xB5] = alu_a_r_0xB5,
+    [0xB6] = alu_a_r_0xB6,
+    [0xB7] = alu_a_r_0xB7,
+    [0xB8] = alu_a_r_0xB8,
+    [0xB9] = alu_a_r_0xB9,
+    [0xBA] = alu_a_r_0xBA,
+    [0xBB] = alu_a_r_0xBB,
+    [0xBC] = alu_a_r_0xBC,
+    [0xBD] = alu_a_r_0xBD,
+    [0xBE] = alu_a_r_0xBE,
+    [0xBF] = alu_a_r_0xBF,
+    /*              ROW 13              */
+    [0xC0] = ret_nz,
+    [0xC1] = pop_bc,
+    [0xC2] = jp_nz_nn,
+    [0xC3] = jp_nn,
+    [0xC4] = call_nz_nn,
+    [0xC5] = push_bc,
+    [0xC6] = add_a_n,
+    [0xC7] = rst_00,
+    [0xC8] = ret_z,
+    [0xC9] = ret,
+    [0xCA] = jp_z_nn,
+    [0xCB] = cb_prefix,
+    [0xCC] = call_z_nn,
+    [0xCD] = call_nn,
+    [0xCE] = adc_a_n,
+    [0xCF] = rst_08,
+    /*              ROW 14              */
+    [0xD0] = ret_nc,
+    [0xD1] = pop_de,
+    [0xD2] = jp_nc_nn,
+    [0xD3] = vram_print,
+    [0xD4] = call_nc_nn,
+    [0xD5] = push_de,
+    [0xD6] = sub_a_n,
+    [0xD7] = rst_10,
+    [0xD8] = ret_c,
+    [0xD9] = reti,
+    [0xDA] = jp_c_nn,
+    [0xDB] = nop,
+    [0xDC] = call_c_nn,
+    [0xDD] = nop,
+    [0xDE] = sbc_a_n,
+    [0xDF] = rst_18,
+    /*              ROW 15              */
+    [0xE0] = ldh_n_a,
+    [0xE1] = pop_hl,
+    [0xE2] = ldh_c_a,
+    [0xE3] = nop,
+    [0xE4] = nop,
+    [0xE5] = push_hl,
+    [0xE6] = and_a_n,
+    [0xE7] = rst_20,
+    [0xE8] = add_sp_n,
+    [0xE9] = jp_hl,
+    [0xEA] = ld_nn_a,
+    [0xEB] = nop,
+    [0xEC] = nop,
+    [0xED] = nop,
+    [0xEE] = xor_a_n,
+    [0xEF] = rst_28,
+    /*              ROW 16              */
+    [0xF0] = ldh_a_n,
+    [0xF1] = pop_af,
+    [0xF2] = ldh_a_c,
+    [0xF3] = di,
+    [0xF4] = nop,
+    [0xF5] = push_af,
+    [0xF6] = or_a_n,
+    [0xF7] = rst_30,
+    [0xF8] = ld_hl_sp_n,
+    [0xF9] = ld_sp_hl,
+    [0xFA] = ld_a_nn,
+    [0xFB] = ei,
+    [0xFC] = nop,
+    [0xFD] = nop,
+    [0xFE] = cp_a_n,
+    [0xFF] = rst_38,
+};
+// Checked
+static uint8_t reg_rlc_8(GbcMachine *gb, uint8_t r)
 {
-    reg_cp_8(R->A, R->L);
-    cpu_log(DEBUG, "%02X < %02X = %d", R->A, R->L, is_flag_set(CARRY_FLAG));
-    return true;
+    uint8_t carry_out = ((r & BIT_7_MASK) != 0);
+    uint8_t    result = ((r << 1) | carry_out);
+    record_flags(gb, FLAGS_SHIFT, r, 0, result, carry_out);
+    return result;
 }
-static bool cp_a_hl(InstructionEntity *ins)    // 0xBE (Z 1 H C) 2M
+// Checked
+static uint8_t reg_rrc_8(GbcMachine *gb, uint8_t r)
 {
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        uint16_t hl = getDR(HL_REG);
-        ins->low = read_memory(hl);
-        reg_cp_8(R->A, ins->low);
-        cpu_log(DEBUG, "%02X < %02X %d", R->A, ins->low, is_flag_set(CARRY_FLAG));
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
+    uint8_t carry_out = ((r & BIT_0_MASK) != 0);
+    uint8_t    result = ((carry_out << 7) | (r >> 1));
+    record_flags(gb, FLAGS_SHIFT, r, 0, result, carry_out);
+    return result;
 }
-static bool cp_a_a(InstructionEntity *ins)     // 0xBF (Z 1 H C) 1M
+// Checked
+static uint8_t reg_rl_8(GbcMachine *gb, uint8_t r)
 {
-    reg_cp_8(R->A, R->A);
-    cpu_log(DEBUG, "%02X < %02X = %d", R->A, R->A, is_flag_set(CARRY_FLAG));
-    return true;
-}
-static bool cp_a_n(InstructionEntity *ins)     // 0xFE (Z 1 H C) 2M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        reg_cp_8(R->A, ins->low);
-        cpu_log(DEBUG, "%02X < %02X %d", R->A, ins->low, is_flag_set(CARRY_FLAG));
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-// Checked
-static bool return_handler(InstructionEntity *ins, bool returning)
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        if (!returning)
-        {
-            cpu_log(DEBUG, "Condition not met, stopping early.");
-        }
-        return !returning;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        ins->low = pop_stack();
-        cpu_log(DEBUG, "Popped $%02X", ins->low);
-        return false;
-    }
-
-    if (ins->duration == 4) // Fourth Cycle
-    {
-        ins->high = pop_stack();
-        cpu_log(DEBUG, "Popped $%02X", ins->high);
-        return false;
-    }
-
-    if (ins->duration == 5) // Fifth Cycle
-    {
-        ins->address = form_address(ins);
-        R->PC = ins->address;
-        cpu_log(DEBUG, "Address - [$%04X]", R->PC);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool ret_nz(InstructionEntity *ins)     // 0xC0 (- - - -) 5M
-{
-    return return_handler(ins, !is_flag_set(ZERO_FLAG));
-}
-static bool ret_nc(InstructionEntity *ins)     // 0xD0 (- - - -) 5M
-{
-    return return_handler(ins, !is_flag_set(CARRY_FLAG));
-}
-static bool ret_c(InstructionEntity *ins)      // 0xD8 (- - - -) 5M
-{
-    return return_handler(ins, is_flag_set(CARRY_FLAG));
-}
-static bool ret_z(InstructionEntity *ins)      // 0xC8 (- - - -) 5M
-{
-    return return_handler(ins, is_flag_set(ZERO_FLAG));
-}
-static bool ret(InstructionEntity *ins)        // 0xC9 (- - - -) 4M
-{
-    if (ins->duration == 2) ins->duration += 1; // Skips check cycle
-    return return_handler(ins, true);
-}
-static bool reti(InstructionEntity *ins)       // 0xD9 (- - - -) 4M
-{
-    if (ins->duration == 2) ins->duration += 1; // Skips check cycle
-    bool result = return_handler(ins, true);
-    if (ins->duration == 4) schedule_ime(iee);
-    return result;
-}
-// Checked
-static bool rst_handler(InstructionEntity *ins, uint16_t rst_vector)
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->high = (R->PC >> BYTE) & LOWER_BYTE_MASK;
-        push_stack(ins->high);
-        cpu_log(DEBUG, "Pushed $%02X", ins->high);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        ins->low = R->PC & LOWER_BYTE_MASK;
-        push_stack(ins->low);
-        cpu_log(DEBUG, "Pushed $%02X", ins->low);
-        return false;
-    }
-
-    if (ins->duration == 4) // Fourth Cycle
-    {
-        R->PC = rst_vector;
-        cpu_log(DEBUG, "Subroutine $%02X", rst_vector);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool rst_00(InstructionEntity *ins)     // 0xC7 (- - - -) 4M
-{
-    return rst_handler(ins, 0x00);
-}
-static bool rst_10(InstructionEntity *ins)     // 0xD7 (- - - -) 4M
-{
-    return rst_handler(ins, 0x10);
-}
-static bool rst_20(InstructionEntity *ins)     // 0xE7 (- - - -) 4M
-{
-    return rst_handler(ins, 0x20);
-}
-static bool rst_30(InstructionEntity *ins)     // 0xF7 (- - - -) 4M
-{
-    return rst_handler(ins, 0x30);
-}
-static bool rst_08(InstructionEntity *ins)     // 0xCF (- - - -) 4M
-{
-    return rst_handler(ins, 0x08);
-}
-static bool rst_18(InstructionEntity *ins)     // 0xDF (- - - -) 4M
-{ 
-    return rst_handler(ins, 0x18);
-}
-static bool rst_28(InstructionEntity *ins)     // 0xEF (- - - -) 4M
-{
-    return rst_handler(ins, 0x28);
-}
-static bool rst_38(InstructionEntity *ins)     // 0xFF (- - - -) 4M
-{
-    return rst_handler(ins, 0x38);
-}
-// Checked
-static bool call_handler(InstructionEntity *ins, bool calling)
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        ins->high = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->high);
-        if (!calling)
-        {
-            cpu_log(DEBUG, "Condition not met, stopping early.");
-            return true;
-        }
-        return false;
-    }
-
-    if (ins->duration == 4) // Fourth Cycle
-    {
-        uint8_t pc_high = (R->PC >> BYTE) & LOWER_BYTE_MASK;
-        push_stack(pc_high);
-        cpu_log(DEBUG, "Pushed $%02X", pc_high);
-        return false;
-    }
-
-    if (ins->duration == 5) // Fifth Cycle
-    {
-        uint8_t pc_low = R->PC & LOWER_BYTE_MASK;
-        push_stack(pc_low);
-        cpu_log(DEBUG, "Pushed $%02X", pc_low);
-        return false;
-    }
-
-    if (ins->duration == 6) // Sixth Cycle
-    {   
-        ins->address = form_address(ins);
-        R->PC = ins->address;
-        cpu_log(DEBUG, "Address [$%04X]", ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool call_nz_nn(InstructionEntity *ins) // 0xC4 (- - - -) 6M
-{
-    return call_handler(ins, !is_flag_set(ZERO_FLAG));
-}
-static bool call_nc_nn(InstructionEntity *ins) // 0xD4 (- - - -) 6M
-{
-    return call_handler(ins, !is_flag_set(CARRY_FLAG));
-}
-static bool call_z_nn(InstructionEntity *ins)  // 0xCC (- - - -) 6M
-{
-    return call_handler(ins, is_flag_set(ZERO_FLAG));
-}
-static bool call_c_nn(InstructionEntity *ins)  // 0xDC (- - - -) 6M
-{
-    return call_handler(ins, is_flag_set(CARRY_FLAG));
-}
-static bool call_nn(InstructionEntity *ins)    // 0xCD (- - - -) 6M
-{
-    return call_handler(ins, true);
-}
-// Checked
-static bool jump_relative_handler(InstructionEntity *ins, bool jumping)
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
-        if (!jumping)
-        {
-            cpu_log(DEBUG, "Condition not met, stopping early.");
-            return true;
-        }
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        int8_t offset = (int8_t) ins->low;
-        uint16_t old_pc = R->PC;
-        R->PC += offset;
-        cpu_log(DEBUG, "$%04X to $%04X (offset %d)", old_pc, R->PC, offset); 
-        return true;      
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool jr_n(InstructionEntity *ins)       // 0x18 (- - - -) 3M
-{
-    return jump_relative_handler(ins, true);
-}
-static bool jr_z_n(InstructionEntity *ins)     // 0x28 (- - - -) 3M
-{
-    return jump_relative_handler(ins, is_flag_set(ZERO_FLAG));
-}
-static bool jr_c_n(InstructionEntity *ins)     // 0x38 (- - - -) 3M
-{
-    return jump_relative_handler(ins, is_flag_set(CARRY_FLAG));
-}
-static bool jr_nz_n(InstructionEntity *ins)    // 0x20 (- - - -) 3M
-{
-    return jump_relative_handler(ins, !is_flag_set(ZERO_FLAG));
-}
-static bool jr_nc_n(InstructionEntity *ins)    // 0x30 (- - - -) 3M
-{
-    return jump_relative_handler(ins, !is_flag_set(CARRY_FLAG));
-}
-// Checked
-static bool jump_position_handler(InstructionEntity *ins, bool jumping)
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        ins->high = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->high);
-        if (!jumping)
-        {
-            cpu_log(DEBUG, "Condition not met, stopping early.");
-            return true;
-        }
-        return false;
-    }
-
-    if (ins->duration == 4) // Fourth Cycle
-    {
-        ins->address = form_address(ins);
-        uint16_t old_pc = R->PC;
-        R->PC = ins->address;
-        cpu_log(DEBUG, "$%04X to $%04X", old_pc, R->PC);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool jp_nz_nn(InstructionEntity *ins)   // 0xC2 (- - - -) 4M
-{
-    return jump_position_handler(ins, !is_flag_set(ZERO_FLAG));
-}
-static bool jp_nc_nn(InstructionEntity *ins)   // 0xD2 (- - - -) 4M
-{
-    return jump_position_handler(ins, !is_flag_set(CARRY_FLAG));
-}
-static bool jp_nn(InstructionEntity *ins)      // 0xC3 (- - - -) 4M
-{
-    return jump_position_handler(ins, true);
-}
-static bool jp_z_nn(InstructionEntity *ins)    // 0xCA (- - - -) 4M
-{
-    return jump_position_handler(ins, is_flag_set(ZERO_FLAG));
-}
-static bool jp_c_nn(InstructionEntity *ins)    // 0xDA (- - - -) 4M
-{
-    return jump_position_handler(ins, is_flag_set(CARRY_FLAG));
-}
-static bool jp_hl(InstructionEntity *ins)      // 0xE9 (- - - -) 1M
-{
-    R->PC = getDR(HL_REG);
-    cpu_log(DEBUG, "Address $%04X", R->PC);
-    return true;
-}
-// Checked
-static bool daa(InstructionEntity *ins)        // 0x27 (Z - 0 C) 1M
-{
-    uint8_t correction = 0;
-    bool carry = is_flag_set(CARRY_FLAG);
-
-    if (!is_flag_set(SUBTRACT_FLAG)) 
-    {
-        if (is_flag_set(HALF_CARRY_FLAG) || ((R->A & 0x0F) > 9)) correction |= 0x06;
-        if (carry || R->A > 0x99) 
-        {
-            correction |= 0x60;
-            set_flag(true, CARRY_FLAG);
-        } 
-        else 
-        {
-            set_flag(false, CARRY_FLAG);
-        }
-        R->A += correction;
-    } 
-    else 
-    {
-        if (is_flag_set(HALF_CARRY_FLAG)) correction |= 0x06;
-        if (carry)                        correction |= 0x60;
-        R->A -= correction;
-    }
-
-    set_flag((R->A == 0), ZERO_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    cpu_log(DEBUG, "A=$%02X", R->A);
-    return true;
-}
-
-static bool cpl(InstructionEntity *ins)        // 0x2F (- 1 1 -) 1M
-{
-    R->A = ~R->A;
-    set_flag(true, SUBTRACT_FLAG);
-    set_flag(true, HALF_CARRY_FLAG);
-    cpu_log(DEBUG, "$%02X", R->A);
-    return true;
-}
-static bool scf(InstructionEntity *ins)        // 0x07 (- 0 0 1) 1M
-{
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(true, CARRY_FLAG);
-    cpu_log(DEBUG, "...");
-    return true;
-}
-static bool ccf(InstructionEntity *ins)        // 0x3F (- 0 0 C) 1M
-{
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(!is_flag_set(CARRY_FLAG), CARRY_FLAG);
-    cpu_log(DEBUG, "...");
-    return true;
+    uint8_t carry_out = ((r & BIT_7_MASK) != 0);
+    uint8_t    result = ((r << 1) | get_carry(gb));
+    record_flags(gb, FLAGS_SHIFT, r, 0, result, carry_out);
+    return result;
 }
 // Checked
-static bool ldh_n_a(InstructionEntity *ins)    // 0xE0 (- - - -) 3M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->    low = fetch();
-        ins->address = (0xFF00 | ins->low);
-        cpu_log(DEBUG, "Fetched $%02X, Address [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        write_memory(ins->address, R->A);
-        cpu_log(DEBUG, "Wrote $%02X into [$%04X]", R->A, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool ldh_a_n(InstructionEntity *ins)    // 0xF0 (- - - -) 3M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->    low = fetch();
-        ins->address = (0xFF00 | ins->low);
-        cpu_log(DEBUG, "Fetched $%02X, Address [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        R->A = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", R->A, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool ldh_c_a(InstructionEntity *ins)    // 0xE1 (- - - -) 2M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        ins->address = (0xFF00 | R->C);
-        cpu_log(DEBUG, "Address [$%04X]", ins->address);
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        write_memory(ins->address, R->A);
-        cpu_log(DEBUG, "Wrote $%02X into [$%04X]", R->A, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool ldh_a_c(InstructionEntity *ins)    // 0xF1 (- - - -) 2M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        ins->address = (0xFF00 | R->C);
-        cpu_log(DEBUG, "Address [$%04X]", ins->address);
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        R->A = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", R->A, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-// Checked
-static bool ld_nn_a(InstructionEntity *ins)    // 0xEA (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        ins->high = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->high);
-        return false;
-    }
-
-    if (ins->duration == 4) // Fourth Cycle
-    {
-        ins->address = form_address(ins);
-        write_memory(ins->address, R->A);
-        cpu_log(DEBUG, "Wrote $%02X into [$%04X]", R->A, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool ld_a_nn(InstructionEntity *ins)    // 0xFA (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        ins->high = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->high);
-        return false;
-    }
-
-    if (ins->duration == 4) // Fourth Cycle
-    {
-        ins->address = form_address(ins);
-        R->A = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", R->A, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool ld_hl_sp_n(InstructionEntity *ins) // 0xF8 (0 0 H C) 3M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        int8_t        n = (int8_t) ins->low;
-        uint16_t result = R->SP + n;
-        bool hc_exists = ((R->SP & LOWER_4_MASK) + (((uint8_t) n) & LOWER_4_MASK)) > LOWER_4_MASK;
-        bool c_exists  = ((R->SP & 0xFF) + (((uint8_t) n) & 0xFF)) > 0xFF;
-        set_flag(false, ZERO_FLAG);
-        set_flag(false, SUBTRACT_FLAG);
-        set_flag(hc_exists, HALF_CARRY_FLAG);
-        set_flag(c_exists, CARRY_FLAG);
-        setDR(HL_REG, result);
-        cpu_log(DEBUG, "HL - $%04X", getDR(HL_REG));
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool ld_sp_hl(InstructionEntity *ins)   // 0xF9 (- - - -) 2M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        R->SP = getDR(HL_REG);
-        cpu_log(DEBUG, "$%02X", R->SP);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool add_sp_n(InstructionEntity *ins)   // 0xE8 (0 0 H C) 4M
-{
-    if (ins->duration <= 2) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 3) // Second Cycle
-    {
-        ins->low = fetch();
-        cpu_log(DEBUG, "Fetched $%02X", ins->low);
-        return false;
-    }
-
-    if (ins->duration == 4) // Third Cycle
-    {
-        int8_t        n = (int8_t) ins->low;
-        uint16_t    sum = (R->SP + n);
-        bool  hc_exists = ((R->SP & LOWER_4_MASK) + (((uint8_t) n) & LOWER_4_MASK)) > LOWER_4_MASK;
-        bool  c_exists  = ((R->SP & 0xFF) + (((uint8_t) n) & 0xFF)) > 0xFF;
-        set_flag(false, ZERO_FLAG);
-        set_flag(false, SUBTRACT_FLAG);
-        set_flag(hc_exists, HALF_CARRY_FLAG);
-        set_flag(c_exists, CARRY_FLAG);
-        R->SP = sum;
-        cpu_log(DEBUG, "$%04X", R->SP);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-// Checked
-static bool di(InstructionEntity *ins)         // 0xF3 (- - - -) 1M
-{
-    cpu->   ime = false;
-    iee->active = false;
-    cpu_log(DEBUG, "Disable Interrupt Request");
-    return true;
-}
-static bool ei(InstructionEntity *ins)         // 0xFB (- - - -) 1M
-{
-    schedule_ime(iee);
-    cpu_log(DEBUG, "IEE scheduled, expect after next instruction.");
-    return true;
-}
-static bool cb_prefix(InstructionEntity *ins)  // 0xCB (- - - -) 1m
-{
-    cpu_log(DEBUG, "...");
-    cb_prefixed = true;
-    return true;
-}
-// Checked
-static bool vram_print(InstructionEntity *ins) // 0xXX (- - - -) 1M
-{
-    uint8_t lower  = fetch();
-    uint8_t upper  = fetch();
-    uint16_t start = (upper << BYTE) | lower;
-    lower          = fetch();
-    upper          = fetch();
-    uint16_t end   = (upper << BYTE) | lower;
-    bool bank      = (bool) fetch();
-    print_vram(start, end, bank);
-    return 1; 
-}
-static bool int_exec(InstructionEntity *ins)   // 0xXX (- - - -) 5M
-{
-    if (ins->duration <= 2) // First & Second Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t pc_high = (R->PC >> BYTE) & LOWER_BYTE_MASK;
-        push_stack(pc_high);
-        cpu_log(DEBUG, "Pushed $%02X", pc_high);
-        return false;
-    }
-
-    if (ins->duration == 4) // Fourth Cycle
-    {
-        uint8_t pc_low = R->PC & LOWER_BYTE_MASK;
-        push_stack(pc_low);
-        cpu_log(DEBUG, "Pushed $%02X", pc_low);
-        return false;
-    }
-
-    if (ins->duration == 5) // Fifth Cycle
-    {
-        R->PC = ins->address;    // Set when serviciing
-        write_ifr(*R->IFR & ~ins->low);  // Confirm servicing
-        cpu_log(DEBUG, "Address $%04X", ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-// Checked
-const OpcodeHandler opcode_table[256] = 
-{
-    /*              ROW 1               */
-    [0x00] = nop,   
-    [0x01] = ld_bc_nn,
-    [0x02] = ld_bc_a,
-    [0x03] = inc_bc,
-    [0x04] = inc_b,
-    [0x05] = dec_b,
-    [0x06] = ld_b_n,
-    [0x07] = rlca,
-    [0x08] = ld_nn_sp,
-    [0x09] = add_hl_bc,
-    [0x0A] = ld_a_bc,
-    [0x0B] = dec_bc,
-    [0x0C] = inc_c,
-    [0x0D] = dec_c,
-    [0x0E] = ld_c_n,
-    [0x0F] = rrca,
-    /*              ROW 2               */
-    [0x10] = stop,
-    [0x11] = ld_de_nn,
-    [0x12] = ld_de_a,
-    [0x13] = inc_de,
-    [0x14] = inc_d,
-    [0x15] = dec_d,
-    [0x16] = ld_d_n,
-    [0x17] = rla,
-    [0x18] = jr_n,
-    [0x19] = add_hl_de,
-    [0x1A] = ld_a_de,
-    [0x1B] = dec_de,
-    [0x1C] = inc_e,
-    [0x1D] = dec_e,
-    [0x1E] = ld_e_n,
-    [0x1F] = rra,
-    /*              ROW 3               */
-    [0x20] = jr_nz_n,
-    [0x21] = ld_hl_nn,
-    [0x22] = ld_hli_a,
-    [0x23] = inc_hl,
-    [0x24] = inc_h,
-    [0x25] = dec_h,
-    [0x26] = ld_h_n,
-    [0x27] = daa,
-    [0x28] = jr_z_n,
-    [0x29] = add_hl_hl,
-    [0x2A] = ld_a_hli,
-    [0x2B] = dec_hl,
-    [0x2C] = inc_l,
-    [0x2D] = dec_l,
-    [0x2E] = ld_l_n,
-    [0x2F] = cpl,
-    /*              ROW 4               */
-    [0x30] = jr_nc_n,
-    [0x31] = ld_sp_nn,
-    [0x32] = ld_hld_a,
-    [0x33] = inc_sp,
-    [0x34] = inc_hl_mem,
-    [0x35] = dec_hl_mem,
-    [0x36] = ld_hl_n,
-    [0x37] = scf,
-    [0x38] = jr_c_n,
-    [0x39] = add_hl_sp,
-    [0x3A] = ld_a_hld,
-    [0x3B] = dec_sp,
-    [0x3C] = inc_a,
-    [0x3D] = dec_a,
-    [0x3E] = ld_a_n,
-    [0x3F] = ccf,
-    /*              ROW 5               */
-    [0x40] = nop,   
-    [0x41] = ld_b_c,
-    [0x42] = ld_b_d,
-    [0x43] = ld_b_e,
-    [0x44] = ld_b_h,
-    [0x45] = ld_b_l,
-    [0x46] = ld_b_hl,
-    [0x47] = ld_b_a,
-    [0x48] = ld_c_b,
-    [0x49] = nop,
-    [0x4A] = ld_c_d,
-    [0x4B] = ld_c_e,
-    [0x4C] = ld_c_h,
-    [0x4D] = ld_c_l,
-    [0x4E] = ld_c_hl,
-    [0x4F] = ld_c_a,
-    /*              ROW 6               */
-    [0x50] = ld_d_b,
-    [0x51] = ld_d_c,
-    [0x52] = nop,
-    [0x53] = ld_d_e,
-    [0x54] = ld_d_h,
-    [0x55] = ld_d_l,
-    [0x56] = ld_d_hl,
-    [0x57] = ld_d_a,
-    [0x58] = ld_e_b,
-    [0x59] = ld_e_c,
-    [0x5A] = ld_e_d,
-    [0x5B] = nop,
-    [0x5C] = ld_e_h,
-    [0x5D] = ld_e_l,
-    [0x5E] = ld_e_hl,
-    [0x5F] = ld_e_a,
-    /*              ROW 7               */
-    [0x60] = ld_h_b,
-    [0x61] = ld_h_c,
-    [0x62] = ld_h_d,
-    [0x63] = ld_h_e,
-    [0x64] = nop,
-    [0x65] = ld_h_l,
-    [0x66] = ld_h_hl,
-    [0x67] = ld_h_a,
-    [0x68] = ld_l_b,
-    [0x69] = ld_l_c,
-    [0x6A] = ld_l_d,
-    [0x6B] = ld_l_e,
-    [0x6C] = ld_l_h,
-    [0x6D] = nop,
-    [0x6E] = ld_l_hl,
-    [0x6F] = ld_l_a,
-    /*              ROW 8               */
-    [0x70] = ld_hl_b,
-    [0x71] = ld_hl_c,
-    [0x72] = ld_hl_d,
-    [0x73] = ld_hl_e,
-    [0x74] = ld_hl_h,
-    [0x75] = ld_hl_l,
-    [0x76] = halt,
-    [0x77] = ld_hl_a,
-    [0x78] = ld_a_b,
-    [0x79] = ld_a_c,
-    [0x7A] = ld_a_d,
-    [0x7B] = ld_a_e,
-    [0x7C] = ld_a_h,
-    [0x7D] = ld_a_l,
-    [0x7E] = ld_a_hl,
-    [0x7F] = nop,
-    /*              ROW 9               */
-    [0x80] = add_a_b,
-    [0x81] = add_a_c,
-    [0x82] = add_a_d,
-    [0x83] = add_a_e,
-    [0x84] = add_a_h,
-    [0x85] = add_a_l,
-    [0x86] = add_a_hl,
-    [0x87] = add_a_a,
-    [0x88] = adc_a_b,
-    [0x89] = adc_a_c,
-    [0x8A] = adc_a_d,
-    [0x8B] = adc_a_e,
-    [0x8C] = adc_a_h,
-    [0x8D] = adc_a_l,
-    [0x8E] = adc_a_hl,
-    [0x8F] = adc_a_a,
-    /*              ROW 10              */
-    [0x90] = sub_a_b,
-    [0x91] = sub_a_c,
-    [0x92] = sub_a_d,
-    [0x93] = sub_a_e,
-    [0x94] = sub_a_h,
-    [0x95] = sub_a_l,
-    [0x96] = sub_a_hl,
-    [0x97] = sub_a_a,
-    [0x98] = sbc_a_b,
-    [0x99] = sbc_a_c,
-    [0x9A] = sbc_a_d,
-    [0x9B] = sbc_a_e,
-    [0x9C] = sbc_a_h,
-    [0x9D] = sbc_a_l,
-    [0x9E] = sbc_a_hl,
-    [0x9F] = sbc_a_a,
-    /*              ROW 11              */
-    [0xA0] = and_a_b,
-    [0xA1] = and_a_c,
-    [0xA2] = and_a_d,
-    [0xA3] = and_a_e,
-    [0xA4] = and_a_h,
-    [0xA5] = and_a_l,
-    [0xA6] = and_a_hl,
-    [0xA7] = and_a_a,
-    [0xA8] = xor_a_b,
-    [0xA9] = xor_a_c,
-    [0xAA] = xor_a_d,
-    [0xAB] = xor_a_e,
-    [0xAC] = xor_a_h,
-    [0xAD] = xor_a_l,
-    [0xAE] = xor_a_hl,
-    [0xAF] = xor_a_a,
-    /*              ROW 12              */
-    [0xB0] = or_a_b,
-    [0xB1] = or_a_c,
-    [0xB2] = or_a_d,
-    [0xB3] = or_a_e,
-    [0xB4] = or_a_h,
-    [0xB5] = or_a_l,
-    [0xB6] = or_a_hl,
-    [0xB7] = or_a_a,
-    [0xB8] = cp_a_b,
-    [0xB9] = cp_a_c,
-    [0xBA] = cp_a_d,
-    [0xBB] = cp_a_e,
-    [0xBC] = cp_a_h,
-    [0xBD] = cp_a_l,
-    [0xBE] = cp_a_hl,
-    [0xBF] = cp_a_a,
-    /*              ROW 13              */
-    [0xC0] = ret_nz,
-    [0xC1] = pop_bc,
-    [0xC2] = jp_nz_nn,
-    [0xC3] = jp_nn,
-    [0xC4] = call_nz_nn,
-    [0xC5] = push_bc,
-    [0xC6] = add_a_n,
-    [0xC7] = rst_00,
-    [0xC8] = ret_z,
-    [0xC9] = ret,
-    [0xCA] = jp_z_nn,
-    [0xCB] = cb_prefix,
-    [0xCC] = call_z_nn,
-    [0xCD] = call_nn,
-    [0xCE] = adc_a_n,
-    [0xCF] = rst_08,
-    /*              ROW 14              */
-    [0xD0] = ret_nc,
-    [0xD1] = pop_de,
-    [0xD2] = jp_nc_nn,
-    [0xD3] = vram_print,
-    [0xD4] = call_nc_nn,
-    [0xD5] = push_de,
-    [0xD6] = sub_a_n,
-    [0xD7] = rst_10,
-    [0xD8] = ret_c,
-    [0xD9] = reti,
-    [0xDA] = jp_c_nn,
-    [0xDB] = nop,
-    [0xDC] = call_c_nn,
-    [0xDD] = nop,
-    [0xDE] = sbc_a_n,
-    [0xDF] = rst_18,
-    /*              ROW 15              */
-    [0xE0] = ldh_n_a,
-    [0xE1] = pop_hl,
-    [0xE2] = ldh_c_a,
-    [0xE3] = nop,
-    [0xE4] = nop,
-    [0xE5] = push_hl,
-    [0xE6] = and_a_n,
-    [0xE7] = rst_20,
-    [0xE8] = add_sp_n,
-    [0xE9] = jp_hl,
-    [0xEA] = ld_nn_a,
-    [0xEB] = nop,
-    [0xEC] = nop,
-    [0xED] = nop,
-    [0xEE] = xor_a_n,
-    [0xEF] = rst_28,
-    /*              ROW 16              */
-    [0xF0] = ldh_a_n,
-    [0xF1] = pop_af,
-    [0xF2] = ldh_a_c,
-    [0xF3] = di,
-    [0xF4] = nop,
-    [0xF5] = push_af,
-    [0xF6] = or_a_n,
-    [0xF7] = rst_30,
-    [0xF8] = ld_hl_sp_n,
-    [0xF9] = ld_sp_hl,
-    [0xFA] = ld_a_nn,
-    [0xFB] = ei,
-    [0xFC] = nop,
-    [0xFD] = nop,
-    [0xFE] = cp_a_n,
-    [0xFF] = rst_38,
-};
-// Checked
-static uint8_t reg_rlc_8(uint8_t r)
-{
-    bool  c_exists = ((r & BIT_7_MASK) != 0);
-    uint8_t carry_in = c_exists ? 1 : 0;
-    uint8_t   result = ((r << 1) | carry_in);
-    bool   is_zero = (result == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    return result;
-}
-static bool rlc_b(InstructionEntity *ins)     // 0x00 (Z 0 0 C) 2M
-{
-    R->B = reg_rlc_8(R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool rlc_c(InstructionEntity *ins)     // 0x01 (Z 0 0 C) 2M
-{
-    R->C = reg_rlc_8(R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}  
-static bool rlc_d(InstructionEntity *ins)     // 0x02 (Z 0 0 C) 2M
-{
-    R->D = reg_rlc_8(R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}  
-static bool rlc_e(InstructionEntity *ins)     // 0x03 (Z 0 0 C) 2M
-{
-    R->E = reg_rlc_8(R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}  
-static bool rlc_h(InstructionEntity *ins)     // 0x04 (Z 0 0 C) 2M
-{
-    R->H = reg_rlc_8(R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}  
-static bool rlc_l(InstructionEntity *ins)     // 0x05 (Z 0 0 C) 2M
-{
-    R->L = reg_rlc_8(R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}  
-static bool rlc_hl(InstructionEntity *ins)    // 0x06 (Z 0 0 C) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = reg_rlc_8(ins->low);
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}  
-static bool rlc_a(InstructionEntity *ins)     // 0x07 (Z 0 0 C) 2M
-{
-    R->A = reg_rlc_8(R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}     
-// Checked
-static uint8_t reg_rrc_8(uint8_t r)
-{
-    bool  c_exists = ((r & BIT_0_MASK) != 0);
-    uint8_t carry_in = c_exists ? 1 : 0;
-    uint8_t result = ((carry_in << 7) | (r >> 1));
-    bool   is_zero = (result == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    return result;
-}
-static bool rrc_b(InstructionEntity *ins)     // 0x08 (Z 0 0 C) 2M
-{
-    R->B = reg_rrc_8(R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool rrc_c(InstructionEntity *ins)     // 0x09 (Z 0 0 C) 2M
-{
-    R->C = reg_rrc_8(R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool rrc_d(InstructionEntity *ins)     // 0x0A (Z 0 0 C) 2M
-{
-    R->D = reg_rrc_8(R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool rrc_e(InstructionEntity *ins)     // 0x0B (Z 0 0 C) 2M
-{
-    R->E = reg_rrc_8(R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool rrc_h(InstructionEntity *ins)     // 0x0C (Z 0 0 C) 2M
-{
-    R->H = reg_rrc_8(R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool rrc_l(InstructionEntity *ins)     // 0x0D (Z 0 0 C) 2M
-{
-    R->L = reg_rrc_8(R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool rrc_hl(InstructionEntity *ins)    // 0x0E (Z 0 0 C) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = reg_rrc_8(ins->low);
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool rrc_a(InstructionEntity *ins)     // 0x0F (Z 0 0 C) 2M
-{
-    R->A = reg_rrc_8(R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-// Checked
-static uint8_t reg_rl_8(uint8_t r)
-{
-    bool    c_exists = ((r & BIT_7_MASK) != 0);
-    uint8_t carry_in = is_flag_set(CARRY_FLAG) ? 1 : 0;
-    uint8_t   result = ((r << 1) | carry_in);
-    bool     is_zero = (result == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    return result;
-}
-static bool rl_b(InstructionEntity *ins)      // 0x10 (Z 0 0 C) 2M
-{
-    R->B = reg_rl_8(R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool rl_c(InstructionEntity *ins)      // 0x11 (Z 0 0 C) 2M
-{
-    R->C = reg_rl_8(R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool rl_d(InstructionEntity *ins)      // 0x12 (Z 0 0 C) 2M
-{
-    R->D = reg_rl_8(R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool rl_e(InstructionEntity *ins)      // 0x13 (Z 0 0 C) 2M
-{
-    R->E = reg_rl_8(R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool rl_h(InstructionEntity *ins)      // 0x14 (Z 0 0 C) 2M
-{
-    R->H = reg_rl_8(R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool rl_l(InstructionEntity *ins)      // 0x15 (Z 0 0 C) 2M
-{
-    R->L = reg_rl_8(R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool rl_hl(InstructionEntity *ins)     // 0x16 (Z 0 0 C) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = reg_rl_8(ins->low);
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool rl_a(InstructionEntity *ins)      // 0x17 (Z 0 0 C) 2M
-{
-    R->A = reg_rl_8(R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-// Checked
-static uint8_t reg_rr_8(uint8_t r)
-{
-    bool    c_exists = ((r & BIT_0_MASK) != 0);
-    uint8_t carry_in = is_flag_set(CARRY_FLAG) ? 1 : 0;
-    uint8_t   result = ((carry_in << 7) | (r >> 1));
-    bool     is_zero = (result == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    return result;
-}
-static bool rr_b(InstructionEntity *ins)      // 0x18 (Z 0 0 C) 2M
-{
-    R->B = reg_rr_8(R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool rr_c(InstructionEntity *ins)      // 0x19 (Z 0 0 C) 2M
-{
-    R->C = reg_rr_8(R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool rr_d(InstructionEntity *ins)      // 0x1A (Z 0 0 C) 2M
-{
-    R->D = reg_rr_8(R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool rr_e(InstructionEntity *ins)      // 0x1B (Z 0 0 C) 2M
-{
-    R->E = reg_rr_8(R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool rr_h(InstructionEntity *ins)      // 0x1C (Z 0 0 C) 2M
-{
-    R->H = reg_rr_8(R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool rr_l(InstructionEntity *ins)      // 0x1D (Z 0 0 C) 2M
-{
-    R->L = reg_rr_8(R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool rr_hl(InstructionEntity *ins)     // 0x1E (Z 0 0 C) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = reg_rr_8(ins->low);
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool rr_a(InstructionEntity *ins)      // 0x1F (Z 0 0 C) 2M
-{
-    R->A = reg_rr_8(R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-// Checked
-static uint8_t reg_sla_8(uint8_t r)
-{
-    bool  c_exists = ((r & BIT_7_MASK) != 0);
-    uint8_t result = (r << 1);
-    bool   is_zero = (result == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    return result;
-}
-static bool sla_b(InstructionEntity *ins)     // 0x20 (Z 0 0 C) 2M
-{
-    R->B = reg_sla_8(R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool sla_c(InstructionEntity *ins)     // 0x21 (Z 0 0 C) 2M
-{
-    R->C = reg_sla_8(R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool sla_d(InstructionEntity *ins)     // 0x22 (Z 0 0 C) 2M
-{
-    R->D = reg_sla_8(R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool sla_e(InstructionEntity *ins)     // 0x23 (Z 0 0 C) 2M
-{
-    R->E = reg_sla_8(R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool sla_h(InstructionEntity *ins)     // 0x24 (Z 0 0 C) 2M
-{
-    R->H = reg_sla_8(R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool sla_l(InstructionEntity *ins)     // 0x25 (Z 0 0 C) 2M
-{
-    R->L = reg_sla_8(R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool sla_hl(InstructionEntity *ins)    // 0x26 (Z 0 0 C) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = reg_sla_8(ins->low);
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool sla_a(InstructionEntity *ins)     // 0x27 (Z 0 0 C) 2M
-{
-    R->A = reg_sla_8(R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-// Checked
-static uint8_t reg_sra_8(uint8_t r)
-{
-    bool  c_exists = (r & BIT_0_MASK) != 0;
-    uint8_t result = (r & BIT_7_MASK) | (r >> 1);
-    bool   is_zero = (result == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    return result;
-}
-static bool sra_b(InstructionEntity *ins)     // 0x28 (Z 0 0 C) 2M
-{
-    R->B = reg_sra_8(R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool sra_c(InstructionEntity *ins)     // 0x29 (Z 0 0 C) 2M
-{
-    R->C = reg_sra_8(R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool sra_d(InstructionEntity *ins)     // 0x2A (Z 0 0 C) 2M
-{
-    R->D = reg_sra_8(R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool sra_e(InstructionEntity *ins)     // 0x2B (Z 0 0 C) 2M
-{
-    R->E = reg_sra_8(R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool sra_h(InstructionEntity *ins)     // 0x2C (Z 0 0 C) 2M
-{
-    R->H = reg_sra_8(R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool sra_l(InstructionEntity *ins)     // 0x2D (Z 0 0 C) 2M
-{
-    R->L = reg_sra_8(R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool sra_hl(InstructionEntity *ins)    // 0x2E (Z 0 0 C) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = reg_sra_8(ins->low);
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool sra_a(InstructionEntity *ins)     // 0x2F (Z 0 0 C) 2M
-{
-    R->A = reg_sra_8(R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-// Checked
-static uint8_t reg_swap_8(uint8_t r)
-{
-    uint8_t result  = ((r >> NIBBLE) | (r << NIBBLE));
-    bool    is_zero = (result == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(false, CARRY_FLAG);
-    return result;
-}
-static bool swap_b(InstructionEntity *ins)    // 0x30 (Z 0 0 0) 2M
-{
-    R->B = reg_swap_8(R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool swap_c(InstructionEntity *ins)    // 0x31 (Z 0 0 0) 2M
-{
-    R->C = reg_swap_8(R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;  
-}
-static bool swap_d(InstructionEntity *ins)    // 0x32 (Z 0 0 0) 2M
-{
-    R->D = reg_swap_8(R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool swap_e(InstructionEntity *ins)    // 0x33 (Z 0 0 0) 2M
-{
-    R->E = reg_swap_8(R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool swap_h(InstructionEntity *ins)    // 0x34 (Z 0 0 0) 2M
-{
-    R->H = reg_swap_8(R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool swap_l(InstructionEntity *ins)    // 0x35 (Z 0 0 0) 2M
-{
-    R->L = reg_swap_8(R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool swap_hl(InstructionEntity *ins)   // 0x36 (Z 0 0 0) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = reg_swap_8(ins->low);
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool swap_a(InstructionEntity *ins)    // 0x37 (Z 0 0 0) 2M
-{
-    R->A = reg_swap_8(R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-// Checked
-static uint8_t reg_srl_8(uint8_t r)
-{
-    bool  c_exists = ((r & BIT_0_MASK) != 0);
-    uint8_t result = (r >> 1);
-    bool   is_zero = (result == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(false, HALF_CARRY_FLAG);
-    set_flag(c_exists, CARRY_FLAG);
-    return result;
-}
-static bool srl_b(InstructionEntity *ins)     // 0x38 (Z 0 0 C) 2M
-{
-    R->B = reg_srl_8(R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool srl_c(InstructionEntity *ins)     // 0x39 (Z 0 0 C) 2M
-{
-    R->C = reg_srl_8(R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool srl_d(InstructionEntity *ins)     // 0x3A (Z 0 0 C) 2M
-{
-    R->D = reg_srl_8(R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool srl_e(InstructionEntity *ins)     // 0x3B (Z 0 0 C) 2M
-{
-    R->E = reg_srl_8(R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool srl_h(InstructionEntity *ins)     // 0x3C (Z 0 0 C) 2M
-{
-    R->H = reg_srl_8(R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool srl_l(InstructionEntity *ins)     // 0x3D (Z 0 0 C) 2M
-{
-    R->L = reg_srl_8(R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool srl_hl(InstructionEntity *ins)    // 0x3E (Z 0 0 C) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = reg_srl_8(ins->low);
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool srl_a(InstructionEntity *ins)     // 0x3F (Z 0 0 C) 2M
-{
-    R->A = reg_srl_8(R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-// Checked
-static void reg_bit_x(BitMask mask, uint8_t r)
-{
-    bool is_zero = ((r & mask) == 0);
-    set_flag(is_zero, ZERO_FLAG);
-    set_flag(false, SUBTRACT_FLAG);
-    set_flag(true, HALF_CARRY_FLAG);
-}
-static bool bit_0_b(InstructionEntity *ins)   // 0x40 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_0_MASK, R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool bit_0_c(InstructionEntity *ins)   // 0x41 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_0_MASK, R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool bit_0_d(InstructionEntity *ins)   // 0x42 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_0_MASK, R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool bit_0_e(InstructionEntity *ins)   // 0x43 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_0_MASK, R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool bit_0_h(InstructionEntity *ins)   // 0x44 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_0_MASK, R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool bit_0_l(InstructionEntity *ins)   // 0x45 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_0_MASK, R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool bit_0_hl(InstructionEntity *ins)  // 0x46 (Z 0 1 -) 3M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->address = getDR(HL_REG);
-        ins->    low = read_memory(ins->address);
-        reg_bit_x(BIT_0_MASK, ins->low);
-        cpu_log(DEBUG, "[$%04X] - %d", ins->address, is_flag_set(ZERO_FLAG));
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool bit_0_a(InstructionEntity *ins)   // 0x47 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_0_MASK, R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool bit_1_b(InstructionEntity *ins)   // 0x48 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_1_MASK, R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool bit_1_c(InstructionEntity *ins)   // 0x49 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_1_MASK, R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool bit_1_d(InstructionEntity *ins)   // 0x4A (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_1_MASK, R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool bit_1_e(InstructionEntity *ins)   // 0x4B (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_1_MASK, R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool bit_1_h(InstructionEntity *ins)   // 0x4C (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_1_MASK, R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool bit_1_l(InstructionEntity *ins)   // 0x4D (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_1_MASK, R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool bit_1_hl(InstructionEntity *ins)  // 0x4E (Z 0 1 -) 3M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->address = getDR(HL_REG);
-        ins->    low = read_memory(ins->address);
-        reg_bit_x(BIT_1_MASK, ins->low);
-        cpu_log(DEBUG, "[$%04X] - %d", ins->address, is_flag_set(ZERO_FLAG));
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool bit_1_a(InstructionEntity *ins)   // 0x4F (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_1_MASK, R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool bit_2_b(InstructionEntity *ins)   // 0x50 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_2_MASK, R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool bit_2_c(InstructionEntity *ins)   // 0x51 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_2_MASK, R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool bit_2_d(InstructionEntity *ins)   // 0x52 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_2_MASK, R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool bit_2_e(InstructionEntity *ins)   // 0x53 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_2_MASK, R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool bit_2_h(InstructionEntity *ins)   // 0x54 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_2_MASK, R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool bit_2_l(InstructionEntity *ins)   // 0x55 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_2_MASK, R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool bit_2_hl(InstructionEntity *ins)  // 0x56 (Z 0 1 -) 3M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->address = getDR(HL_REG);
-        ins->    low = read_memory(ins->address);
-        reg_bit_x(BIT_2_MASK, ins->low);
-        cpu_log(DEBUG, "[$%04X] - %d", ins->address, is_flag_set(ZERO_FLAG));
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool bit_2_a(InstructionEntity *ins)   // 0x57 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_2_MASK, R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool bit_3_b(InstructionEntity *ins)   // 0x58 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_3_MASK, R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool bit_3_c(InstructionEntity *ins)   // 0x59 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_3_MASK, R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool bit_3_d(InstructionEntity *ins)   // 0x5A (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_3_MASK, R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool bit_3_e(InstructionEntity *ins)   // 0x5B (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_3_MASK, R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool bit_3_h(InstructionEntity *ins)   // 0x5C (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_3_MASK, R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool bit_3_l(InstructionEntity *ins)   // 0x5D (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_3_MASK, R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool bit_3_hl(InstructionEntity *ins)  // 0x5E (Z 0 1 -) 3M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->address = getDR(HL_REG);
-        ins->    low = read_memory(ins->address);
-        reg_bit_x(BIT_3_MASK, ins->low);
-        cpu_log(DEBUG, "[$%04X] - %d", ins->address, is_flag_set(ZERO_FLAG));
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool bit_3_a(InstructionEntity *ins)   // 0x5F (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_3_MASK, R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool bit_4_b(InstructionEntity *ins)   // 0x60 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_4_MASK, R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool bit_4_c(InstructionEntity *ins)   // 0x61 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_4_MASK, R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool bit_4_d(InstructionEntity *ins)   // 0x62 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_4_MASK, R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool bit_4_e(InstructionEntity *ins)   // 0x63 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_4_MASK, R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool bit_4_h(InstructionEntity *ins)   // 0x64 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_4_MASK, R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool bit_4_l(InstructionEntity *ins)   // 0x65 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_4_MASK, R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool bit_4_hl(InstructionEntity *ins)  // 0x66 (Z 0 1 -) 3M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->address = getDR(HL_REG);
-        ins->    low = read_memory(ins->address);
-        reg_bit_x(BIT_4_MASK, ins->low);
-        cpu_log(DEBUG, "[$%04X] - %d", ins->address, is_flag_set(ZERO_FLAG));
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool bit_4_a(InstructionEntity *ins)   // 0x67 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_4_MASK, R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool bit_5_b(InstructionEntity *ins)   // 0x68 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_5_MASK, R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool bit_5_c(InstructionEntity *ins)   // 0x69 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_5_MASK, R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool bit_5_d(InstructionEntity *ins)   // 0x6A (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_5_MASK, R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool bit_5_e(InstructionEntity *ins)   // 0x6B (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_5_MASK, R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool bit_5_h(InstructionEntity *ins)   // 0x6C (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_5_MASK, R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool bit_5_l(InstructionEntity *ins)   // 0x6D (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_5_MASK, R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool bit_5_hl(InstructionEntity *ins)  // 0x6E (Z 0 1 -) 3M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->address = getDR(HL_REG);
-        ins->    low = read_memory(ins->address);
-        reg_bit_x(BIT_5_MASK, ins->low);
-        cpu_log(DEBUG, "[$%04X] - %d", ins->address, is_flag_set(ZERO_FLAG));
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool bit_5_a(InstructionEntity *ins)   // 0x6F (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_5_MASK, R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool bit_6_b(InstructionEntity *ins)   // 0x70 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_6_MASK, R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool bit_6_c(InstructionEntity *ins)   // 0x71 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_6_MASK, R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool bit_6_d(InstructionEntity *ins)   // 0x72 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_6_MASK, R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool bit_6_e(InstructionEntity *ins)   // 0x73 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_6_MASK, R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool bit_6_h(InstructionEntity *ins)   // 0x74 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_6_MASK, R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool bit_6_l(InstructionEntity *ins)   // 0x75 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_6_MASK, R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool bit_6_hl(InstructionEntity *ins)  // 0x76 (Z 0 1 -) 3M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->address = getDR(HL_REG);
-        ins->    low = read_memory(ins->address);
-        reg_bit_x(BIT_6_MASK, ins->low);
-        cpu_log(DEBUG, "[$%04X] - %d", ins->address, is_flag_set(ZERO_FLAG));
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool bit_6_a(InstructionEntity *ins)   // 0x77 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_6_MASK, R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool bit_7_b(InstructionEntity *ins)   // 0x78 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_7_MASK, R->B);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool bit_7_c(InstructionEntity *ins)   // 0x79 (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_7_MASK, R->C);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool bit_7_d(InstructionEntity *ins)   // 0x7A (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_7_MASK, R->D);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool bit_7_e(InstructionEntity *ins)   // 0x7B (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_7_MASK, R->E);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool bit_7_h(InstructionEntity *ins)   // 0x7C (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_7_MASK, R->H);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool bit_7_l(InstructionEntity *ins)   // 0x7D (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_7_MASK, R->L);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;;
-}
-static bool bit_7_hl(InstructionEntity *ins)  // 0x7E (Z 0 1 -) 3M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {
-        ins->address = getDR(HL_REG);
-        ins->    low = read_memory(ins->address);
-        reg_bit_x(BIT_7_MASK, ins->low);
-        cpu_log(DEBUG, "[$%04X] - %d", ins->address, is_flag_set(ZERO_FLAG));
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool bit_7_a(InstructionEntity *ins)   // 0x7F (Z 0 1 -) 2M
-{
-    reg_bit_x(BIT_7_MASK, R->A);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-// Checked
-static bool res_0_b(InstructionEntity *ins)   // 0x80 (- - - -) 2M
-{
-    R->B = (R->B & ~BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool res_0_c(InstructionEntity *ins)   // 0x81 (- - - -) 2M
-{
-    R->C = (R->C & ~BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool res_0_d(InstructionEntity *ins)   // 0x82 (- - - -) 2M
-{
-    R->D = (R->D & ~BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool res_0_e(InstructionEntity *ins)   // 0x83 (- - - -) 2M
-{
-    R->E = (R->E & ~BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool res_0_h(InstructionEntity *ins)   // 0x84 (- - - -) 2M
-{
-    R->H = (R->H & ~BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool res_0_l(InstructionEntity *ins)   // 0x85 (- - - -) 2M
-{
-    R->L = (R->L & ~BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool res_0_hl(InstructionEntity *ins)  // 0x86 (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low & (~BIT_0_MASK)); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool res_0_a(InstructionEntity *ins)   // 0x87 (- - - -) 2M
-{
-    R->A = (R->A & ~BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool res_1_b(InstructionEntity *ins)   // 0x88 (- - - -) 2M
-{
-    R->B = (R->B & ~BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool res_1_c(InstructionEntity *ins)   // 0x89 (- - - -) 2M
-{
-    R->C = (R->C & ~BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool res_1_d(InstructionEntity *ins)   // 0x8A (- - - -) 2M
-{
-    R->D = (R->D & ~BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool res_1_e(InstructionEntity *ins)   // 0x8B (- - - -) 2M
-{
-    R->E = (R->E & ~BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool res_1_h(InstructionEntity *ins)   // 0x8C (- - - -) 2M
-{
-    R->H = (R->H & ~BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool res_1_l(InstructionEntity *ins)   // 0x8D (- - - -) 2M
-{
-    R->L = (R->L & ~BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool res_1_hl(InstructionEntity *ins)  // 0x8E (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low & (~BIT_1_MASK));
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool res_1_a(InstructionEntity *ins)   // 0x8F (- - - -) 2M
-{
-    R->A = (R->A & ~BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool res_2_b(InstructionEntity *ins)   // 0x90 (- - - -) 2M
-{
-    R->B = (R->B & ~BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool res_2_c(InstructionEntity *ins)   // 0x91 (- - - -) 2M
-{
-    R->C = (R->C & ~BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool res_2_d(InstructionEntity *ins)   // 0x92 (- - - -) 2M
-{
-    R->D = (R->D & ~BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool res_2_e(InstructionEntity *ins)   // 0x93 (- - - -) 2M
-{
-    R->E = (R->E & ~BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool res_2_h(InstructionEntity *ins)   // 0x94 (- - - -) 2M
-{
-    R->H = (R->H & ~BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool res_2_l(InstructionEntity *ins)   // 0x95 (- - - -) 2M
-{
-    R->L = (R->L & ~BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool res_2_hl(InstructionEntity *ins)  // 0x96 (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low & (~BIT_2_MASK)); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool res_2_a(InstructionEntity *ins)   // 0x97 (- - - -) 2M
-{
-    R->A = (R->A & ~BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool res_3_b(InstructionEntity *ins)   // 0x98 (- - - -) 2M
-{
-    R->B = (R->B & ~BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool res_3_c(InstructionEntity *ins)   // 0x99 (- - - -) 2M
-{
-    R->C = (R->C & ~BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool res_3_d(InstructionEntity *ins)   // 0x9A (- - - -) 2M
-{
-    R->D = (R->D & ~BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool res_3_e(InstructionEntity *ins)   // 0x9B (- - - -) 2M
-{
-    R->E = (R->E & ~BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool res_3_h(InstructionEntity *ins)   // 0x9C (- - - -) 2M
-{
-    R->H = (R->H & ~BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool res_3_l(InstructionEntity *ins)   // 0x9D (- - - -) 2M
-{
-    R->L = (R->L & ~BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool res_3_hl(InstructionEntity *ins)  // 0x9E (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low & (~BIT_3_MASK)); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool res_3_a(InstructionEntity *ins)   // 0x9F (- - - -) 2M
-{
-    R->A = (R->A & ~BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool res_4_b(InstructionEntity *ins)   // 0xA0 (- - - -) 2M
-{
-    R->B = (R->B & ~BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool res_4_c(InstructionEntity *ins)   // 0xA1 (- - - -) 2M
-{
-    R->C = (R->C & ~BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool res_4_d(InstructionEntity *ins)   // 0xA2 (- - - -) 2M
-{
-    R->D = (R->D & ~BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool res_4_e(InstructionEntity *ins)   // 0xA3 (- - - -) 2M
-{
-    R->E = (R->E & ~BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool res_4_h(InstructionEntity *ins)   // 0xA4 (- - - -) 2M
-{
-    R->H = (R->H & ~BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool res_4_l(InstructionEntity *ins)   // 0xA5 (- - - -) 2M
-{
-    R->L = (R->L & ~BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool res_4_hl(InstructionEntity *ins)  // 0xA6 (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low & (~BIT_4_MASK)); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool res_4_a(InstructionEntity *ins)   // 0xA7 (- - - -) 2M
-{
-    R->A = (R->A & ~BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool res_5_b(InstructionEntity *ins)   // 0xA8 (- - - -) 2M
-{
-    R->B = (R->B & ~BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool res_5_c(InstructionEntity *ins)   // 0xA9 (- - - -) 2M
-{
-    R->C = (R->C & ~BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool res_5_d(InstructionEntity *ins)   // 0xAA (- - - -) 2M
-{
-    R->D = (R->D & ~BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool res_5_e(InstructionEntity *ins)   // 0xAB (- - - -) 2M
-{
-    R->E = (R->E & ~BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool res_5_h(InstructionEntity *ins)   // 0xAC (- - - -) 2M
-{
-    R->H = (R->H & ~BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool res_5_l(InstructionEntity *ins)   // 0xAD (- - - -) 2M
-{
-    R->L = (R->L & ~BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool res_5_hl(InstructionEntity *ins)  // 0xAE (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low & (~BIT_5_MASK)); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool res_5_a(InstructionEntity *ins)   // 0xAF (- - - -) 2M
-{
-    R->A = (R->A & ~BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool res_6_b(InstructionEntity *ins)   // 0xB0 (- - - -) 2M
-{
-    R->B = (R->B & ~BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool res_6_c(InstructionEntity *ins)   // 0xB1 (- - - -) 2M
-{
-    R->C = (R->C & ~BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool res_6_d(InstructionEntity *ins)   // 0xB2 (- - - -) 2M
-{
-    R->D = (R->D & ~BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool res_6_e(InstructionEntity *ins)   // 0xB3 (- - - -) 2M
-{
-    R->E = (R->E & ~BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool res_6_h(InstructionEntity *ins)   // 0xB4 (- - - -) 2M
-{
-    R->H = (R->H & ~BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool res_6_l(InstructionEntity *ins)   // 0xB5 (- - - -) 2M
-{
-    R->L = (R->L & ~BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool res_6_hl(InstructionEntity *ins)  // 0xB6 (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low & (~BIT_6_MASK)); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool res_6_a(InstructionEntity *ins)   // 0xB7 (- - - -) 2M
-{
-    R->A = (R->A & ~BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool res_7_b(InstructionEntity *ins)   // 0xB8 (- - - -) 2M
-{
-    R->B = (R->B & ~BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool res_7_c(InstructionEntity *ins)   // 0xB9 (- - - -) 2M
-{
-    R->C = (R->C & ~BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool res_7_d(InstructionEntity *ins)   // 0xBA (- - - -) 2M
-{
-    R->D = (R->D & ~BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool res_7_e(InstructionEntity *ins)   // 0xBB (- - - -) 2M
-{
-    R->E = (R->E & ~BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool res_7_h(InstructionEntity *ins)   // 0xBC (- - - -) 2M
-{
-    R->H = (R->H & ~BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool res_7_l(InstructionEntity *ins)   // 0xBD (- - - -) 2M
-{
-    R->L = (R->L & ~BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool res_7_hl(InstructionEntity *ins)  // 0xBE (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low & (~BIT_7_MASK)); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool res_7_a(InstructionEntity *ins)   // 0xBF (- - - -) 2M
-{
-    R->A = (R->A & ~BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-// Checked
-static bool set_0_b(InstructionEntity *ins)   // 0xC0 (- - - -) 2M
-{
-    R->B = (R->B | BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool set_0_c(InstructionEntity *ins)   // 0xC1 (- - - -) 2M
-{
-    R->C = (R->C | BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool set_0_d(InstructionEntity *ins)   // 0xC2 (- - - -) 2M
-{
-    R->D = (R->D | BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool set_0_e(InstructionEntity *ins)   // 0xC3 (- - - -) 2M
-{
-    R->E = (R->E | BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool set_0_h(InstructionEntity *ins)   // 0xC4 (- - - -) 2M
-{
-    R->H = (R->H | BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool set_0_l(InstructionEntity *ins)   // 0xC5 (- - - -) 2M
-{
-    R->L = (R->L | BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool set_0_hl(InstructionEntity *ins)  // 0xC6 (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low | BIT_0_MASK); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool set_0_a(InstructionEntity *ins)   // 0xC7 (- - - -) 2M
-{
-    R->A = (R->A | BIT_0_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool set_1_b(InstructionEntity *ins)   // 0xC8 (- - - -) 2M
-{
-    R->B = (R->B | BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool set_1_c(InstructionEntity *ins)   // 0xC9 (- - - -) 2M
-{
-    R->C = (R->C | BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool set_1_d(InstructionEntity *ins)   // 0xCA (- - - -) 2M
-{
-    R->D = (R->D | BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool set_1_e(InstructionEntity *ins)   // 0xCB (- - - -) 2M
-{
-    R->E = (R->E | BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool set_1_h(InstructionEntity *ins)   // 0xCC (- - - -) 2M
-{
-    R->H = (R->H | BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool set_1_l(InstructionEntity *ins)   // 0xCD (- - - -) 2M
-{
-    R->L = (R->L | BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool set_1_hl(InstructionEntity *ins)  // 0xCE (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low | BIT_1_MASK); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool set_1_a(InstructionEntity *ins)   // 0xCF (- - - -) 2M
-{
-    R->A = (R->A | BIT_1_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool set_2_b(InstructionEntity *ins)   // 0xD0 (- - - -) 2M
-{
-    R->B = (R->B | BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool set_2_c(InstructionEntity *ins)   // 0xD1 (- - - -) 2M
-{
-    R->C = (R->C | BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool set_2_d(InstructionEntity *ins)   // 0xD2 (- - - -) 2M
-{
-    R->D = (R->D | BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool set_2_e(InstructionEntity *ins)   // 0xD3 (- - - -) 2M
-{
-    R->E = (R->E | BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool set_2_h(InstructionEntity *ins)   // 0xD4 (- - - -) 2M
-{
-    R->H = (R->H | BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool set_2_l(InstructionEntity *ins)   // 0xD5 (- - - -) 2M
-{
-    R->L = (R->L | BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool set_2_hl(InstructionEntity *ins)  // 0xD6 (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low | BIT_2_MASK); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool set_2_a(InstructionEntity *ins)   // 0xD7 (- - - -) 2M
-{
-    R->A = (R->A | BIT_2_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool set_3_b(InstructionEntity *ins)   // 0xD8 (- - - -) 2M
-{
-    R->B = (R->B | BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool set_3_c(InstructionEntity *ins)   // 0xD9 (- - - -) 2M
-{
-    R->C = (R->C | BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool set_3_d(InstructionEntity *ins)   // 0xDA (- - - -) 2M
-{
-    R->D = (R->D | BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool set_3_e(InstructionEntity *ins)   // 0xDB (- - - -) 2M
-{
-    R->E = (R->E | BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool set_3_h(InstructionEntity *ins)   // 0xDC (- - - -) 2M
-{
-    R->H = (R->H | BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool set_3_l(InstructionEntity *ins)   // 0xDD (- - - -) 2M
-{
-    R->L = (R->L | BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool set_3_hl(InstructionEntity *ins)  // 0xDE (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low | BIT_3_MASK); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool set_3_a(InstructionEntity *ins)   // 0xDF (- - - -) 2M
-{
-    R->A = (R->A | BIT_3_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool set_4_b(InstructionEntity *ins)   // 0xE0 (- - - -) 2M
-{
-    R->B = (R->B | BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool set_4_c(InstructionEntity *ins)   // 0xE1 (- - - -) 2M
-{
-    R->C = (R->C | BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool set_4_d(InstructionEntity *ins)   // 0xE2 (- - - -) 2M
-{
-    R->D = (R->D | BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool set_4_e(InstructionEntity *ins)   // 0xE3 (- - - -) 2M
-{
-    R->E = (R->E | BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool set_4_h(InstructionEntity *ins)   // 0xE4 (- - - -) 2M
-{
-    R->H = (R->H | BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool set_4_l(InstructionEntity *ins)   // 0xE5 (- - - -) 2M
-{
-    R->L = (R->L | BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool set_4_hl(InstructionEntity *ins)  // 0xE6 (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low | BIT_4_MASK); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool set_4_a(InstructionEntity *ins)   // 0xE7 (- - - -) 2M
-{
-    R->A = (R->A | BIT_4_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool set_5_b(InstructionEntity *ins)   // 0xE8 (- - - -) 2M
-{
-    R->B = (R->B | BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool set_5_c(InstructionEntity *ins)   // 0xE9 (- - - -) 2M
-{
-    R->C = (R->C | BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool set_5_d(InstructionEntity *ins)   // 0xEA (- - - -) 2M
-{
-    R->D = (R->D | BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool set_5_e(InstructionEntity *ins)   // 0xEB (- - - -) 2M
-{
-    R->E = (R->E | BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool set_5_h(InstructionEntity *ins)   // 0xEC (- - - -) 2M
-{
-    R->H = (R->H | BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool set_5_l(InstructionEntity *ins)   // 0xED (- - - -) 2M
-{
-    R->L = (R->L | BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool set_5_hl(InstructionEntity *ins)  // 0xEE (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low | BIT_5_MASK); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool set_5_a(InstructionEntity *ins)   // 0xEF (- - - -) 2M
-{
-    R->A = (R->A | BIT_5_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool set_6_b(InstructionEntity *ins)   // 0xF0 (- - - -) 2M
-{
-    R->B = (R->B | BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool set_6_c(InstructionEntity *ins)   // 0xF1 (- - - -) 2M
-{
-    R->C = (R->C | BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
-}
-static bool set_6_d(InstructionEntity *ins)   // 0xF2 (- - - -) 2M
-{
-    R->D = (R->D | BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
-}
-static bool set_6_e(InstructionEntity *ins)   // 0xF3 (- - - -) 2M
-{
-    R->E = (R->E | BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
-}
-static bool set_6_h(InstructionEntity *ins)   // 0xF4 (- - - -) 2M
-{
-    R->H = (R->H | BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
-}
-static bool set_6_l(InstructionEntity *ins)   // 0xF5 (- - - -) 2M
-{
-    R->L = (R->L | BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
-}
-static bool set_6_hl(InstructionEntity *ins)  // 0xF6 (- - - -) 4M
-{
-    if (ins->duration == 1) // First Cycle
-    {
-        cpu_log(DEBUG, "...");
-        return false;
-    }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
-    }
-
-    if (ins->duration == 3) // Third Cycle
-    {
-        uint8_t result = (ins->low | BIT_6_MASK); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
-    }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool set_6_a(InstructionEntity *ins)   // 0xF7 (- - - -) 2M
-{
-    R->A = (R->A | BIT_6_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
-}
-static bool set_7_b(InstructionEntity *ins)   // 0xF8 (- - - -) 2M
-{
-    R->B = (R->B | BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->B);
-    return true;
-}
-static bool set_7_c(InstructionEntity *ins)   // 0xF9 (- - - -) 2M
+static uint8_t reg_rr_8(GbcMachine *gb, uint8_t r)
 {
-    R->C = (R->C | BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->C);
-    return true;
+    uint8_t carry_out = ((r & BIT_0_MASK) != 0);
+    uint8_t    result = ((get_carry(gb) << 7) | (r >> 1));
+    record_flags(gb, FLAGS_SHIFT, r, 0, result, carry_out);
+    return result;
 }
-static bool set_7_d(InstructionEntity *ins)   // 0xFA (- - - -) 2M
+// Checked
+static uint8_t reg_sla_8(GbcMachine *gb, uint8_t r)
 {
-    R->D = (R->D | BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->D);
-    return true;
+    uint8_t carry_out = ((r & BIT_7_MASK) != 0);
+    uint8_t    result = (r << 1);
+    record_flags(gb, FLAGS_SHIFT, r, 0, result, carry_out);
+    return result;
 }
-static bool set_7_e(InstructionEntity *ins)   // 0xFB (- - - -) 2M
+// Checked
+static uint8_t reg_sra_8(GbcMachine *gb, uint8_t r)
 {
-    R->E = (R->E | BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->E);
-    return true;
+    uint8_t carry_out = ((r & BIT_0_MASK) != 0);
+    uint8_t    result = ((r & BIT_7_MASK) | (r >> 1));
+    record_flags(gb, FLAGS_SHIFT, r, 0, result, carry_out);
+    return result;
 }
-static bool set_7_h(InstructionEntity *ins)   // 0xFC (- - - -) 2M
+// Checked
+static uint8_t reg_swap_8(GbcMachine *gb, uint8_t r)
 {
-    R->H = (R->H | BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->H);
-    return true;
+    uint8_t carry_out = 0;
+    uint8_t    result = ((r >> NIBBLE) | (r << NIBBLE));
+    record_flags(gb, FLAGS_SHIFT, r, 0, result, carry_out);
+    return result;
 }
-static bool set_7_l(InstructionEntity *ins)   // 0xFD (- - - -) 2M
+// Checked
+static uint8_t reg_srl_8(GbcMachine *gb, uint8_t r)
 {
-    R->L = (R->L | BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->L);
-    return true;
+    uint8_t carry_out = ((r & BIT_0_MASK) != 0);
+    uint8_t    result = (r >> 1);
+    record_flags(gb, FLAGS_SHIFT, r, 0, result, carry_out);
+    return result;
 }
-static bool set_7_hl(InstructionEntity *ins)  // 0xFE (- - - -) 4M
+// Checked
+static void reg_bit_x(GbcMachine *gb, BitMask mask, uint8_t r)
 {
-    if (ins->duration == 1) // First Cycle
+    bool is_zero = ((r & mask) == 0);
+    set_flag(gb, is_zero, ZERO_FLAG);
+    set_flag(gb, false, SUBTRACT_FLAG);
+    set_flag(gb, true, HALF_CARRY_FLAG);
+}
+// Checked
+static inline __attribute__((always_inline))
+bool cb_op(GbcMachine *gb, InstructionEntity *ins, uint8_t opcode) // 0xCB page (per op) 2M, 3M with BIT [HL], 4M with [HL]
+{ // $00-$3F are the eight shifts on bits 3-5, then BIT, RES and SET with the bit number on bits 3-5.
+    uint8_t    *reg = get_operand(gb, opcode & LOWER_3_MASK);
+    uint8_t    mask = 1 << ((opcode >> 3) & LOWER_3_MASK);
+    bool    is_bit = ((opcode & 0xC0) == 0x40); // Reads [HL] but never writes it back.
+    uint8_t  value;
+    if (reg)
     {
-        cpu_log(DEBUG, "...");
-        return false;
+        value = (*reg);
     }
-
-    if (ins->duration == 2) // Second Cycle
-    {  
-        ins->address = getDR(HL_REG);
-        ins->low = read_memory(ins->address);
-        cpu_log(DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
-        return false;
+    else
+    {
+        if (ins->duration == 1) // First Cycle
+        {
+            cpu_log(gb, DEBUG, "...");
+            return false;
+        }
+        if (ins->duration == 2) // Second Cycle
+        {
+            ins->address = getDR(gb, HL_REG);
+            ins->    low = read_memory(gb, ins->address);
+            cpu_log(gb, DEBUG, "Read $%02X from [$%04X]", ins->low, ins->address);
+            if (!is_bit) return false;
+        }
+        value = ins->low; // Third Cycle
+    }
+    switch ((opcode < 0x40) ? (opcode >> 3) : (7 + (opcode >> 6)))
+    {
+        case 0:  value = reg_rlc_8(gb, value);  break;
+        case 1:  value = reg_rrc_8(gb, value);  break;
+        case 2:  value = reg_rl_8(gb, value);   break;
+        case 3:  value = reg_rr_8(gb, value);   break;
+        case 4:  value = reg_sla_8(gb, value);  break;
+        case 5:  value = reg_sra_8(gb, value);  break;
+        case 6:  value = reg_swap_8(gb, value); break;
+        case 7:  value = reg_srl_8(gb, value);  break;
+        case 8:
+            reg_bit_x(gb, (BitMask) mask, value);
+            cpu_log(gb, DEBUG, "Bit %d - %d", (opcode >> 3) & LOWER_3_MASK, is_flag_set(gb, ZERO_FLAG));
+            return true;
+        case 9:  value = (value & ~mask);       break;
+        case 10: value = (value | mask);        break;
     }
 
-    if (ins->duration == 3) // Third Cycle
+    if (reg)
     {
-        uint8_t result = (ins->low | BIT_7_MASK); 
-        write_memory(ins->address, result);
-        cpu_log(DEBUG, "Wrote $%02X to [$%04X]", result, ins->address);
-        return true; // Instruction Complete
+        (*reg) = value;
+        cpu_log(gb, DEBUG, "Result $%02X", value);
     }
-    
-    cpu_log(ERROR, "Invalid operation, moving on.");
-    return true;
-}
-static bool set_7_a(InstructionEntity *ins)   // 0xFF (- - - -) 2M
-{
-    R->A = (R->A | BIT_7_MASK);
-    cpu_log(DEBUG, "Result $%02X", R->A);
-    return true;
+    else
+    {
+        write_memory(gb, ins->address, value);
+        cpu_log(gb, DEBUG, "Wrote $%02X to [$%04X]", value, ins->address);
+    }
+    return true; // Instruction Complete
 }
 
-const OpcodeHandler prefix_opcode_table[256] = 
-{
-    /*              ROW 1               */
-    [0x00] = rlc_b,   
-    [0x01] = rlc_c,
-    [0x02] = rlc_d,
-    [0x03] = rlc_e,
-    [0x04] = rlc_h,
-    [0x05] = rlc_l,
-    [0x06] = rlc_hl,
-    [0x07] = rlc_a,
-    [0x08] = rrc_b,
-    [0x09] = rrc_c,
-    [0x0A] = rrc_d,
-    [0x0B] = rrc_e,
-    [0x0C] = rrc_h,
-    [0x0D] = rrc_l,
-    [0x0E] = rrc_hl,
-    [0x0F] = rrc_a,
-    /*              ROW 2                */
-    [0x10] = rl_b,   
-    [0x11] = rl_c,
-    [0x12] = rl_d,
-    [0x13] = rl_e,
-    [0x14] = rl_h,
-    [0x15] = rl_l,
-    [0x16] = rl_hl,
-    [0x17] = rl_a,
-    [0x18] = rr_b,
-    [0x19] = rr_c,
-    [0x1A] = rr_d,
-    [0x1B] = rr_e,
-    [0x1C] = rr_h,
-    [0x1D] = rr_l,
-    [0x1E] = rr_hl,
-    [0x1F] = rr_a,
-    /*              ROW 3                */
-    [0x20] = sla_b,   
-    [0x21] = sla_c,
-    [0x22] = sla_d,
-    [0x23] = sla_e,
-    [0x24] = sla_h,
-    [0x25] = sla_l,
-    [0x26] = sla_hl,
-    [0x27] = sla_a,
-    [0x28] = sra_b,
-    [0x29] = sra_c,
-    [0x2A] = sra_d,
-    [0x2B] = sra_e,
-    [0x2C] = sra_h,
-    [0x2D] = sra_l,
-    [0x2E] = sra_hl,
-    [0x2F] = sra_a,
-    /*              ROW 4                */
-    [0x30] = swap_b,   
-    [0x31] = swap_c,
-    [0x32] = swap_d,
-    [0x33] = swap_e,
-    [0x34] = swap_h,
-    [0x35] = swap_l,
-    [0x36] = swap_hl,
-    [0x37] = swap_a,
-    [0x38] = srl_b,
-    [0x39] = srl_c,
-    [0x3A] = srl_d,
-    [0x3B] = srl_e,
-    [0x3C] = srl_h,
-    [0x3D] = srl_l,
-    [0x3E] = srl_hl,
-    [0x3F] = srl_a,
-    /*              ROW 5                */
-    [0x40] = bit_0_b,   
-    [0x41] = bit_0_c,
-    [0x42] = bit_0_d,
-    [0x43] = bit_0_e,
-    [0x44] = bit_0_h,
-    [0x45] = bit_0_l,
-    [0x46] = bit_0_hl,
-    [0x47] = bit_0_a,
-    [0x48] = bit_1_b,
-    [0x49] = bit_1_c,
-    [0x4A] = bit_1_d,
-    [0x4B] = bit_1_e,
-    [0x4C] = bit_1_h,
-    [0x4D] = bit_1_l,
-    [0x4E] = bit_1_hl,
-    [0x4F] = bit_1_a,
-    /*              ROW 6                */
-    [0x50] = bit_2_b,   
-    [0x51] = bit_2_c,
-    [0x52] = bit_2_d,
-    [0x53] = bit_2_e,
-    [0x54] = bit_2_h,
-    [0x55] = bit_2_l,
-    [0x56] = bit_2_hl,
-    [0x57] = bit_2_a,
-    [0x58] = bit_3_b,
-    [0x59] = bit_3_c,
-    [0x5A] = bit_3_d,
-    [0x5B] = bit_3_e,
-    [0x5C] = bit_3_h,
-    [0x5D] = bit_3_l,
-    [0x5E] = bit_3_hl,
-    [0x5F] = bit_3_a,
-    /*              ROW 7                */
-    [0x60] = bit_4_b,   
-    [0x61] = bit_4_c,
-    [0x62] = bit_4_d,
-    [0x63] = bit_4_e,
-    [0x64] = bit_4_h,
-    [0x65] = bit_4_l,
-    [0x66] = bit_4_hl,
-    [0x67] = bit_4_a,
-    [0x68] = bit_5_b,
-    [0x69] = bit_5_c,
-    [0x6A] = bit_5_d,
-    [0x6B] = bit_5_e,
-    [0x6C] = bit_5_h,
-    [0x6D] = bit_5_l,
-    [0x6E] = bit_5_hl,
-    [0x6F] = bit_5_a,
-    /*              ROW 8                */
-    [0x70] = bit_6_b,   
-    [0x71] = bit_6_c,
-    [0x72] = bit_6_d,
-    [0x73] = bit_6_e,
-    [0x74] = bit_6_h,
-    [0x75] = bit_6_l,
-    [0x76] = bit_6_hl,
-    [0x77] = bit_6_a,
-    [0x78] = bit_7_b,
-    [0x79] = bit_7_c,
-    [0x7A] = bit_7_d,
-    [0x7B] = bit_7_e,
-    [0x7C] = bit_7_h,
-    [0x7D] = bit_7_l,
-    [0x7E] = bit_7_hl,
-    [0x7F] = bit_7_a,
-    /*              ROW 9                */
-    [0x80] = res_0_b,   
-    [0x81] = res_0_c,
-    [0x82] = res_0_d,
-    [0x83] = res_0_e,
-    [0x84] = res_0_h,
-    [0x85] = res_0_l,
-    [0x86] = res_0_hl,
-    [0x87] = res_0_a,
-    [0x88] = res_1_b,
-    [0x89] = res_1_c,
-    [0x8A] = res_1_d,
-    [0x8B] = res_1_e,
-    [0x8C] = res_1_h,
-    [0x8D] = res_1_l,
-    [0x8E] = res_1_hl,
-    [0x8F] = res_1_a,
-    /*              ROW 10                */
-    [0x90] = res_2_b,   
-    [0x91] = res_2_c,
-    [0x92] = res_2_d,
-    [0x93] = res_2_e,
-    [0x94] = res_2_h,
-    [0x95] = res_2_l,
-    [0x96] = res_2_hl,
-    [0x97] = res_2_a,
-    [0x98] = res_3_b,
-    [0x99] = res_3_c,
-    [0x9A] = res_3_d,
-    [0x9B] = res_3_e,
-    [0x9C] = res_3_h,
-    [0x9D] = res_3_l,
-    [0x9E] = res_3_hl,
-    [0x9F] = res_3_a,
-    /*              ROW 11                */
-    [0xA0] = res_4_b,   
-    [0xA1] = res_4_c,
-    [0xA2] = res_4_d,
-    [0xA3] = res_4_e,
-    [0xA4] = res_4_h,
-    [0xA5] = res_4_l,
-    [0xA6] = res_4_hl,
-    [0xA7] = res_4_a,
-    [0xA8] = res_5_b,
-    [0xA9] = res_5_c,
-    [0xAA] = res_5_d,
-    [0xAB] = res_5_e,
-    [0xAC] = res_5_h,
-    [0xAD] = res_5_l,
-    [0xAE] = res_5_hl,
-    [0xAF] = res_5_a,
-    /*              ROW 12                */
-    [0xB0] = res_6_b,   
-    [0xB1] = res_6_c,
-    [0xB2] = res_6_d,
-    [0xB3] = res_6_e,
-    [0xB4] = res_6_h,
-    [0xB5] = res_6_l,
-    [0xB6] = res_6_hl,
-    [0xB7] = res_6_a,
-    [0xB8] = res_7_b,
-    [0xB9] = res_7_c,
-    [0xBA] = res_7_d,
-    [0xBB] = res_7_e,
-    [0xBC] = res_7_h,
-    [0xBD] = res_7_l,
-    [0xBE] = res_7_hl,
-    [0xBF] = res_7_a,
-    /*              ROW 13                */
-    [0xC0] = set_0_b,   
-    [0xC1] = set_0_c,
-    [0xC2] = set_0_d,
-    [0xC3] = set_0_e,
-    [0xC4] = set_0_h,
-    [0xC5] = set_0_l,
-    [0xC6] = set_0_hl,
-    [0xC7] = set_0_a,
-    [0xC8] = set_1_b,
-    [0xC9] = set_1_c,
-    [0xCA] = set_1_d,
-    [0xCB] = set_1_e,
-    [0xCC] = set_1_h,
-    [0xCD] = set_1_l,
-    [0xCE] = set_1_hl,
-    [0xCF] = set_1_a,
-    /*              ROW 14                */
-    [0xD0] = set_2_b,   
-    [0xD1] = set_2_c,
-    [0xD2] = set_2_d,
-    [0xD3] = set_2_e,
-    [0xD4] = set_2_h,
-    [0xD5] = set_2_l,
-    [0xD6] = set_2_hl,
-    [0xD7] = set_2_a,
-    [0xD8] = set_3_b,
-    [0xD9] = set_3_c,
-    [0xDA] = set_3_d,
-    [0xDB] = set_3_e,
-    [0xDC] = set_3_h,
-    [0xDD] = set_3_l,
-    [0xDE] = set_3_hl,
-    [0xDF] = set_3_a,
-    /*              ROW 15                */
-    [0xE0] = set_4_b,   
-    [0xE1] = set_4_c,
-    [0xE2] = set_4_d,
-    [0xE3] = set_4_e,
-    [0xE4] = set_4_h,
-    [0xE5] = set_4_l,
-    [0xE6] = set_4_hl,
-    [0xE7] = set_4_a,
-    [0xE8] = set_5_b,
-    [0xE9] = set_5_c,
-    [0xEA] = set_5_d,
-    [0xEB] = set_5_e,
-    [0xEC] = set_5_h,
-    [0xED] = set_5_l,
-    [0xEE] = set_5_hl,
-    [0xEF] = set_5_a,
-    /*              ROW 16                */
-    [0xF0] = set_6_b,   
-    [0xF1] = set_6_c,
-    [0xF2] = set_6_d,
-    [0xF3] = set_6_e,
-    [0xF4] = set_6_h,
-    [0xF5] = set_6_l,
-    [0xF6] = set_6_hl,
-    [0xF7] = set_6_a,
-    [0xF8] = set_7_b,
-    [0xF9] = set_7_c,
-    [0xFA] = set_7_d,
-    [0xFB] = set_7_e,
-    [0xFC] = set_7_h,
-    [0xFD] = set_7_l,
-    [0xFE] = set_7_hl,
-    [0xFF] = set_7_a,
-};
+CB_OPCODES(CB_OP_HANDLER)
+
+const OpcodeHandler prefix_opcode_table[256] = { CB_OPCODES(CB_OP_ENTRY) };
 
-static void reset_ins(InstructionEntity *ins)
+static void reset_ins(GbcMachine *gb, InstructionEntity *ins)
 {
-    ins-> address = R->PC;
+    ins-> address = gb->R->PC;
     ins->duration =     0;
     ins->  length =     1;
     ins->     low =     0;
@@ -5930,36 +2746,38 @@ static void reset_ins(InstructionEntity *ins)
     ins->   label = "N/A";
     ins->executed = false;
     ins-> handler =   nop;
+    ins->operands_left = 0;
 }
 
 /* INTERRUPT HANDLING */
 
-static void check_ime(InterruptEnableEvent *iee)
+static void check_ime(GbcMachine *gb)
 {
+    InterruptEnableEvent *iee = gb->iee;
     if (iee->active)
     { // Interrupt Enable Check
         if (--iee->delay <= 0)
         {
-            cpu->   ime = true;
+            gb->cpu->   ime = true;
             iee->active = false;
-            cpu_log(DEBUG, "IME Enabled");
+            cpu_log(gb, DEBUG, "IME Enabled");
         }
     }
 }
 
-void request_interrupt(InterruptCode interrupt)
+void request_interrupt(GbcMachine *gb, InterruptCode interrupt)
 {
-    write_ifr(*R->IFR | interrupt);
-    cpu_log(DEBUG, "Requesting Interrupt %02X", interrupt);
+    write_ifr(gb, *gb->R->IFR | interrupt);
+    cpu_log(gb, DEBUG, "Requesting Interrupt %02X", interrupt);
 }
 
-static bool service_interrupts(InstructionEntity *ins)
+static bool service_interrupts(GbcMachine *gb, InstructionEntity *ins)
 {
-    uint8_t pending = get_pending_interrupts();
-    if ((!cpu->ime) || (pending == 0)) return false;
+    uint8_t pending = get_pending_interrupts(gb);
+    if ((!gb->cpu->ime) || (pending == 0)) return false;
 
-    cpu->ime = false;
-    reset_ins(ins); // Normalize
+    gb->cpu->ime = false;
+    reset_ins(gb, ins); // Normalize
     ins->handler = int_exec;
 
     if (pending & VBLANK_INTERRUPT_CODE)
@@ -5998,125 +2816,851 @@ static bool service_interrupts(InstructionEntity *ins)
         return true;
     }
 
-    cpu_log(ERROR, "Failed To Service Interrupt");
+    cpu_log(gb, ERROR, "Failed To Service Interrupt");
     return false;
 }
 
+/* BLOCK CACHE */
+
+#define CODE_CACHE_SIZE   512 // Blocks, direct mapped on (bank, address).
+#define BLOCK_MAX          16 // Instructions per block.
+#define CODE_LINE_SHIFT     4 // RAM invalidation granularity, 16 bytes.
+#define WRAM_CODE_LINES   ((8 * 0x1000) >> CODE_LINE_SHIFT)
+#define HRAM_CODE_LINES   (0x80 >> CODE_LINE_SHIFT)
+#define NO_BLOCK          0xFFFFFFFF
+#define JIT_THRESHOLD      32 // Block entries before JIT_EXECUTION translates it.
+#define JIT_ARENA_SIZE    (1 << 20)
+
+static const uint8_t opcode_length[256] = // Bytes, opcode included. 0 = never cached ($D3 fetches its own operands).
+{
+    1, 3, 1, 1, 1, 1, 2, 1, 3, 1, 1, 1, 1, 1, 2, 1, // 0x00
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1, // 0x10
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1, // 0x20
+    2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1, // 0x30
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x40
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x50
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x60
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x70
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x80
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x90
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0xA0
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0xB0
+    1, 1, 3, 3, 3, 1, 2, 1, 1, 1, 3, 1, 3, 3, 2, 1, // 0xC0
+    1, 1, 3, 0, 3, 1, 2, 1, 1, 1, 3, 1, 3, 1, 2, 1, // 0xD0
+    2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 3, 1, 1, 1, 2, 1, // 0xE0
+    2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 3, 1, 1, 1, 2, 1  // 0xF0
+};
+
+static const uint8_t opcode_cycles[256] = // M-cycles with conditional branches not taken.
+{
+    1, 3, 2, 2, 1, 1, 2, 1, 5, 2, 2, 2, 1, 1, 2, 1, // 0x00
+    1, 3, 2, 2, 1, 1, 2, 1, 3, 2, 2, 2, 1, 1, 2, 1, // 0x10
+    2, 3, 2, 2, 1, 1, 2, 1, 2, 2, 2, 2, 1, 1, 2, 1, // 0x20
+    2, 3, 2, 2, 3, 3, 3, 1, 2, 2, 2, 2, 1, 1, 2, 1, // 0x30
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, // 0x40
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, // 0x50
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, // 0x60
+    2, 2, 2, 2, 2, 2, 1, 2, 1, 1, 1, 1, 1, 1, 2, 1, // 0x70
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, // 0x80
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, // 0x90
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, // 0xA0
+    1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, // 0xB0
+    2, 3, 3, 4, 3, 4, 2, 4, 2, 4, 3, 1, 3, 6, 2, 4, // 0xC0
+    2, 3, 3, 1, 3, 4, 2, 4, 2, 4, 3, 1, 3, 1, 2, 4, // 0xD0
+    3, 3, 2, 1, 1, 4, 2, 4, 4, 1, 4, 1, 1, 1, 2, 4, // 0xE0
+    3, 3, 2, 1, 1, 4, 2, 4, 3, 2, 4, 1, 1, 1, 2, 4  // 0xF0
+};
+
+typedef struct DecodedIns
+{
+    OpcodeHandler handler;
+    uint16_t      address;
+    uint8_t        opcode;
+    uint8_t        length;
+    uint8_t    operand[2];
+    bool         prefixed; // Sub-opcode of a $CB, looked up in prefix_opcode_table.
+
+} DecodedIns;
+
+typedef struct CodeBlock
+{
+    uint32_t          key; // (bank << 16) | address, NO_BLOCK when empty.
+    uint16_t          end; // One past the last decoded byte.
+    uint8_t         count; // 0 = the first instruction cannot be cached, take the bus.
+    uint8_t        cycles;
+    DecodedIns ins[BLOCK_MAX];
+    uint16_t          heat; // Entries so far, saturating at JIT_THRESHOLD.
+    uint32_t    generation; // Arena generation native belongs to, 0 = never translated.
+    NativeBlock     native; // NULL when the front of the block is not register-only.
+    uint8_t   native_count; // Instructions native covers, from ins[0].
+    uint8_t  native_cycles;
+    bool              idle; // Branches back to its own start and only touches registers and polls.
+    uint8_t          polls; // PolledRegister bits read by an idle block.
+
+} CodeBlock;
+
+typedef struct IdleLoop // Last entry into an idle block, compared with the next one.
+{
+    CodeBlock   *block; // NULL once anything else runs.
+    Register     state;
+    LazyFlags    flags;
+    uint8_t  polled[4]; // LY, STAT, DIV, TIMA
+    uint64_t     entry; // Dot of the entry, owed cycles included.
+    uint32_t    period; // Dots between the last two entries, 0 until they matched.
+    bool     confirmed; // Two identical periods from identical states: it will repeat until a poll changes.
+
+} IdleLoop;
+
+typedef struct CodeCache
+{
+    CodeBlock  blocks[CODE_CACHE_SIZE];
+    CodeBlock          *block; // Block being executed, NULL after anything remaps the bus.
+    uint8_t             index; // Next instruction in it.
+    uint8_t         ram_lines[(WRAM_CODE_LINES + HRAM_CODE_LINES) / 8]; // RAM lines holding cached code.
+    CodeCacheStats      stats;
+    JitArena             *jit; // Created on the first translation.
+    IdleLoop             idle;
+
+} CodeCache;
+
+static uint32_t get_block_slot(uint32_t key)
+{
+    return (key * 0x9E3779B1) >> 23; // Fibonacci hash, top 9 bits.
+}
+
+static bool ends_block(uint8_t opcode)
+{
+    switch (opcode)
+    {
+        case 0x10: case 0x76:                                                 // STOP, HALT
+        case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:                // JR
+        case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: case 0xE9:     // JP
+        case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC:                // CALL
+        case 0xC0: case 0xC8: case 0xC9: case 0xD0: case 0xD8: case 0xD9:     // RET, RETI
+        case 0xC7: case 0xCF: case 0xD7: case 0xDF:                           // RST
+        case 0xE7: case 0xEF: case 0xF7: case 0xFF:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static uint8_t get_prefix_cycles(uint8_t opcode) // After the $CB itself.
+{
+    if ((opcode & LOWER_3_MASK) != 0x06) return 1;
+    return ((opcode & 0xC0) == 0x40) ? 2 : 3; // BIT n, [HL] skips the write back.
+}
+
+static bool get_code_bank(GbcMachine *gb, uint16_t address, uint16_t *bank, uint32_t *limit)
+{
+    if ((*gb->bios) == 0) return false; // BIOS overlay, runs once.
+
+    if (address <= BANK_ZERO_ADDRESS_END)
+    {
+        (*bank) = 0; (*limit) = BANK_N_ADDRESS_START;
+    }
+    else if (address <= BANK_N_ADDRESS_END)
+    {
+        (*bank) = get_rom_bank(gb); (*limit) = VRAM_ADDRESS_START;
+    }
+    else if ((address >= WRAM_ZERO_ADDRESS_START) && (address <= WRAM_ZERO_ADDRESS_END))
+    {
+        (*bank) = 0; (*limit) = WRAM_N_ADDRESS_START;
+    }
+    else if ((address >= WRAM_N_ADDRESS_START) && (address <= WRAM_N_ADDRESS_END))
+    {
+        uint8_t svbk = get_memory(gb)[SVBK] & LOWER_3_MASK;
+        (*bank) = svbk ? svbk : 1; (*limit) = ECHO_RAM_ADDRESS_START;
+    }
+    else if ((address >= HIGH_RAM_ADDRESS_START) && (address <= HIGH_RAM_ADDRESS_END))
+    {
+        (*bank) = 0; (*limit) = INTERRUPT_ENABLE_ADDRESS;
+    }
+    else
+    {
+        return false; // VRAM, cartridge RAM, echo RAM, OAM and IO always take the bus.
+    }
+    return true;
+}
+
+static uint16_t get_code_line(uint16_t address, uint16_t bank)
+{
+    if (address >= HIGH_RAM_ADDRESS_START)
+    {
+        return WRAM_CODE_LINES + ((address - HIGH_RAM_ADDRESS_START) >> CODE_LINE_SHIFT);
+    }
+    uint32_t offset = (address <= WRAM_ZERO_ADDRESS_END) ?
+                      (uint32_t) (address - WRAM_ZERO_ADDRESS_START) :
+                      (uint32_t) ((bank * 0x1000) + (address - WRAM_N_ADDRESS_START));
+    return (uint16_t) (offset >> CODE_LINE_SHIFT);
+}
+
+static void mark_code_lines(GbcMachine *gb, CodeBlock *block)
+{
+    uint16_t start = block->key & MAX_INT_16;
+    uint16_t  bank = block->key >> 16;
+    if (start < WRAM_ZERO_ADDRESS_START) return; // ROM never changes under us.
+
+    uint16_t first = get_code_line(start, bank);
+    uint16_t  last = get_code_line(block->end - 1, bank);
+    for (uint16_t line = first; line <= last; line++)
+    {
+        gb->code->ram_lines[line >> 3] |= (1 << (line & LOWER_3_MASK));
+    }
+    if (gb->code_in_ram) return;
+    gb->code_in_ram = true;
+    remap_memory(gb); // WRAM writes have to go through invalidate_code() now.
+}
+
+/* IDLE LOOPS */
+
+static const uint16_t polled_address[4] = { LY, STAT, DIV, TIMA }; // Registers only the clock changes.
+
+static uint8_t get_poll(uint16_t address)
+{
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        if (polled_address[i] == address) return (1 << i);
+    }
+    return 0;
+}
+
+static bool is_idle_ins(const DecodedIns *decoded, uint8_t *polls)
+{
+    uint8_t opcode = decoded->opcode;
+    if (decoded->prefixed) return (opcode & LOWER_3_MASK) != 0x06; // Registers only, [HL] reads the bus.
+    if ((opcode >= 0x40) && (opcode <= 0xBF))
+    { // LD r, r and ALU A, r
+        bool memory = ((opcode & LOWER_3_MASK) == 0x06) || ((opcode >= 0x70) && (opcode <= 0x77));
+        return !memory;
+    }
+    switch (opcode)
+    {
+        case 0x00: case 0x07: case 0x0F: case 0x17: case 0x1F:                // NOP, RLCA, RRCA, RLA, RRA
+        case 0x27: case 0x2F: case 0x37: case 0x3F: case 0xCB:                // DAA, CPL, SCF, CCF, PREFIX
+        case 0x03: case 0x0B: case 0x13: case 0x1B: case 0x23: case 0x2B:     // INC/DEC rr
+        case 0x04: case 0x0C: case 0x14: case 0x1C: case 0x24: case 0x2C:     // INC r
+        case 0x05: case 0x0D: case 0x15: case 0x1D: case 0x25: case 0x2D:     // DEC r
+        case 0x3C: case 0x3D:
+        case 0x06: case 0x0E: case 0x16: case 0x1E: case 0x26: case 0x2E:     // LD r, n
+        case 0x3E:
+        case 0xC6: case 0xCE: case 0xD6: case 0xDE: case 0xE6: case 0xEE:     // ALU A, n
+        case 0xF6: case 0xFE:
+            return true;
+        case 0xF0: // LDH A, [n]
+            (*polls) |= get_poll(0xFF00 | decoded->operand[0]);
+            return get_poll(0xFF00 | decoded->operand[0]) != 0;
+        case 0xFA: // LD A, [nn]
+            (*polls) |= get_poll((decoded->operand[1] << BYTE) | decoded->operand[0]);
+            return get_poll((decoded->operand[1] << BYTE) | decoded->operand[0]) != 0;
+        default:
+            return false;
+    }
+}
+
+static uint16_t get_branch_target(const DecodedIns *decoded)
+{
+    uint16_t next = decoded->address + decoded->length;
+    switch (decoded->opcode)
+    {
+        case 0x18: case 0x20: case 0x28: case 0x30: case 0x38: // JR
+            return next + (int8_t) decoded->operand[0];
+        case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: // JP
+            return (decoded->operand[1] << BYTE) | decoded->operand[0];
+        default:
+            return next; // Never the start of its own block.
+    }
+}
+
+static void check_idle_block(CodeBlock *block) // A loop that only waits on the clock: LDH A, [LY]; CP n; JR NZ.
+{
+    block->idle  = false;
+    block->polls = 0;
+    if (block->count == 0) return;
+
+    const DecodedIns *branch = &block->ins[block->count - 1];
+    if (branch->prefixed || (get_branch_target(branch) != (block->key & MAX_INT_16))) return;
+    for (uint8_t i = 0; i < (block->count - 1); i++)
+    {
+        if (!is_idle_ins(&block->ins[i], &block->polls)) return;
+    }
+    block->idle = true;
+}
+
+static uint64_t get_cpu_clock(GbcMachine *gb) // Dots, counting the ones FAST_EXECUTION still owes.
+{
+    return gb->clock + (gb->owed_cycles * get_machine_cycle_scaler(gb));
+}
+
+static void enter_idle_block(GbcMachine *gb, CodeBlock *block)
+{
+    IdleLoop *idle = &gb->code->idle;
+    uint8_t *memory = get_memory(gb);
+    uint64_t    now = get_cpu_clock(gb);
+    if (block->polls & (POLL_LY | POLL_STAT)) sync_ppu(gb);
+
+    bool same = (idle->block == block) &&
+                (memcmp(&idle->state, gb->R, offsetof(Register, IER)) == 0) &&
+                (memcmp(&idle->flags, gb->flags, sizeof(LazyFlags)) == 0);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        if ((block->polls & (1 << i)) && (idle->polled[i] != memory[polled_address[i]])) same = false;
+        idle->polled[i] = memory[polled_address[i]];
+    }
+    uint32_t period = (uint32_t) (now - idle->entry);
+    idle->confirmed = same && (period == idle->period);
+    idle->   period = same ? period : 0;
+    idle->    entry = now;
+    idle->    block = block;
+    idle->    state = (*gb->R);
+    idle->    flags = (*gb->flags);
+}
+
+static void leave_idle_loop(GbcMachine *gb)
+{
+    gb->code->idle.block     = NULL;
+    gb->code->idle.confirmed = false;
+}
+
+static void decode_block(GbcMachine *gb, CodeBlock *block, uint32_t key, uint32_t limit)
+{
+    uint32_t address = key & MAX_INT_16;
+    bool    prefixed = gb->cb_prefixed;
+    block->       key = key;
+    block->     count = 0;
+    block->    cycles = 0;
+    block->      heat = 0;
+    block->generation = 0;
+    block->    native = NULL;
+
+    while (block->count < BLOCK_MAX)
+    {
+        uint8_t opcode = read_memory(gb, (uint16_t) address);
+        uint8_t length = prefixed ? 1 : opcode_length[opcode];
+        if ((length == 0) || ((address + length) > limit)) break;
+
+        DecodedIns *decoded = &block->ins[block->count++];
+        decoded-> handler = prefixed ? prefix_opcode_table[opcode] : opcode_table[opcode];
+        decoded-> address = (uint16_t) address;
+        decoded->  opcode = opcode;
+        decoded->  length = length;
+        decoded->prefixed = prefixed;
+        for (uint8_t i = 1; i < length; i++)
+        {
+            decoded->operand[i - 1] = read_memory(gb, (uint16_t) (address + i));
+        }
+        block->cycles += prefixed ? get_prefix_cycles(opcode) : opcode_cycles[opcode];
+        address       += length;
+
+        if (!prefixed && ends_block(opcode)) break;
+        prefixed = (!prefixed && (opcode == 0xCB));
+    }
+    block->end = (uint16_t) address;
+    if (block->count) mark_code_lines(gb, block);
+    check_idle_block(block);
+    gb->code->stats.decodes += 1;
+}
+
+static const DecodedIns *next_decoded(GbcMachine *gb)
+{
+    CodeCache *code = gb->code;
+    CodeBlock *block = code->block;
+    uint16_t      pc = gb->R->PC;
+    if (block && (code->index < block->count) && (block->ins[code->index].address == pc))
+    { // Straight-line code, the common case.
+        code->stats.hits += 1;
+        return &block->ins[code->index++];
+    }
+
+    uint16_t bank;
+    uint32_t limit;
+    code->block = NULL;
+    bool dma_bound = dma_active(gb) && (pc < HIGH_RAM_ADDRESS_START); // Fetches may lose the bus to OAM DMA.
+    if (gb->cpu->halt_bug_active || dma_bound || !get_code_bank(gb, pc, &bank, &limit))
+    {
+        leave_idle_loop(gb);
+        return NULL;
+    }
+
+    uint32_t key = ((uint32_t) bank << 16) | pc;
+    block = &code->blocks[get_block_slot(key)];
+    if (block->key == key) code->stats.hits += 1;
+    else decode_block(gb, block, key, limit);
+
+    if ((block->count == 0) || (block->ins[0].prefixed != gb->cb_prefixed))
+    {
+        leave_idle_loop(gb);
+        return NULL;
+    }
+    code->block = block;
+    code->index = 1;
+    if (block->idle) enter_idle_block(gb, block);
+    else leave_idle_loop(gb);
+    return &block->ins[0];
+}
+
+static void compile_block(GbcMachine *gb, CodeBlock *block)
+{
+    CodeCache *code = gb->code;
+    if (code->jit == NULL) code->jit = init_jit(JIT_ARENA_SIZE);
+    if (code->jit == NULL)
+    {
+        gb->exec_mode = FAST_EXECUTION; // Same semantics, minus the native runs.
+        return;
+    }
+
+    uint8_t bytes[BLOCK_MAX * 3];
+    size_t   size = 0;
+    for (uint8_t i = 0; (i < block->count) && !block->ins[i].prefixed; i++)
+    {
+        const DecodedIns *decoded = &block->ins[i];
+        bytes[size++] = decoded->opcode;
+        for (uint8_t j = 1; j < decoded->length; j++) bytes[size++] = decoded->operand[j - 1];
+    }
+    uint8_t length;
+    block->    native = compile_native(code->jit, bytes, size, &block->native_count, &length, &block->native_cycles);
+    block->generation = get_jit_generation(code->jit); // Read after, translating may have recycled the arena.
+}
+
+static const DecodedIns *run_native(GbcMachine *gb, CodeBlock *block)
+{ // Entered at ins[0]. Runs the translated front of the block and hands back the first instruction after it.
+    CodeCache *code = gb->code;
+    if (gb->iee->active) return &block->ins[0]; // EI counts instructions one at a time.
+    if (block->heat < JIT_THRESHOLD)
+    {
+        block->heat += 1;
+        return &block->ins[0];
+    }
+    if ((code->jit == NULL) || (block->generation != get_jit_generation(code->jit))) compile_block(gb, block);
+    if (block->native == NULL) return &block->ins[0];
+
+    settle_flags(gb); // Native code keeps F in a host register.
+    block->native(gb->R);
+    const DecodedIns *last = &block->ins[block->native_count - 1];
+    gb->R->PC          = last->address + last->length;
+    gb->owed_cycles   += block->native_cycles; // Paid on the next bus access, like any FAST_EXECUTION cycle.
+    code->stats.native += block->native_count;
+    code->index        = block->native_count;
+    reset_ins(gb, gb->ins);
+    return next_decoded(gb);
+}
+
+static void flush_code(GbcMachine *gb)
+{
+    CodeCache *code = gb->code;
+    for (uint32_t i = 0; i < CODE_CACHE_SIZE; i++) code->blocks[i].key = NO_BLOCK;
+    memset(code->ram_lines, 0, sizeof(code->ram_lines));
+    code->block     = NULL;
+    code->index     = 0;
+    gb->code_in_ram = false;
+    remap_memory(gb);
+    leave_idle_loop(gb);
+}
+
+void invalidate_code(GbcMachine *gb, uint16_t address, uint8_t bank)
+{
+    CodeCache *code = gb->code;
+    uint16_t   line = get_code_line(address, bank);
+    uint8_t     bit = (1 << (line & LOWER_3_MASK));
+    if (!(code->ram_lines[line >> 3] & bit)) return;
+
+    code->ram_lines[line >> 3] &= ~bit;
+    for (uint32_t i = 0; i < CODE_CACHE_SIZE; i++)
+    {
+        CodeBlock *block = &code->blocks[i];
+        uint16_t   start = block->key & MAX_INT_16;
+        if ((block->key == NO_BLOCK) || (start < WRAM_ZERO_ADDRESS_START)) continue;
+
+        uint16_t first = get_code_line(start, block->key >> 16);
+        uint16_t  last = get_code_line(block->end - 1, block->key >> 16);
+        if ((line >= first) && (line <= last)) block->key = NO_BLOCK;
+    }
+    code->block = NULL; // Might have been one of them.
+    code->stats.invalidations += 1;
+}
+
+void reset_code_cursor(GbcMachine *gb)
+{
+    gb->code->block = NULL;
+    leave_idle_loop(gb);
+}
+
+uint32_t get_idle_period(GbcMachine *gb, uint8_t *polls)
+{
+    IdleLoop *idle = &gb->code->idle;
+    if (!idle->confirmed || gb->owed_cycles || gb->iee->active) return 0;
+    if (gb->ins->handler == int_exec) return 0; // Dispatching, the vector's block has not been entered yet.
+    if (gb->cpu->ime && (*gb->R->IFR & *gb->R->IER & LOWER_5_MASK)) return 0; // Taken on the next boundary.
+
+    uint8_t *memory = get_memory(gb);
+    if (idle->block->polls & (POLL_LY | POLL_STAT)) catch_up_ppu(gb); // Between slots, the current dot is not ours.
+    for (uint8_t i = 0; i < 4; i++)
+    { // Whatever the loop read last time around has to still be there.
+        if ((idle->block->polls & (1 << i)) && (idle->polled[i] != memory[polled_address[i]])) return 0;
+    }
+    (*polls) = idle->block->polls;
+    return idle->period;
+}
+
+CodeCacheStats get_code_cache_stats(GbcMachine *gb)
+{
+    return gb->code->stats;
+}
+
 /* INSTRUCTION EXECUTION */
 
-static void check_pending_interrupts()
+static void check_pending_interrupts(GbcMachine *gb)
 {
-    if (cpu->halted) // Need to unhalt if interrupt pending.
+    if (gb->cpu->halted) // Need to unhalt if interrupt pending.
     {
-        uint8_t pending = get_pending_interrupts();
-        cpu->halted = (pending == 0); // No reason to unhalt.
+        uint8_t pending = get_pending_interrupts(gb);
+        gb->cpu->halted = (pending == 0); // No reason to unhalt.
     }
 }
 
-static void next_ins(InstructionEntity *ins)
+static void next_ins(GbcMachine *gb, InstructionEntity *ins)
 {
-    reset_ins(ins);
-    ins-> opcode = fetch();
-    if (cb_prefixed)
+    reset_ins(gb, ins);
+    const DecodedIns *decoded = next_decoded(gb);
+    if (decoded && (gb->exec_mode == JIT_EXECUTION) && (decoded == &gb->code->block->ins[0]))
+    {
+        decoded = run_native(gb, gb->code->block);
+    }
+    if (decoded)
+    { // Already decoded, skip the bus.
+        gb->R->PC         += 1;
+        ins->       opcode = decoded->opcode;
+        ins->      handler = decoded->handler;
+        ins->        label = decoded->prefixed ? cb_opcode_word[decoded->opcode] : opcode_word[decoded->opcode];
+        ins->     operands = decoded->operand;
+        ins->operands_left = decoded->length - 1;
+        gb->cb_prefixed    = false;
+        return;
+    }
+    ins-> opcode = fetch(gb);
+    if (gb->cb_prefixed)
     {
         ins->   label = cb_opcode_word[ins->opcode];
         ins-> handler = prefix_opcode_table[ins->opcode];
-        cb_prefixed   = false;
+        gb->cb_prefixed   = false;
         return;
     }
     ins->  label = opcode_word[ins->opcode];
     ins->handler = opcode_table[ins->opcode];
 }
 
-static void execute_ins(InstructionEntity *ins)
+static void execute_ins(GbcMachine *gb, InstructionEntity *ins)
 {
     ins->duration += 1; // Steps through micro-instructions
-    bool complete = ins->handler(ins);
+    bool complete = ins->handler(gb, ins);
     if (complete)
     {
-        check_ime(iee);
-        if (!cb_prefixed)
+        check_ime(gb);
+        if (!gb->cb_prefixed)
         {
-            bool serviced = service_interrupts(ins); 
+            bool serviced = service_interrupts(gb, ins); 
             if (serviced) return;
         }
-        next_ins(ins);
+        next_ins(gb, ins);
+    }
+}
+
+static bool chain_fast_ins(GbcMachine *gb) // Would run_slots() start the instruction next_ins() set up on the very next slot?
+{
+    if (gb->owed_cycles)
+    {
+        if (gb->exec_mode != FAST_EXECUTION) return false; // A native run, paid on the next slot as before.
+        sync_machine_cycles(gb); // Left by a $CB prefix, nothing reads the bus in between.
+    }
+    CPU *cpu = gb->cpu;
+    if (!cpu->running || cpu->halted || cpu->stalled || gb->code->idle.confirmed) return false;
+    if ((gb->clock + (2 * get_machine_cycle_scaler(gb))) >= gb->slot_horizon) return false; // Frame wrap or run limit.
+
+    gb->owed_cycles = 1; // Its first M-cycle, the slot run_slots() would have handed it.
+    return true;
+}
+
+static bool finish_fast_ins(GbcMachine *gb, InstructionEntity *ins) // True when the next instruction runs in this call too.
+{
+    check_ime(gb);
+    if (!gb->cb_prefixed)
+    {
+        bool serviced = service_interrupts(gb, ins); // Always syncs, IF is read here.
+        if (serviced) return false;
+    }
+    next_ins(gb, ins);
+    return chain_fast_ins(gb);
+}
+
+// Threaded dispatch: every body below ends in its own jump to the next instruction's label.
+#define FAST_MAIN_LABEL(op)   [op] = &&main_##op,
+#define FAST_PREFIX_LABEL(op) [op] = &&prefix_##op,
+#define FAST_NEXT() \
+    if (!finish_fast_ins(gb, ins)) return; \
+    goto *((ins->handler == opcode_table[ins->opcode]) ? main_label : prefix_label)[ins->opcode]
+#define FAST_BODY(step) \
+    while (ins->duration += 1, !(step)) gb->owed_cycles += 1; \
+    FAST_NEXT();
+#define FAST_LD_R_R(op)  main_##op:   FAST_BODY(ld_r_r(gb, ins, op))
+#define FAST_ALU_A_R(op) main_##op:   FAST_BODY(alu_a_r(gb, ins, op))
+#define FAST_CB_OP(op)   prefix_##op: FAST_BODY(cb_op(gb, ins, op))
+
+static void execute_ins_fast(GbcMachine *gb, InstructionEntity *ins)
+{ // Same micro-instructions back to back. Each one owes the clock an M-cycle, paid on its next bus access.
+    static void *const main_label[256] =
+    {
+        [0x00 ... 0xFF] = &&generic, LD_R_R_OPCODES(FAST_MAIN_LABEL) ALU_A_R_OPCODES(FAST_MAIN_LABEL) [0xCB] = &&main_0xCB
+    };
+    static void *const prefix_label[256] = { CB_OPCODES(FAST_PREFIX_LABEL) };
+
+    if (ins->handler == opcode_table[ins->opcode])        goto *main_label[ins->opcode];
+    if (ins->handler == prefix_opcode_table[ins->opcode]) goto *prefix_label[ins->opcode];
+
+generic: // Everything else, interrupt dispatch included, through its handler.
+    while (true)
+    {
+        ins->duration += 1;
+        bool complete = ins->handler(gb, ins);
+        if (complete) break;
+        if (ins->duration >= MAX_INS_DURATION)
+        {
+            cpu_log(gb, ERROR, "Handler never completed, moving on.");
+            break;
+        }
+        gb->owed_cycles += 1;
     }
+    FAST_NEXT();
+
+main_0xCB: FAST_BODY(cb_prefix(gb, ins))
+    LD_R_R_OPCODES(FAST_LD_R_R)
+    ALU_A_R_OPCODES(FAST_ALU_A_R)
+    CB_OPCODES(FAST_CB_OP)
 }
 
-void machine_cycle()
+void machine_cycle(GbcMachine *gb)
 {
-    check_pending_interrupts(); // Unhalts If Interrupt Pending
+    check_pending_interrupts(gb); // Unhalts If Interrupt Pending
     
-    if (!cpu->running) return;
-    if   (cpu->halted) return;
+    if (!gb->cpu->running) return;
+    if   (gb->cpu->halted) return;
+    if  (gb->cpu->stalled)
+    {
+        gb->cpu->stalled -= 1;
+        return;
+    }
 
-    execute_ins(ins); // Continue Execution. 
+    if (gb->exec_mode != ACCURATE_EXECUTION)
+    {
+        execute_ins_fast(gb, gb->ins);
+        return;
+    }
+    execute_ins(gb, gb->ins); // Continue Execution. 
 }
 
 /* OTHER PUBLIC METHODS */
 
-uint8_t get_machine_cycle_scaler()
+uint8_t get_machine_cycle_scaler(GbcMachine *gb)
 {
-   uint8_t mcs = cpu->speed_enabled ? M2S_DOUBLE_SPEED : M2S_BASE_SPEED;
+   uint8_t mcs = gb->cpu->speed_enabled ? M2S_DOUBLE_SPEED : M2S_BASE_SPEED;
    return mcs;
 }
 
-void reset_cpu()
+void reset_cpu(GbcMachine *gb)
+{
+    gb->R->PC = 0x0000;
+}
+
+void start_cpu(GbcMachine *gb)
+{
+    gb->cpu->running = true;
+}
+
+void stop_cpu(GbcMachine *gb)
+{
+    gb->cpu->running = false;
+}
+
+bool cpu_running(GbcMachine *gb)
 {
-    R->PC = 0x0000;
+    return gb->cpu->running;
 }
 
-void start_cpu()
+void stall_cpu(GbcMachine *gb, uint16_t cycles)
 {
-    cpu->running = true;
+    gb->cpu->stalled += cycles;
 }
 
-void stop_cpu()
+bool cpu_stalled(GbcMachine *gb)
 {
-    cpu->running = false;
+    return (gb->cpu->stalled != 0);
 }
 
-bool cpu_running()
+bool cpu_sleeping(GbcMachine *gb)
 {
-    return cpu->running;
+    if (!gb->cpu->halted || gb->owed_cycles) return false;
+    return (*gb->R->IFR & *gb->R->IER & LOWER_5_MASK) == 0;
 }
 
-void init_cpu()
+void set_execution_mode(GbcMachine *gb, ExecutionMode mode)
+{
+    if ((mode == JIT_EXECUTION) && (gb->code->jit == NULL)) gb->code->jit = init_jit(JIT_ARENA_SIZE);
+    if ((mode == JIT_EXECUTION) && (gb->code->jit == NULL)) mode = FAST_EXECUTION;
+    gb->exec_mode = (uint8_t) mode;
+}
+
+ExecutionMode get_execution_mode(GbcMachine *gb)
+{
+    return (ExecutionMode) gb->exec_mode;
+}
+
+void init_cpu(GbcMachine *gb)
 {
     // Init Pointers
-    cpu = (CPU*)                                   malloc(sizeof(CPU));
-    R   = (Register*)                         malloc(sizeof(Register));
-    iee = (InterruptEnableEvent*) malloc(sizeof(InterruptEnableEvent));
-    ins = (InstructionEntity*)       malloc(sizeof(InstructionEntity));
-    reset_ins(ins); // Will Execute the first NOP
-    iee->active = false;
+    gb->cpu = (CPU*)                                   arena_alloc(gb->arena, sizeof(CPU));
+    gb->R   = (Register*)                         arena_alloc(gb->arena, sizeof(Register));
+    gb->iee = (InterruptEnableEvent*) arena_alloc(gb->arena, sizeof(InterruptEnableEvent));
+    gb->ins = (InstructionEntity*)       arena_alloc(gb->arena, sizeof(InstructionEntity));
+    gb->flags = (LazyFlags*)                     arena_alloc(gb->arena, sizeof(LazyFlags));
+    gb->code = (CodeCache*)                      arena_alloc(gb->arena, sizeof(CodeCache));
+    flush_code(gb);
+    reset_ins(gb, gb->ins); // Will Execute the first NOP
+    gb->iee->active = false;
+    gb->cb_prefixed = false;
     // Init CPU Registers
-    R->A = R->F = DEFAULT_REG_VAL;
-    R->B = R->C = DEFAULT_REG_VAL;
-    R->D = R->E = DEFAULT_REG_VAL;
-    R->H = R->L = DEFAULT_REG_VAL;
+    gb->R->A = gb->R->F = DEFAULT_REG_VAL;
+    gb->R->B = gb->R->C = DEFAULT_REG_VAL;
+    gb->R->D = gb->R->E = DEFAULT_REG_VAL;
+    gb->R->H = gb->R->L = DEFAULT_REG_VAL;
     // Init Hardware Registers
-    R->IER = get_memory_pointer(IER);
-    R->IFR = get_memory_pointer(IFR);
+    gb->R->IER = get_memory_pointer(gb, IER);
+    gb->R->IFR = get_memory_pointer(gb, IFR);
     // Init CPU State
-    cpu->ime             = false;
-    cpu->speed_enabled   = false;
-    cpu->running         = true;
-    cpu->halted          = false;
-    cpu->halt_bug_active = false;
+    gb->cpu->ime             = false;
+    gb->cpu->speed_enabled   = false;
+    gb->cpu->running         = true;
+    gb->cpu->halted          = false;
+    gb->cpu->halt_bug_active = false;
+    gb->cpu->stalled         = 0;
     // Init SP and PC.
-    R->PC = 0x0000;
-    R->SP = HIGH_RAM_ADDRESS_END;
+    gb->R->PC = 0x0000;
+    gb->R->SP = HIGH_RAM_ADDRESS_END;
+
+}
 
+void tidy_cpu(GbcMachine *gb)
+{
+    tidy_jit(gb->code->jit); // The rest lives in the arena.
+    gb->cpu   = NULL;
+    gb->R     = NULL;
+    gb->iee   = NULL;
+    gb->ins   = NULL;
+    gb->flags = NULL;
+    gb->code  = NULL;
 }
 
-void tidy_cpu()
+/* SNAPSHOTS */
+
+typedef enum
 {
-    free(cpu); cpu = NULL;
-    free(R);     R = NULL;
-    free(iee); iee = NULL;
-    free(ins); ins = NULL;
+    MAIN_HANDLER      = (uint8_t) 0x00, // opcode_table[opcode]
+    PREFIX_HANDLER    = (uint8_t) 0x01, // prefix_opcode_table[opcode]
+    INTERRUPT_HANDLER = (uint8_t) 0x02  // int_exec
+
+} HandlerKind; // Handlers are function pointers, so snapshots store where they came from instead.
+
+static char *get_interrupt_label(uint16_t vector)
+{
+    switch (vector)
+    {
+        case VBLANK_VECTOR: return "VBLANK INTTERRUPT";
+        case LCD_VECTOR:    return "LCD INTTERRUPT";
+        case TIMER_VECTOR:  return "TIMER INTTERRUPT";
+        case SERIAL_VECTOR: return "SERIAL INTTERRUPT";
+        case JOYPAD_VECTOR: return "JOYPAD INTTERRUPT";
+        default:            return "N/A";
+    }
+}
+
+size_t get_cpu_snapshot_size(GbcMachine *gb)
+{
+    return sizeof(CPU) + (8 * sizeof(uint8_t)) + (2 * sizeof(uint16_t)) + 
+           sizeof(InterruptEnableEvent) + sizeof(bool) +
+           sizeof(uint16_t) + (6 * sizeof(uint8_t)) + sizeof(bool);
+}
+
+uint8_t *save_cpu_snapshot(GbcMachine *gb, uint8_t *dest)
+{
+    Register          *R = gb->R;
+    InstructionEntity *ins = gb->ins;
+
+    settle_flags(gb); // Snapshots only carry F.
+    dest = pack_bytes(dest, gb->cpu, sizeof(CPU));
+    // Registers without the IER/IFR pointers.
+    dest = pack_bytes(dest, &R->A,  1); dest = pack_bytes(dest, &R->F,  1);
+    dest = pack_bytes(dest, &R->B,  1); dest = pack_bytes(dest, &R->C,  1);
+    dest = pack_bytes(dest, &R->D,  1); dest = pack_bytes(dest, &R->E,  1);
+    dest = pack_bytes(dest, &R->H,  1); dest = pack_bytes(dest, &R->L,  1);
+    dest = pack_bytes(dest, &R->PC, 2); dest = pack_bytes(dest, &R->SP, 2);
+    dest = pack_bytes(dest, gb->iee, sizeof(InterruptEnableEvent));
+    dest = pack_bytes(dest, &gb->cb_prefixed, sizeof(bool));
+
+    // In-flight instruction, resumed mid M-cycle on load.
+    uint8_t kind = MAIN_HANDLER;
+    if      (ins->handler == int_exec)                  kind = INTERRUPT_HANDLER;
+    else if (ins->handler != opcode_table[ins->opcode]) kind = PREFIX_HANDLER;
+    dest = pack_bytes(dest, &ins->address,  sizeof(uint16_t));
+    dest = pack_bytes(dest, &ins->duration, 1);
+    dest = pack_bytes(dest, &ins->length,   1);
+    dest = pack_bytes(dest, &ins->low,      1);
+    dest = pack_bytes(dest, &ins->high,     1);
+    dest = pack_bytes(dest, &ins->opcode,   1);
+    dest = pack_bytes(dest, &kind,          1);
+    dest = pack_bytes(dest, &ins->executed, sizeof(bool));
+    return dest;
+}
+
+const uint8_t *load_cpu_snapshot(GbcMachine *gb, const uint8_t *src)
+{
+    Register          *R = gb->R;
+    InstructionEntity *ins = gb->ins;
+
+    src = unpack_bytes(src, gb->cpu, sizeof(CPU));
+    src = unpack_bytes(src, &R->A,  1); src = unpack_bytes(src, &R->F,  1);
+    src = unpack_bytes(src, &R->B,  1); src = unpack_bytes(src, &R->C,  1);
+    src = unpack_bytes(src, &R->D,  1); src = unpack_bytes(src, &R->E,  1);
+    src = unpack_bytes(src, &R->H,  1); src = unpack_bytes(src, &R->L,  1);
+    src = unpack_bytes(src, &R->PC, 2); src = unpack_bytes(src, &R->SP, 2);
+    src = unpack_bytes(src, gb->iee, sizeof(InterruptEnableEvent));
+    src = unpack_bytes(src, &gb->cb_prefixed, sizeof(bool));
+    gb->flags->source = FLAGS_SETTLED;
+
+    uint8_t kind;
+    src = unpack_bytes(src, &ins->address,  sizeof(uint16_t));
+    src = unpack_bytes(src, &ins->duration, 1);
+    src = unpack_bytes(src, &ins->length,   1);
+    src = unpack_bytes(src, &ins->low,      1);
+    src = unpack_bytes(src, &ins->high,     1);
+    src = unpack_bytes(src, &ins->opcode,   1);
+    src = unpack_bytes(src, &kind,          1);
+    src = unpack_bytes(src, &ins->executed, sizeof(bool));
+    ins->operands_left = 0;
+    flush_code(gb); // Memory was replaced underneath it.
+    switch (kind)
+    {
+        case INTERRUPT_HANDLER:
+            ins->handler = int_exec;
+            ins->  label = get_interrupt_label(ins->address);
+            break;
+        case PREFIX_HANDLER:
+            ins->handler = prefix_opcode_table[ins->opcode];
+            ins->  label = cb_opcode_word[ins->opcode];
+            break;
+        default:
+            ins->handler = opcode_table[ins->opcode];
+            ins->  label = opcode_word[ins->opcode];
+            break;
+    }
+    return src;
 }
 
 
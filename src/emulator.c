@@ -3,13 +3,19 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include "arena.h"
 #include "cart.h"
 #include "common.h"
 #include "cpu.h"
 #include "emulator.h"
 #include "logger.h"
+#include "machine.h"
 #include "mmu.h"
+#include "movie.h"
+#include "page.h"
 #include "ppu.h"
+#include "scheduler.h"
+#include "snapshot.h"
 #include "timer.h"
 
 #define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
@@ -21,12 +27,6 @@ static SDL_Window        *window;
 static SDL_Renderer    *renderer;
 static SDL_Texture  *framebuffer;
 static bool              running;
-static bool      frame_available;
-static SDL_mutex          *mutex;
-static SDL_cond     *frame_ready;
-static char      *cartridge_file;
-
-JoypadState *joypad;
 
 static bool init_display()
 {
@@ -82,21 +82,19 @@ static bool init_display()
     }
 
     running = true;
-    frame_available = false;
 }
 
 static void tidy_display()
 {
-    SDL_DestroyMutex(mutex);
     SDL_DestroyTexture(framebuffer);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
 }
 
-static void init_joypad()
+static void init_joypad(GbcMachine *gb)
 {
-    joypad = (JoypadState*) malloc(sizeof(JoypadState));
+    JoypadState *joypad = (JoypadState*) malloc(sizeof(JoypadState));
     joypad->     A = false;
     joypad->     B = false;
     joypad->SELECT = false;
@@ -108,73 +106,146 @@ static void init_joypad()
 
     joypad->turbo_enabled = false;
     joypad-> turbo_scaler = DEFAULT_TURBO;
+
+    gb->joypad = joypad;
 }
 
-static void tidy_joypad()
+static void tidy_joypad(GbcMachine *gb)
 {
-    free(joypad); joypad = NULL;
+    free(gb->joypad); gb->joypad = NULL;
 }
 
-void init_emulator(char *file_path, bool display)
+static bool init_machine(GbcMachine *gb, char *file_path)
 {
-    init_memory();
+    gb->arena = init_arena(MACHINE_ARENA_SIZE);
+    init_memory(gb);
     LOG_MESSAGE(INFO, "Memory initialized.");
-    init_timer();
+    init_timer(gb);
     LOG_MESSAGE(INFO, "Timer initialized.");
-    init_cartridge(file_path);
+    if (!init_cartridge(gb, file_path))
+    { // Back out in reverse, nothing past the cartridge is set up yet.
+        tidy_cartridge(gb);
+        tidy_timer(gb);
+        tidy_memory(gb);
+        tidy_arena(gb->arena);
+        gb->arena = NULL;
+        return false;
+    }
     LOG_MESSAGE(INFO, "Cartridge initialized.");
-    init_cpu();
+    init_cpu(gb);
     LOG_MESSAGE(INFO, "CPU initialized.");
-    init_graphics();
+    init_graphics(gb);
     LOG_MESSAGE(INFO, "Graphics initialized.");
+    LOG_MESSAGE(DEBUG, "Machine state takes %zu bytes of its arena.", get_arena_used(gb->arena));
+
+    gb->cartridge_file = file_path;
+    return true;
+}
+
+static void tidy_machine(GbcMachine *gb)
+{
+    if (gb->arena == NULL) return; // A power cycle that could not reload, already tidied.
+    tidy_memory(gb);
+    tidy_timer(gb);
+    tidy_cartridge(gb);
+    tidy_cpu(gb);
+    tidy_graphics(gb);
+    tidy_arena(gb->arena); // Last, the tidy_ calls above still read through it.
+    gb->arena = NULL;
+}
+
+GbcMachine *init_emulator(char *file_path, bool display)
+{
+    GbcMachine *gb = (GbcMachine*) calloc(1, sizeof(GbcMachine));
+    if (!init_machine(gb, file_path))
+    {
+        free(gb);
+        return NULL;
+    }
+
+    // Headless machines still own a (released) joypad so JOYP reads stay valid.
+    init_joypad(gb);
+    LOG_MESSAGE(INFO, "Joypad, locked and loaded!");
 
     if (display)
     {
         init_display();
         LOG_MESSAGE(INFO, "Display initialized.");
-
-        init_joypad();
-        LOG_MESSAGE(INFO, "Joypad, locked and loaded!");
     }
 
-    cartridge_file = file_path;
+    return gb;
 }
 
-void tidy_emulator(bool display)
+static void copy_machine_state(GbcMachine *gb, GbcMachine *parent) // CPU, PPU and TIMER, whose state points into its own machine.
 {
-    tidy_memory();
-    tidy_timer();
-    tidy_cartridge();
-    tidy_cpu();
-    tidy_graphics();
+    size_t   size = get_cpu_snapshot_size(parent) + get_graphics_snapshot_size(parent) + get_timer_snapshot_size(parent);
+    uint8_t *scratch = (uint8_t*) malloc(size);
+
+    uint8_t *dest = scratch; // The snapshot sections already know how to rebind those pointers.
+    dest = save_cpu_snapshot(parent, dest);
+    dest = save_graphics_snapshot(parent, dest);
+    dest = save_timer_snapshot(parent, dest);
+
+    const uint8_t *src = scratch;
+    src = load_cpu_snapshot(gb, src);
+    src = load_graphics_snapshot(gb, src);
+    src = load_timer_snapshot(gb, src);
+
+    free(scratch);
+}
+
+GbcMachine *fork_emulator(GbcMachine *parent)
+{
+    GbcMachine *gb = (GbcMachine*) calloc(1, sizeof(GbcMachine));
+    gb->arena      = init_arena(MACHINE_ARENA_SIZE);
+    catch_up_ppu(parent); // Before its memory is shared.
+    fork_memory(gb, parent);
+    init_timer(gb);
+    fork_cartridge(gb, parent);
+    init_cpu(gb);
+    init_graphics(gb);
+    copy_machine_state(gb, parent);
+
+    init_joypad(gb);
+    (*gb->joypad)      = (*parent->joypad);
+    gb->cartridge_file = parent->cartridge_file;
+    gb->boot_snapshot  = share_page(parent->boot_snapshot);
+    gb->boot_pending   = parent->boot_pending;
+    gb->persist_boot   = parent->persist_boot;
+    gb->exec_mode      = parent->exec_mode;
+    gb->no_idle_skip   = parent->no_idle_skip;
+    return gb;
+}
+
+static void log_idle_stats(GbcMachine *gb)
+{
+    IdleStats stats = get_idle_stats(gb);
+    if (stats.total == 0) return;
+    LOG_MESSAGE(INFO, "%s spent %.1f%% of its dots halted and %.1f%% polling, both fast-forwarded.",
+                gb->cartridge_file, (100.0 * stats.halted) / stats.total, (100.0 * stats.polling) / stats.total);
+}
+
+void tidy_emulator(GbcMachine *gb, bool display)
+{
+    log_idle_stats(gb);
+    tidy_machine(gb);
+    release_page(gb->boot_snapshot);
+    tidy_joypad(gb);
+    free(gb);
     if (display) 
     {
         tidy_display();
-        tidy_joypad();
     }
 }
 
-int emu_thread(void *data)
+static void frame_task(void *context, SchedulerTask *task)
 {
-    while (running)
-    {
-        uint32_t dot = system_clock_pulse();
-        if (dot == 0)
-        {
-            SDL_LockMutex(mutex);
-            while(frame_available)
-            {
-                SDL_CondWait(frame_ready, mutex);
-            }
-            frame_available = true;
-            SDL_CondSignal(frame_ready);
-            SDL_UnlockMutex(mutex);
-        }
-    }  
+    run_frames((GbcMachine*) context, task->frames);
 }
 
-char *get_joypad_state(char *buffer, uint8_t size)
+char *get_joypad_state(GbcMachine *gb, char *buffer, uint8_t size)
 {
+    JoypadState *joypad = gb->joypad;
     snprintf
     (buffer,
      size,
@@ -191,11 +262,34 @@ char *get_joypad_state(char *buffer, uint8_t size)
     return buffer;
 }
 
-static void reset_emulator()
+static void reset_emulator(GbcMachine *gb)
 {
-    if (joypad->turbo_enabled) return;
-    tidy_emulator(false);
-    init_emulator(cartridge_file, false);
+    if (gb->joypad->turbo_enabled) return;
+    fast_reset_emulator(gb);
+}
+
+bool power_cycle_emulator(GbcMachine *gb)
+{
+    char *file_path = gb->cartridge_file;
+    tidy_machine(gb);
+    if (!init_machine(gb, file_path)) return false;
+    restore_joypad(gb, 0);
+    return true;
+}
+
+void fast_reset_emulator(GbcMachine *gb)
+{
+    bool cached = restore_boot_snapshot(gb);
+    if (!cached && gb->persist_boot)
+    {
+        cached = read_boot_snapshot_file(gb) && restore_boot_snapshot(gb);
+    }
+    if (cached)
+    {
+        restore_joypad(gb, 0);
+        return;
+    }
+    power_cycle_emulator(gb); // Captures the boot snapshot on the way through.
 }
 
 static void increment_turbo(JoypadState *joypad)
@@ -216,53 +310,55 @@ static void decrement_turbo(JoypadState *joypad)
     } 
 }
 
-static void handle_button_press(SDL_Event *event)
+static void handle_button_press(GbcMachine *gb, SDL_Event *event, uint8_t *buttons)
 {
+    JoypadState *joypad = gb->joypad;
     if (!joypad || event->key.repeat) return;
 
     SDL_Keycode key = event->key.keysym.sym;
 
     switch (key)
     {
-        case SDLK_x:         joypad->            A = true; break;
-        case SDLK_z:         joypad->            B = true; break;
-        case SDLK_RETURN:    joypad->        START = true; break;
-        case SDLK_BACKSPACE: joypad->       SELECT = true; break;
-        case SDLK_UP:        joypad->           UP = true; break;
-        case SDLK_DOWN:      joypad->         DOWN = true; break;
-        case SDLK_RIGHT:     joypad->        RIGHT = true; break;
-        case SDLK_LEFT:      joypad->         LEFT = true; break;
-        case SDLK_SPACE:     joypad->turbo_enabled = true; break;
+        case SDLK_x:         (*buttons) |= JOYPAD_A;           break;
+        case SDLK_z:         (*buttons) |= JOYPAD_B;           break;
+        case SDLK_RETURN:    (*buttons) |= JOYPAD_START;       break;
+        case SDLK_BACKSPACE: (*buttons) |= JOYPAD_SELECT;      break;
+        case SDLK_UP:        (*buttons) |= JOYPAD_UP;          break;
+        case SDLK_DOWN:      (*buttons) |= JOYPAD_DOWN;        break;
+        case SDLK_RIGHT:     (*buttons) |= JOYPAD_RIGHT;       break;
+        case SDLK_LEFT:      (*buttons) |= JOYPAD_LEFT;        break;
+        case SDLK_SPACE:     joypad->turbo_enabled = true;     break;
     }
 }
 
-static void handle_button_release(SDL_Event *event)
+static void handle_button_release(GbcMachine *gb, SDL_Event *event, uint8_t *buttons)
 {
+    JoypadState *joypad = gb->joypad;
     if (!joypad) return;
 
     SDL_Keycode key = event->key.keysym.sym;
 
     switch (key)
     {
-        case SDLK_p:         increment_turbo(joypad);       break;
-        case SDLK_o:         decrement_turbo(joypad);       break;
-        case SDLK_r:         reset_emulator();              break;
-        case SDLK_x:         joypad->            A = false; break;
-        case SDLK_z:         joypad->            B = false; break;
-        case SDLK_RETURN:    joypad->        START = false; break;
-        case SDLK_BACKSPACE: joypad->       SELECT = false; break;
-        case SDLK_UP:        joypad->           UP = false; break;
-        case SDLK_DOWN:      joypad->         DOWN = false; break;
-        case SDLK_RIGHT:     joypad->        RIGHT = false; break;
-        case SDLK_LEFT:      joypad->         LEFT = false; break;
-        case SDLK_SPACE:     joypad->turbo_enabled = false; break;
+        case SDLK_p:         increment_turbo(joypad);          break;
+        case SDLK_o:         decrement_turbo(joypad);          break;
+        case SDLK_r:         reset_emulator(gb);               break;
+        case SDLK_x:         (*buttons) &= ~JOYPAD_A;          break;
+        case SDLK_z:         (*buttons) &= ~JOYPAD_B;          break;
+        case SDLK_RETURN:    (*buttons) &= ~JOYPAD_START;      break;
+        case SDLK_BACKSPACE: (*buttons) &= ~JOYPAD_SELECT;     break;
+        case SDLK_UP:        (*buttons) &= ~JOYPAD_UP;         break;
+        case SDLK_DOWN:      (*buttons) &= ~JOYPAD_DOWN;       break;
+        case SDLK_RIGHT:     (*buttons) &= ~JOYPAD_RIGHT;      break;
+        case SDLK_LEFT:      (*buttons) &= ~JOYPAD_LEFT;       break;
+        case SDLK_SPACE:     joypad->turbo_enabled = false;    break;
     }
 }
 
-static void handle_events()
+static void handle_events(GbcMachine *gb)
 {
     SDL_Event event;
-    bool jirn = false; // Joypad Interrupt Request Needed
+    uint8_t buttons = get_joypad_buttons(gb); // Applied once per frame, the way set_joypad() replays movies.
 
     while (SDL_PollEvent(&event)) // Keep going until event queue is empty.
     {
@@ -273,52 +369,91 @@ static void handle_events()
                 break;
             
             case SDL_KEYDOWN:
-                handle_button_press(&event);
-                jirn = true;
+                handle_button_press(gb, &event, &buttons);
                 break;
             
             case SDL_KEYUP:
-                handle_button_release(&event);
-                jirn = true;
+                handle_button_release(gb, &event, &buttons);
                 break;
         }
     }
     
-    if (jirn) 
-    {
-        request_interrupt(JOYPAD_INTERRUPT_CODE);
-    }
+    set_joypad(gb, buttons); // Requests the joypad interrupt only if the buttons changed.
+}
+
+JoypadState *get_joypad(GbcMachine *gb)
+{
+    return gb->joypad;
 }
 
-JoypadState *get_joypad()
+void set_joypad(GbcMachine *gb, uint8_t buttons)
 {
-    return joypad;
+    if (get_joypad_buttons(gb) == buttons) return;
+    restore_joypad(gb, buttons);
+    request_interrupt(gb, JOYPAD_INTERRUPT_CODE);
 }
 
-void start_emulator()
+void restore_joypad(GbcMachine *gb, uint8_t buttons)
 {
+    JoypadState *joypad = gb->joypad;
+    joypad->     A = (buttons & JOYPAD_A)      != 0;
+    joypad->     B = (buttons & JOYPAD_B)      != 0;
+    joypad->SELECT = (buttons & JOYPAD_SELECT) != 0;
+    joypad-> START = (buttons & JOYPAD_START)  != 0;
+    joypad-> RIGHT = (buttons & JOYPAD_RIGHT)  != 0;
+    joypad->  LEFT = (buttons & JOYPAD_LEFT)   != 0;
+    joypad->    UP = (buttons & JOYPAD_UP)     != 0;
+    joypad->  DOWN = (buttons & JOYPAD_DOWN)   != 0;
+}
+
+uint8_t get_joypad_buttons(GbcMachine *gb)
+{
+    JoypadState *joypad = gb->joypad;
+    uint8_t buttons = 0;
+    if (joypad->A)      buttons |= JOYPAD_A;
+    if (joypad->B)      buttons |= JOYPAD_B;
+    if (joypad->SELECT) buttons |= JOYPAD_SELECT;
+    if (joypad->START)  buttons |= JOYPAD_START;
+    if (joypad->RIGHT)  buttons |= JOYPAD_RIGHT;
+    if (joypad->LEFT)   buttons |= JOYPAD_LEFT;
+    if (joypad->UP)     buttons |= JOYPAD_UP;
+    if (joypad->DOWN)   buttons |= JOYPAD_DOWN;
+    return buttons;
+}
+
+void run_frames(GbcMachine *gb, uint32_t frames)
+{
+    uint32_t target = gb->frame_count + frames; // FAST_EXECUTION can step over dot 0.
+    while (gb->frame_count != target)
+    {
+        system_clock_pulse(gb);
+    }
+    settle_flags(gb); // Callers read R directly.
+}
+
+void start_emulator(GbcMachine *gb, Movie *movie)
+{
+    // Emulation runs as scheduler tasks, one frame each, on a single worker.
+    Scheduler *scheduler = init_scheduler(1, frame_task, gb);
+    if (!scheduler) return;
+
     running = true;
-    mutex = SDL_CreateMutex();
-    frame_ready = SDL_CreateCond();
-    SDL_Thread *emulation_thread = SDL_CreateThread(emu_thread, "Emu Thread", NULL);
+    if (movie) record_movie_frame(movie, gb); // One recorded frame per submitted frame.
+    submit_task(scheduler, 0, 1);
     while(running) // 1 Loop = 1 Frame
     {
         Uint64 start_time = SDL_GetPerformanceCounter();
+        // Wait for the frame in flight; the machine is idle until the next submission.
+        wait_scheduler(scheduler);
         // Record input into joypad.
-        handle_events();
-        // Check if frame is ready.
-        SDL_LockMutex(mutex);
-        while (!frame_available) 
-        {
-            SDL_CondWait(frame_ready, mutex);
-        }
-        frame_available = false;
-        SDL_CondSignal(frame_ready);
-        SDL_UnlockMutex(mutex);
+        handle_events(gb);
+        if (movie && running) record_movie_frame(movie, gb);
         
         // Frame ready, good to go.
         // Consume frame and update texture to render.
-        SDL_UpdateTexture(framebuffer, NULL, render_frame(), GBC_WIDTH * sizeof(uint32_t));
+        SDL_UpdateTexture(framebuffer, NULL, render_frame(gb), GBC_WIDTH * sizeof(uint32_t));
+        // Emulate the next frame while this one is presented.
+        if (running) submit_task(scheduler, 0, 1);
         SDL_RenderClear(renderer);
         SDL_RenderCopy(renderer, framebuffer, NULL, NULL);
         SDL_RenderPresent(renderer);
@@ -330,9 +465,11 @@ void start_emulator()
         if (elapsed_ms < FRAME_PERIOD)
         {
             uint32_t delay = (Uint32)(FRAME_PERIOD - elapsed_ms);
-            delay = joypad->turbo_enabled ? (delay / joypad->turbo_scaler) : delay;
+            delay = gb->joypad->turbo_enabled ? (delay / gb->joypad->turbo_scaler) : delay;
             SDL_Delay(delay);        
         }
     }
-    SDL_WaitThread(emulation_thread, NULL);
+    wait_scheduler(scheduler);
+    print_scheduler_stats(scheduler);
+    tidy_scheduler(scheduler);
 }
@@ -0,0 +1,157 @@
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "image.h"
+#include "logger.h"
+
+#define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
+
+typedef struct Image
+{
+    dev_t              device;
+    ino_t               inode;
+    const uint8_t       *data;
+    size_t               size;
+    uint32_t             refs;
+    struct Image        *next;
+
+} Image;
+
+static Image      *images = NULL;
+static atomic_flag   lock = ATOMIC_FLAG_INIT; // Held for a list walk at most, never across mmap() or malloc().
+
+static void lock_images()
+{
+    while (atomic_flag_test_and_set_explicit(&lock, memory_order_acquire));
+}
+
+static void unlock_images()
+{
+    atomic_flag_clear_explicit(&lock, memory_order_release);
+}
+
+static Image *find_image(const uint8_t *data, dev_t device, ino_t inode)
+{
+    for (Image *image = images; image != NULL; image = image->next)
+    {
+        if (data && (image->data == data)) return image;
+        if (!data && (image->device == device) && (image->inode == inode)) return image;
+    }
+    return NULL;
+}
+
+const uint8_t *map_image(const char *file_path, size_t *size)
+{
+    int fd = open(file_path, O_RDONLY);
+    if (fd < 0)
+    {
+        LOG_MESSAGE(ERROR, "Failed to open %s.", file_path);
+        return NULL;
+    }
+    struct stat info;
+    if ((fstat(fd, &info) != 0) || (info.st_size <= 0))
+    {
+        LOG_MESSAGE(ERROR, "%s is empty or unreadable.", file_path);
+        close(fd);
+        return NULL;
+    }
+
+    lock_images();
+    Image *image = find_image(NULL, info.st_dev, info.st_ino);
+    if (image) image->refs += 1;
+    unlock_images();
+    if (image)
+    {
+        close(fd);
+        (*size) = image->size;
+        return image->data;
+    }
+
+    void *data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file alive.
+    if (data == MAP_FAILED)
+    {
+        LOG_MESSAGE(ERROR, "Failed to map %s.", file_path);
+        return NULL;
+    }
+
+    Image *mapped  = (Image*) malloc(sizeof(Image));
+    if (mapped == NULL)
+    {
+        LOG_MESSAGE(ERROR, "Failed to register %s.", file_path);
+        munmap(data, (size_t) info.st_size);
+        return NULL;
+    }
+    mapped->device = info.st_dev;
+    mapped->inode  = info.st_ino;
+    mapped->data   = (const uint8_t*) data;
+    mapped->size   = (size_t) info.st_size;
+    mapped->refs   = 1;
+
+    lock_images();
+    image = find_image(NULL, info.st_dev, info.st_ino); // Another thread may have mapped it in the meantime.
+    if (image)
+    {
+        image->refs += 1;
+    }
+    else
+    {
+        mapped->next = images;
+        images       = mapped;
+        image        = mapped;
+    }
+    unlock_images();
+
+    if (image != mapped)
+    {
+        munmap(data, mapped->size);
+        free(mapped);
+    }
+    (*size) = image->size;
+    return image->data;
+}
+
+const uint8_t *share_image(const uint8_t *data)
+{
+    if (data == NULL) return NULL;
+    lock_images();
+    Image *image = find_image(data, 0, 0);
+    if (image) image->refs += 1;
+    unlock_images();
+    return data;
+}
+
+void unmap_image(const uint8_t *data)
+{
+    if (data == NULL) return;
+    lock_images();
+    Image **link = &images;
+    while ((*link) && ((*link)->data != data)) link = &(*link)->next;
+
+    Image *image = (*link);
+    if ((image == NULL) || (--image->refs > 0))
+    {
+        unlock_images();
+        return;
+    }
+    (*link) = image->next;
+    unlock_images();
+
+    munmap((void*) image->data, image->size);
+    free(image);
+}
+
+uint32_t get_image_references(const uint8_t *data)
+{
+    if (data == NULL) return 0;
+    lock_images();
+    Image *image = find_image(data, 0, 0);
+    uint32_t refs = image ? image->refs : 0;
+    unlock_images();
+    return refs;
+}
@@ -0,0 +1,360 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "cpu.h"
+#include "jit.h"
+#include "logger.h"
+
+#define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
+#define JIT_BLOCK_MAX  1024 // Bytes of host code one block can need, prologue and epilogue included.
+
+typedef struct JitArena
+{
+    uint8_t       *base;
+    size_t         size;
+    size_t         used;
+    uint32_t generation; // Bumped whenever the arena is recycled.
+
+} JitArena;
+
+typedef struct
+{
+    uint8_t *cursor;
+
+} Emitter;
+
+/* HOST REGISTERS */
+
+typedef enum
+{
+    RAX = 0, RCX = 1, RDX = 2, RDI = 7,
+    R8  = 8, R9  = 9, R10 = 10, R11 = 11,
+    R12 = 12, R13 = 13, R14 = 14, R15 = 15
+
+} HostRegister;
+
+#define HOST_A R8
+#define HOST_F R9
+
+// SM83 register field (B C D E H L [HL] A) to the host register holding it.
+static const int8_t host_reg[8] = { R10, R11, R12, R13, R14, R15, -1, R8 };
+
+typedef enum
+{
+    ALU_ADD = 0, ALU_ADC = 1, ALU_SUB = 2, ALU_SBC = 3,
+    ALU_AND = 4, ALU_XOR = 5, ALU_OR  = 6, ALU_CP  = 7
+
+} AluKind; // SM83 order, bits 3-5 of $80-$BF and $C6-$FE.
+
+static const uint8_t x86_alu_rr[8]  = { 0x00, 0x10, 0x28, 0x18, 0x20, 0x30, 0x08, 0x38 }; // op r/m8, r8
+static const uint8_t x86_alu_ext[8] = { 0,    2,    5,    3,    4,    6,    1,    7    }; // 80 /ext ib
+
+/* EMITTER */
+
+static void emit(Emitter *e, uint8_t byte)
+{
+    *(e->cursor++) = byte;
+}
+
+static void emit_rex(Emitter *e, int reg, int rm) // Always emitted for byte ops, so 4-7 mean SPL-DIL, never AH-BH.
+{
+    emit(e, 0x40 | ((reg >> 3) << 2) | (rm >> 3));
+}
+
+static void emit_modrm_rr(Emitter *e, int reg, int rm)
+{
+    emit(e, 0xC0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+static void emit_mov_rr8(Emitter *e, int dest, int src)
+{
+    emit_rex(e, src, dest); emit(e, 0x88); emit_modrm_rr(e, src, dest);
+}
+
+static void emit_mov_ri8(Emitter *e, int dest, uint8_t imm)
+{
+    emit_rex(e, 0, dest); emit(e, 0xB0 + (dest & 7)); emit(e, imm);
+}
+
+static void emit_alu_rr8(Emitter *e, AluKind kind, int dest, int src)
+{
+    emit_rex(e, src, dest); emit(e, x86_alu_rr[kind]); emit_modrm_rr(e, src, dest);
+}
+
+static void emit_alu_ri8(Emitter *e, AluKind kind, int dest, uint8_t imm)
+{
+    emit_rex(e, 0, dest); emit(e, 0x80); emit_modrm_rr(e, x86_alu_ext[kind], dest); emit(e, imm);
+}
+
+static void emit_incdec8(Emitter *e, int dest, bool dec)
+{
+    emit_rex(e, 0, dest); emit(e, 0xFE); emit_modrm_rr(e, dec ? 1 : 0, dest);
+}
+
+static void emit_not8(Emitter *e, int dest)
+{
+    emit_rex(e, 0, dest); emit(e, 0xF6); emit_modrm_rr(e, 2, dest);
+}
+
+static void emit_f_op(Emitter *e, uint8_t ext, uint8_t imm) // and/or/xor r9d, imm8 (ext 4/1/6)
+{
+    emit(e, 0x41); emit(e, 0x83); emit_modrm_rr(e, ext, HOST_F); emit(e, imm);
+}
+
+static void emit_carry_in(Emitter *e) // bt r9d, 4 -> host CF = guest C
+{
+    emit(e, 0x41); emit(e, 0x0F); emit(e, 0xBA); emit_modrm_rr(e, 4, HOST_F); emit(e, 4);
+}
+
+static void emit_host_zh(Emitter *e, bool half) // ecx = Z (bit 7) and, if half, H (bit 5) from host ZF/AF.
+{
+    emit(e, 0x9F);                                   // lahf
+    emit(e, 0x0F); emit(e, 0xB6); emit(e, 0xCC);     // movzx ecx, ah
+    if (half)
+    {
+        emit(e, 0x89); emit(e, 0xC8);                // mov eax, ecx
+        emit(e, 0x83); emit(e, 0xE1); emit(e, 0x50); // and ecx, ZF|AF
+    }
+    else
+    {
+        emit(e, 0x83); emit(e, 0xE1); emit(e, 0x40); // and ecx, ZF
+    }
+    emit(e, 0x01); emit(e, 0xC9);                    // add ecx, ecx  -> bits 7 and 5
+}
+
+static void emit_flags_arith(Emitter *e, bool subtract) // Z N H C from the host flags of an add/sub.
+{
+    emit_host_zh(e, true);
+    emit(e, 0x83); emit(e, 0xE0); emit(e, 0x01);     // and eax, CF
+    emit(e, 0xC1); emit(e, 0xE0); emit(e, 0x04);     // shl eax, 4
+    emit(e, 0x09); emit(e, 0xC1);                    // or ecx, eax
+    if (subtract)
+    {
+        emit(e, 0x83); emit(e, 0xC9); emit(e, 0x40); // or ecx, N
+    }
+    emit(e, 0x41); emit(e, 0x89); emit(e, 0xC9);     // mov r9d, ecx
+}
+
+static void emit_flags_incdec(Emitter *e, bool subtract) // Z N H, C kept.
+{
+    emit_host_zh(e, true);
+    if (subtract)
+    {
+        emit(e, 0x83); emit(e, 0xC9); emit(e, 0x40); // or ecx, N
+    }
+    emit_f_op(e, 4, 0x10);                           // and r9d, C
+    emit(e, 0x41); emit(e, 0x09); emit(e, 0xC9);     // or r9d, ecx
+}
+
+static void emit_flags_logic(Emitter *e, bool half) // Z, H = half, N = C = 0.
+{
+    emit_host_zh(e, false);
+    if (half)
+    {
+        emit(e, 0x83); emit(e, 0xC9); emit(e, 0x20); // or ecx, H
+    }
+    emit(e, 0x41); emit(e, 0x89); emit(e, 0xC9);     // mov r9d, ecx
+}
+
+static void emit_alu(Emitter *e, AluKind kind, int src, bool immediate, uint8_t imm)
+{
+    if ((kind == ALU_ADC) || (kind == ALU_SBC)) emit_carry_in(e);
+    if (immediate) emit_alu_ri8(e, kind, HOST_A, imm);
+    else           emit_alu_rr8(e, kind, HOST_A, src);
+
+    switch (kind)
+    {
+        case ALU_AND: emit_flags_logic(e, true);  break;
+        case ALU_XOR:
+        case ALU_OR:  emit_flags_logic(e, false); break;
+        default:      emit_flags_arith(e, kind >= ALU_SUB); break;
+    }
+}
+
+static void emit_incdec16(Emitter *e, int high, int low, bool dec) // Same as reg_inc_16(), flags untouched.
+{
+    emit_alu_ri8(e, dec ? ALU_SUB : ALU_ADD, low,  1);
+    emit_alu_ri8(e, dec ? ALU_SBC : ALU_ADC, high, 0);
+}
+
+static void emit_load_store(Emitter *e, int host, uint8_t offset, bool store)
+{
+    if (store)
+    { // mov [rdi + offset], r8
+        emit_rex(e, host, RDI); emit(e, 0x88);
+    }
+    else
+    { // movzx r32, byte [rdi + offset]
+        emit(e, 0x40 | ((host >> 3) << 2)); emit(e, 0x0F); emit(e, 0xB6);
+    }
+    emit(e, 0x40 | ((host & 7) << 3) | RDI); emit(e, offset);
+}
+
+static const uint8_t guest_offsets[8] =
+{
+    offsetof(Register, B), offsetof(Register, C), offsetof(Register, D), offsetof(Register, E),
+    offsetof(Register, H), offsetof(Register, L), offsetof(Register, F), offsetof(Register, A)
+};
+
+static void emit_guest_registers(Emitter *e, bool store)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        int host = (i == 6) ? HOST_F : host_reg[i];
+        emit_load_store(e, host, guest_offsets[i], store);
+    }
+}
+
+static void emit_prologue(Emitter *e)
+{
+    emit(e, 0x41); emit(e, 0x54); emit(e, 0x41); emit(e, 0x55); // push r12, r13
+    emit(e, 0x41); emit(e, 0x56); emit(e, 0x41); emit(e, 0x57); // push r14, r15
+    emit_guest_registers(e, false);
+}
+
+static void emit_epilogue(Emitter *e)
+{
+    emit_guest_registers(e, true);
+    emit(e, 0x41); emit(e, 0x5F); emit(e, 0x41); emit(e, 0x5E); // pop r15, r14
+    emit(e, 0x41); emit(e, 0x5D); emit(e, 0x41); emit(e, 0x5C); // pop r13, r12
+    emit(e, 0xC3);                                              // ret
+}
+
+/* TRANSLATION */
+
+static bool translate(Emitter *e, const uint8_t *code, size_t left, uint8_t *length, uint8_t *cycles)
+{ // One instruction, or false if it is not register-only.
+    uint8_t opcode = code[0];
+    uint8_t    dst = (opcode >> 3) & 7;
+    uint8_t    src = opcode & 7;
+
+    if (opcode == 0x00) // NOP
+    {
+        (*length) = 1; (*cycles) = 1;
+        return true;
+    }
+    if ((opcode >= 0x40) && (opcode <= 0x7F) && (dst != 6) && (src != 6)) // LD r, r
+    {
+        emit_mov_rr8(e, host_reg[dst], host_reg[src]);
+        (*length) = 1; (*cycles) = 1;
+        return true;
+    }
+    if (((opcode & 0xC7) == 0x06) && (dst != 6) && (left >= 2)) // LD r, n
+    {
+        emit_mov_ri8(e, host_reg[dst], code[1]);
+        (*length) = 2; (*cycles) = 2;
+        return true;
+    }
+    if (((opcode & 0xC6) == 0x04) && (dst != 6)) // INC r, DEC r
+    {
+        bool dec = (opcode & 1);
+        emit_incdec8(e, host_reg[dst], dec);
+        emit_flags_incdec(e, dec);
+        (*length) = 1; (*cycles) = 1;
+        return true;
+    }
+    if ((opcode >= 0x80) && (opcode <= 0xBF) && (src != 6)) // ALU A, r
+    {
+        emit_alu(e, (AluKind) dst, host_reg[src], false, 0);
+        (*length) = 1; (*cycles) = 1;
+        return true;
+    }
+    if (((opcode & 0xC7) == 0xC6) && (left >= 2)) // ALU A, n
+    {
+        emit_alu(e, (AluKind) dst, 0, true, code[1]);
+        (*length) = 2; (*cycles) = 2;
+        return true;
+    }
+    if (((opcode & 0xC7) == 0x03) && (opcode < 0x30)) // INC rr, DEC rr (not SP)
+    {
+        uint8_t pair = (opcode >> 4) * 2; // B, D or H
+        emit_incdec16(e, host_reg[pair], host_reg[pair + 1], (opcode & 0x08));
+        (*length) = 1; (*cycles) = 2;
+        return true;
+    }
+    switch (opcode)
+    {
+        case 0x2F: // CPL
+            emit_not8(e, HOST_A);
+            emit_f_op(e, 1, 0x60);
+            break;
+        case 0x37: // SCF
+            emit_f_op(e, 4, 0x80);
+            emit_f_op(e, 1, 0x10);
+            break;
+        case 0x3F: // CCF
+            emit_f_op(e, 4, 0x90);
+            emit_f_op(e, 6, 0x10);
+            break;
+        default:
+            return false;
+    }
+    (*length) = 1; (*cycles) = 1;
+    return true;
+}
+
+NativeBlock compile_native(JitArena *arena, const uint8_t *code, size_t size, uint8_t *count, uint8_t *length, uint8_t *cycles)
+{
+    (*count) = 0; (*length) = 0; (*cycles) = 0;
+    if (arena->used + JIT_BLOCK_MAX > arena->size)
+    { // Full. Start over rather than track what is still live.
+        arena->used        = 0;
+        arena->generation += 1;
+    }
+
+    uint8_t *start = arena->base + arena->used;
+    Emitter      e = { start };
+    emit_prologue(&e);
+
+    size_t offset = 0;
+    while (offset < size)
+    {
+        uint8_t bytes, taken;
+        if (!translate(&e, code + offset, size - offset, &bytes, &taken)) break;
+        offset      += bytes;
+        (*count)    += 1;
+        (*cycles)   += taken;
+    }
+    (*length) = (uint8_t) offset;
+    if ((*count) < JIT_MIN_RUN) return NULL; // Nothing committed, the bytes are simply reused.
+
+    emit_epilogue(&e);
+    arena->used += (size_t) (e.cursor - start);
+    return (NativeBlock) start;
+}
+
+/* ARENA */
+
+JitArena *init_jit(size_t size)
+{
+#if defined(__x86_64__)
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+    {
+        LOG_MESSAGE(WARNING, "No executable memory, staying on the interpreter.");
+        return NULL;
+    }
+    JitArena *arena = (JitArena*) calloc(1, sizeof(JitArena));
+    arena->base       = (uint8_t*) base;
+    arena->size       = size;
+    arena->generation = 1;
+    return arena;
+#else
+    return NULL;
+#endif
+}
+
+void tidy_jit(JitArena *arena)
+{
+    if (arena == NULL) return;
+    munmap(arena->base, arena->size);
+    free(arena);
+}
+
+uint32_t get_jit_generation(JitArena *arena)
+{
+    return arena->generation;
+}
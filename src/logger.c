@@ -44,7 +44,7 @@ void log_message
     }
 }
 
-void cpu_log(LoggingLevel level, const char *message, ...)
+void cpu_log(GbcMachine *gb, LoggingLevel level, const char *message, ...)
 {
     if (level == TEST || level == INFO || level == ERROR || override)
     {
@@ -59,10 +59,10 @@ void cpu_log(LoggingLevel level, const char *message, ...)
         }
 
         char time_buffer[50]; 
-        const char  *time = get_emu_time(time_buffer, sizeof(time_buffer));
+        const char  *time = get_emu_time(gb, time_buffer, sizeof(time_buffer));
     
         char state_buffer[100];
-        const char *state = get_cpu_state(state_buffer, sizeof(state_buffer));
+        const char *state = get_cpu_state(gb, state_buffer, sizeof(state_buffer));
     
         printf("\n[%s] | %s | %s ", level_str, time, state);
 
@@ -73,7 +73,7 @@ void cpu_log(LoggingLevel level, const char *message, ...)
     }
 }
 
-void joypad_log(LoggingLevel level, const char *message, ...)
+void joypad_log(GbcMachine *gb, LoggingLevel level, const char *message, ...)
 {
     if (level == TEST || level == INFO || level == ERROR || override)
     {
@@ -88,7 +88,7 @@ void joypad_log(LoggingLevel level, const char *message, ...)
         }
     
         char buffer[100];
-        const char *state = get_joypad_state(buffer, sizeof(buffer));
+        const char *state = get_joypad_state(gb, buffer, sizeof(buffer));
     
         printf("\n[%s] %s ", level_str, state);
 
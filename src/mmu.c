@@ -7,8 +7,13 @@
 #include "mmu.h"
 #include "cpu.h"
 #include "logger.h"
+#include "machine.h"
+#include "page.h"
+#include "ppu.h"
+#include "arena.h"
 #include "cart.h"
 #include "timer.h"
+#include "util.h"
 
 #define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
 
@@ -16,175 +21,326 @@
 #define CRAM_BANK_SIZE        128
 #define ECHO_RAM_OFFSET    0x2000
 #define DMA_DURATION          160
+#define HDMA_BLOCK_SIZE      0x10
+#define HDMA_BLOCK_DOTS        32 // CPU stall per block, 8 M-cycles at single speed and 16 at double.
 #define VRAM_BANK_SIZE     0x2000
 #define VRAM_BANK_QUANTITY      2
 #define WRAM_BANK_SIZE     0x1001
 #define WRAM_BANK_QUANTITY      8 
+#define WRAM_DIRTY_SHIFT        0
+#define VRAM_DIRTY_SHIFT        8
+#define PAGE_SHIFT             12
+#define PAGE_QUANTITY          16
 
-typedef struct
+typedef struct DMATransfer
 {
+    uint64_t       start; // gb->clock of the first blocked M-cycle.
+    uint64_t         end; // gb->clock the bus is released at.
     uint16_t src_address;
-    uint16_t dst_address;
-    uint8_t  cycles_left;
     bool          active;
 
 } DMATransfer;
 
-typedef struct
+typedef enum
+{
+    BUS_EXTERNAL = 0, // ROM, cartridge RAM and WRAM.
+    BUS_VIDEO    = 1, // VRAM.
+    BUS_OAM      = 2,
+    BUS_INTERNAL = 3  // IO, HRAM and IE, which the DMA never touches.
+
+} MemoryBus;
+
+typedef struct HDMATransfer
 {
     uint16_t src_address;
-    uint16_t dst_address;
-    uint16_t      length;
-    bool          active;
+    uint16_t dst_address; // Offset into the VRAM bank.
+    uint8_t  blocks_left;
+    bool          active; // HBlank transfer waiting for its next HBlank.
 
 } HDMATransfer;
 
-static HDMATransfer *hdma;
-static DMATransfer   *dma;
-static uint8_t    *memory;
-static uint8_t      *cram;
-static uint8_t     **vram;
-static uint8_t     **wram;
-static bool   bios_locked; 
-
-void init_memory()
+void init_memory(GbcMachine *gb)
 {
     // (65,536 Bytes) General Memory with some 'extra' room for lazy addressing.
-    memory = (uint8_t*)  malloc(MEMORY_SIZE * sizeof(uint8_t));
-    memset(memory, 0, MEMORY_SIZE); 
-    // Default Values to 0. 
+    gb->memory = (uint8_t*) arena_alloc(gb->arena, MEMORY_SIZE * sizeof(uint8_t));
+    // Default Values to 0, the arena comes zeroed.
 
     // (128 Bytes) CRAM Memory 
-    cram = (uint8_t*)  malloc(CRAM_BANK_SIZE * sizeof(uint8_t));
-    // Defaults to random RGB Values.
+    gb->cram = (uint8_t*) arena_alloc(gb->arena, CRAM_BANK_SIZE * sizeof(uint8_t));
+    // Defaults to 0 so every instance boots with the same palettes.
 
     // DMA State Handlers
-    dma  = (DMATransfer*)  malloc(sizeof(DMATransfer));
-    hdma = (HDMATransfer*) malloc(sizeof(HDMATransfer));
+    gb->dma  = (DMATransfer*)  arena_alloc(gb->arena, sizeof(DMATransfer));
+    gb->hdma = (HDMATransfer*) arena_alloc(gb->arena, sizeof(HDMATransfer));
 
     // (2 Banks ~8 KB) VRAM 
-    vram    = (uint8_t**) malloc(VRAM_BANK_QUANTITY * sizeof(uint8_t*));
-    vram[0] = (uint8_t*)  malloc(VRAM_BANK_SIZE     * sizeof(uint8_t));
-    memset(vram[0], 0, VRAM_BANK_SIZE);
-    vram[1] = (uint8_t*)  malloc(VRAM_BANK_SIZE     * sizeof(uint8_t));
-    memset(vram[1], 0, VRAM_BANK_SIZE);
+    gb->vram    = (uint8_t**) arena_alloc(gb->arena, VRAM_BANK_QUANTITY * sizeof(uint8_t*));
+    gb->vram[0] = alloc_page(VRAM_BANK_SIZE);
+    gb->vram[1] = alloc_page(VRAM_BANK_SIZE);
     // Defaut Values to 0, restrict access to bank 1 if not in CGB mode.
 
     // WRAM
-    wram = (uint8_t**) malloc(WRAM_BANK_QUANTITY * sizeof(uint8_t*));
+    gb->wram = (uint8_t**) arena_alloc(gb->arena, WRAM_BANK_QUANTITY * sizeof(uint8_t*));
     for (uint8_t i = 0; i < WRAM_BANK_QUANTITY; i++)
     { // (Static Bank 0, 7 Banks ~4 KB), (SVBK)
-        wram[i] = (uint8_t*) malloc(WRAM_BANK_SIZE * sizeof(uint8_t));
-        memset(wram[i], 0, WRAM_BANK_SIZE); // Default values to 0.
+        gb->wram[i] = alloc_page(WRAM_BANK_SIZE); // Default values to 0.
     }
+    // Banks are copy-on-write pages, shared with forks until written.
 
-    bios_locked = false; // Latches when written.
+    gb->bios_locked = false; // Latches when written.
+    gb->dirty_pages = 0;
+    remap_memory(gb);
 }
 
-void tidy_memory()
+void fork_memory(GbcMachine *gb, GbcMachine *parent)
 {
-    free(memory);
-    memory = NULL;
-
-    free(cram);
-    cram = NULL;
+    // The IO/HRAM page is written every dot, so sharing it would only buy a copy on the first step.
+    gb->memory = (uint8_t*) arena_alloc(gb->arena, MEMORY_SIZE * sizeof(uint8_t));
+    memcpy(gb->memory, parent->memory, MEMORY_SIZE);
+
+    gb->cram = (uint8_t*) arena_alloc(gb->arena, CRAM_BANK_SIZE * sizeof(uint8_t));
+    memcpy(gb->cram, parent->cram, CRAM_BANK_SIZE);
+
+    gb->dma  = (DMATransfer*)  arena_alloc(gb->arena, sizeof(DMATransfer));
+    gb->hdma = (HDMATransfer*) arena_alloc(gb->arena, sizeof(HDMATransfer));
+    (*gb->dma)  = (*parent->dma);
+    (*gb->hdma) = (*parent->hdma);
+    gb->dma->start = gb->clock + (parent->dma->start - parent->clock); // Clocks are per machine.
+    gb->dma->end   = gb->clock + (parent->dma->end   - parent->clock);
+
+    gb->vram = (uint8_t**) arena_alloc(gb->arena, VRAM_BANK_QUANTITY * sizeof(uint8_t*));
+    for (uint8_t i = 0; i < VRAM_BANK_QUANTITY; i++)
+    {
+        gb->vram[i] = share_page(parent->vram[i]);
+    }
+    gb->wram = (uint8_t**) arena_alloc(gb->arena, WRAM_BANK_QUANTITY * sizeof(uint8_t*));
+    for (uint8_t i = 0; i < WRAM_BANK_QUANTITY; i++)
+    {
+        gb->wram[i] = share_page(parent->wram[i]);
+    }
 
-    free(dma);
-    dma = NULL;
-    free(hdma);
-    hdma = NULL;
+    gb->bios_locked     = parent->bios_locked;
+    gb->dirty_pages     = 0;
+    parent->dirty_pages = 0; // The parent's banks are shared now too.
+    remap_memory(gb);
+    remap_memory(parent);
+}
 
-    free(vram[0]);
-    vram[0] = NULL;
-    free(vram[1]);
-    vram[1] = NULL;
-    free(vram);
-    vram = NULL;
+void tidy_memory(GbcMachine *gb)
+{
+    // Only the banks are ours to release, everything else goes with the arena.
+    gb->memory = NULL;
+    gb->cram   = NULL;
+    gb->dma    = NULL;
+    gb->hdma   = NULL;
+
+    release_page(gb->vram[0]);
+    gb->vram[0] = NULL;
+    release_page(gb->vram[1]);
+    gb->vram[1] = NULL;
+    gb->vram    = NULL;
 
     for (int i = 0; i < WRAM_BANK_QUANTITY; i++)
     {
-        free(wram[i]);
-        wram[i] = NULL;
+        release_page(gb->wram[i]);
+        gb->wram[i] = NULL;
     }
-    free(wram);
-    wram = NULL;
+    gb->wram = NULL;
 }
 
-/* DMA METHODOLOGY */
+/* COPY-ON-WRITE */
 
-static void start_dma(uint8_t dma_val)
+static uint8_t *own_bank(GbcMachine *gb, uint8_t **bank, uint8_t dirty_bit)
 {
-    memory[DMA] = dma_val;
-    dma->src_address  = dma_val * 0x0100;
-    dma->dst_address  = OAM_ADDRESS_START; 
-    dma->cycles_left  = DMA_DURATION;
-    dma->active       = true;
+    uint16_t mask = (uint16_t) (1 << dirty_bit);
+    if (!(gb->dirty_pages & mask))
+    { // First write since the last fork, the page may still be shared.
+        (*bank) = own_page(*bank);
+        gb->dirty_pages |= mask;
+        remap_memory(gb);
+    }
+    return (*bank);
 }
 
-static void start_hdma(uint8_t hdma5)
+uint16_t get_dirty_pages(GbcMachine *gb)
 {
-    memory[HDMA5]     = hdma5;
-    // SRC: HDMA1 (High), HDMA2 (Low)
-    // Lower 4 are 0.
-    hdma->src_address = (memory[HDMA1] << BYTE) | (memory[HDMA2] & 0xF0); 
-    // DST: HDMA3 (High), HDMA4 (Low)
-    // Only bits 12 - 4 are considered. 
-    hdma->dst_address = 0x8000 | ((memory[HDMA3] & 0x1F) << BYTE) | (memory[HDMA4] & 0xF0);
-    // Determine the length of transfer.
-    // L = (R + 1) * $10
-    hdma->length      = ((hdma5 & 0x7F) + 1) * 0x10;
-    // Let's Yoink bit 7
-    // 0 = General-Purpose DMA, 1 = HBlank DMA
-    hdma->active      = hdma5 & BIT_7_MASK;
-    if (hdma->active)
-    { // General-Purpose DMA
-
-        for (int i = 0; i < hdma->length; i++)
-        { // Transfered all at once.
-            memory[hdma->dst_address + i] = memory[hdma->src_address + i];
-        }
-        // Sets hdma5 to $FF.
-        memory[HDMA5] = 0xFF; 
-    }
-    // HBlank DMA
+    return gb->dirty_pages;
+}
+
+/* PAGE TABLE */
 
-    // Transfer Rate: $10 Bytes / HBlank
-    // Transfer Timing: 32 dots. 
-    // Halted during invdividual transfers.
-    // Blocking, enforce with flag.
-    // Transfer is halted alongside cpu. 
-    // Reading returns remaining length.
-    // Value of $FF indicataed transfer has completed. 
-    // Can terminate early by writing 0 to Bit 7 of HDMA5. 
-    // Stopping transfer does not set HDMA1-4 to $FF.
+static uint8_t get_wram_bank(GbcMachine *gb) // Bank behind $D000-$DFFF.
+{
+    uint8_t svbk = gb->memory[SVBK] & LOWER_3_MASK;
+    return svbk ? svbk : 1;
 }
 
-void check_dma()
+static void map_wram(GbcMachine *gb, uint8_t page, uint8_t bank)
 {
-    if(dma->active == 0) return;
-    if(dma->cycles_left > 0)
+    bool writable = (gb->dirty_pages & (1 << (WRAM_DIRTY_SHIFT + bank))) && !gb->code_in_ram;
+    gb->read_pages[page]  = gb->wram[bank];
+    gb->write_pages[page] = writable ? gb->wram[bank] : NULL; // Shared banks and cached code take the handlers.
+}
+
+void remap_memory(GbcMachine *gb)
+{
+    memset(gb->read_pages,  0, sizeof(gb->read_pages));
+    memset(gb->write_pages, 0, sizeof(gb->write_pages));
+
+    uint8_t vbk = gb->memory[VBK] ? 1 : 0; // As read_memory() sees it.
+    for (uint8_t page = 0; page < 2; page++)
+    { // VRAM writes stay with the handler, the PPU has to catch up first.
+        gb->read_pages[(VRAM_ADDRESS_START >> PAGE_SHIFT) + page] = gb->vram[vbk] + (page * MEMORY_PAGE_SIZE);
+    }
+    map_wram(gb, WRAM_ZERO_ADDRESS_START >> PAGE_SHIFT, 0);
+    map_wram(gb, WRAM_N_ADDRESS_START >> PAGE_SHIFT, get_wram_bank(gb));
+    map_wram(gb, ECHO_RAM_ADDRESS_START >> PAGE_SHIFT, 0);
+    // $F000-$FFFF mixes echo RAM, OAM, IO and HRAM, so it always takes the handlers.
+
+    if (gb->cart == NULL) return; // Not loaded yet.
+    for (uint8_t page = 0; page < PAGE_QUANTITY; page++)
     {
-        uint8_t src_val = read_memory(dma->src_address++);
-        write_memory(dma->dst_address++, src_val);
-        dma->cycles_left -= 1;  
+        uint16_t address = page << PAGE_SHIFT;
+        if ((address > BANK_N_ADDRESS_END) && ((address < EXT_RAM_ADDRESS_START) || (address > EXT_RAM_ADDRESS_END))) continue;
+        gb->read_pages[page]  = get_cart_read_page(gb, address);
+        gb->write_pages[page] = get_cart_write_page(gb, address);
     }
-    if(dma->cycles_left <= 0)
+}
+
+/* DMA METHODOLOGY */
+
+static MemoryBus get_bus(uint16_t address)
+{
+    if (address >= IO_REGISTERS_START) return BUS_INTERNAL;
+    if (address >= OAM_ADDRESS_START)  return BUS_OAM;
+    if ((address >= VRAM_ADDRESS_START) && (address <= VRAM_ADDRESS_END)) return BUS_VIDEO;
+    return BUS_EXTERNAL;
+}
+
+static uint8_t read_bus(GbcMachine *gb, uint16_t address);
+
+static void start_dma(GbcMachine *gb, uint8_t dma_val)
+{
+    uint16_t source = dma_val << BYTE;
+    if (source >= ECHO_RAM_ADDRESS_START) source -= ECHO_RAM_OFFSET; // $E0-$FF see WRAM, like the echo.
+
+    sync_ppu(gb); // Lines up to now scanned the old OAM.
+    uint8_t       *oam = &gb->memory[OAM_ADDRESS_START];
+    const uint8_t *page = gb->read_pages[source >> PAGE_SHIFT];
+    if (page) memcpy(oam, page + (source & (MEMORY_PAGE_SIZE - 1)), DMA_DURATION);
+    else for (uint8_t i = 0; i < DMA_DURATION; i++) oam[i] = read_bus(gb, source + i);
+
+    uint8_t scaler = get_machine_cycle_scaler(gb);
+    gb->memory[DMA]      = dma_val;
+    gb->dma->src_address = source;
+    gb->dma->start       = gb->clock + scaler; // One M-cycle of setup before the bus is taken.
+    gb->dma->end         = gb->dma->start + (DMA_DURATION * scaler);
+    gb->dma->active      = true;
+    reset_code_cursor(gb); // Cached code outside HRAM would skip the conflicts.
+    refresh_event(gb, EVENT_DMA);
+}
+
+static bool dma_conflict(GbcMachine *gb, uint16_t address) // The CPU and the DMA want the same bus this M-cycle.
+{
+    if ((gb->clock < gb->dma->start) || (gb->clock >= gb->dma->end)) return false;
+    MemoryBus bus = get_bus(address);
+    return (bus == BUS_OAM) || (bus == get_bus(gb->dma->src_address));
+}
+
+static uint8_t get_dma_byte(GbcMachine *gb, uint16_t address) // What a conflicting read sees.
+{
+    if (get_bus(address) == BUS_OAM) return 0xFF;
+    uint32_t index = (uint32_t) ((gb->clock - gb->dma->start) * DMA_DURATION / (gb->dma->end - gb->dma->start));
+    return gb->memory[OAM_ADDRESS_START + index]; // The byte in flight, already copied.
+}
+
+static void copy_hdma_blocks(GbcMachine *gb, uint8_t blocks) // Bank-resolved, one memcpy per block.
+{
+    HDMATransfer *hdma = gb->hdma;
+    uint8_t       bank = gb->memory[VBK] ? 1 : 0;
+    uint8_t      *vram = own_bank(gb, &gb->vram[bank], VRAM_DIRTY_SHIFT + bank);
+    for (uint8_t block = 0; block < blocks; block++)
     {
-        dma->active = false;
+        const uint8_t *page = gb->read_pages[hdma->src_address >> PAGE_SHIFT];
+        uint8_t       *dest = vram + hdma->dst_address;
+        if (page) memcpy(dest, page + (hdma->src_address & (MEMORY_PAGE_SIZE - 1)), HDMA_BLOCK_SIZE);
+        else for (uint8_t i = 0; i < HDMA_BLOCK_SIZE; i++) dest[i] = read_bus(gb, hdma->src_address + i);
+        invalidate_tiles(gb, bank, hdma->dst_address, HDMA_BLOCK_SIZE);
+
+        hdma->src_address += HDMA_BLOCK_SIZE;
+        hdma->dst_address  = (hdma->dst_address + HDMA_BLOCK_SIZE) & (VRAM_BANK_SIZE - HDMA_BLOCK_SIZE);
     }
+    hdma->blocks_left -= blocks;
+    stall_cpu(gb, blocks * (HDMA_BLOCK_DOTS / get_machine_cycle_scaler(gb)));
 }
 
-bool dma_active()
+static void start_hdma(GbcMachine *gb, uint8_t hdma5)
 {
-    return (dma->active);
+    HDMATransfer *hdma = gb->hdma;
+    if (hdma->active && !(hdma5 & BIT_7_MASK))
+    { // Stopped between blocks, what is left reads back with bit 7 set.
+        hdma->active      = false;
+        gb->memory[HDMA5] = BIT_7_MASK | (hdma->blocks_left - 1);
+        refresh_event(gb, EVENT_PPU);
+        return;
+    }
+    // SRC: HDMA1 (High), HDMA2 (Low), lower 4 bits ignored.
+    hdma->src_address = (gb->memory[HDMA1] << BYTE) | (gb->memory[HDMA2] & 0xF0);
+    // DST: HDMA3 (High), HDMA4 (Low), only bits 12 - 4 count.
+    hdma->dst_address = ((gb->memory[HDMA3] & 0x1F) << BYTE) | (gb->memory[HDMA4] & 0xF0);
+    // L = (R + 1) * $10
+    hdma->blocks_left = (hdma5 & LOWER_7_MASK) + 1;
+
+    if (!(hdma5 & BIT_7_MASK))
+    { // General-Purpose DMA, all at once with the CPU stalled throughout.
+        sync_ppu(gb);
+        copy_hdma_blocks(gb, hdma->blocks_left);
+        hdma->active      = false;
+        gb->memory[HDMA5] = 0xFF;
+        return;
+    }
+    // HBlank DMA, one block at the start of every HBlank.
+    hdma->active      = true;
+    gb->memory[HDMA5] = hdma->blocks_left - 1; // Bit 7 clear while active.
+    refresh_event(gb, EVENT_PPU); // HBlanks are deadlines now.
+}
+
+void run_hblank_dma(GbcMachine *gb)
+{
+    HDMATransfer *hdma = gb->hdma;
+    if (!hdma->active) return;
+    copy_hdma_blocks(gb, 1);
+    hdma->active      = (hdma->blocks_left > 0);
+    gb->memory[HDMA5] = hdma->active ? (hdma->blocks_left - 1) : 0xFF;
+}
+
+bool hdma_active(GbcMachine *gb)
+{
+    return gb->hdma->active;
+}
+
+void check_dma(GbcMachine *gb)
+{
+    if (gb->dma->active && (gb->clock >= gb->dma->end)) gb->dma->active = false;
+}
+
+bool dma_active(GbcMachine *gb)
+{
+    return (gb->dma->active);
+}
+
+uint32_t get_dma_dots(GbcMachine *gb)
+{
+    if (!gb->dma->active) return UINT32_MAX;
+    return (gb->dma->end > gb->clock) ? (uint32_t) (gb->dma->end - gb->clock) : 0;
 }
 
 /* MEMORY ACCESS  */
 
-uint8_t read_joypad()
+uint8_t read_joypad(GbcMachine *gb)
 {
-    JoypadState *joypad = get_joypad();
-    uint8_t select = memory[JOYP] & 0x30;
+    JoypadState *joypad = get_joypad(gb);
+    uint8_t select = gb->memory[JOYP] & 0x30;
     uint8_t result = select | 0x0F;
 
     if ((select & BIT_5_MASK) == 0) // Action buttons selected
@@ -203,12 +359,12 @@ uint8_t read_joypad()
         if (joypad->DOWN)  result &= ~DOWN_BUTTON_MASK;
     }
 
-    joypad_log(DEBUG, "|| (%02X):(%02X)", select, result);
+    joypad_log(gb, DEBUG, "|| (%02X):(%02X)", select, result);
     return result;
 }
 
 
-uint8_t io_memory_read(uint16_t address)
+uint8_t io_memory_read(GbcMachine *gb, uint16_t address)
 {
     if ((address < IO_REGISTERS_START) || (address > IO_REGISTERS_END))
     {
@@ -217,14 +373,16 @@ uint8_t io_memory_read(uint16_t address)
     }
     switch (address)
     {
-        case JOYP: return read_joypad();
-        case BCPD: return cram[(memory[BCPS] & LOWER_6_MASK)];
-        case OCPD: return cram[(memory[OCPS] & LOWER_6_MASK) + 0x40];
-        default:   return memory[address];
+        case JOYP: return read_joypad(gb);
+        case STAT:
+        case LY:   sync_ppu(gb); return gb->memory[address]; // Written by the PPU, which may lag behind.
+        case BCPD: return gb->cram[(gb->memory[BCPS] & LOWER_6_MASK)];
+        case OCPD: return gb->cram[(gb->memory[OCPS] & LOWER_6_MASK) + 0x40];
+        default:   return gb->memory[address];
     }
 }
 
-void io_memory_write(uint16_t address, uint8_t value)
+void io_memory_write(GbcMachine *gb, uint16_t address, uint8_t value)
 {
     if ((address < IO_REGISTERS_START) || (address > IO_REGISTERS_END))
     {
@@ -234,99 +392,133 @@ void io_memory_write(uint16_t address, uint8_t value)
     switch(address)
     {
         case JOYP:
-            memory[address] = (value & 0x30);
+            gb->memory[address] = (value & 0x30);
             break;
         case DIV:
-            clear_sys();
+            clear_sys(gb);
             break;
         case TIMA:
-            write_tima(value);
+            write_tima(gb, value);
             break;
         case TAC:
-            write_tac(value);
+            write_tac(gb, value);
             break;
         case IFR:
-            write_ifr(value);
+            write_ifr(gb, value);
             break;
         case DMA:
-            start_dma(value);
+            start_dma(gb, value);
             break;
         case KEY1:
-            if (is_gbc()) memory[address] = value; 
+            if (is_gbc(gb)) gb->memory[address] = value; 
             break;
         case VBK:
-            if (is_gbc()) memory[address] = value; 
+            if (is_gbc(gb)) gb->memory[address] = value; 
+            remap_memory(gb);
             break;
         case BIOS:
-            if (!bios_locked)
+            if (!gb->bios_locked)
             {
-                memory[address] = value;
-                bios_locked = true;
+                gb->memory[address] = value;
+                gb->bios_locked  = true;
+                gb->boot_pending = (gb->boot_snapshot == NULL);
+                reset_code_cursor(gb);
+                remap_memory(gb);
+                refresh_event(gb, EVENT_BOOT);
             }
             break;
         case HDMA1:
-            if (is_gbc()) memory[address] = value; 
+            if (is_gbc(gb)) gb->memory[address] = value; 
             break;
         case HDMA2:
-            if (is_gbc()) memory[address] = value; 
+            if (is_gbc(gb)) gb->memory[address] = value; 
             break;
         case HDMA3:
-            if (is_gbc()) memory[address] = value; 
+            if (is_gbc(gb)) gb->memory[address] = value; 
             break;
         case HDMA4:
-            if (is_gbc()) memory[address] = value; 
+            if (is_gbc(gb)) gb->memory[address] = value; 
             break;
         case HDMA5:
-            if (is_gbc()) start_hdma(value);
+            if (is_gbc(gb)) start_hdma(gb, value);
             break;
         case RP:
-            if (is_gbc()) memory[address] = value;
+            if (is_gbc(gb)) gb->memory[address] = value;
             break;
         case BCPS:
-            if (is_gbc()) memory[address] = value;
+            if (is_gbc(gb)) gb->memory[address] = value;
             break;
         case BCPD:
-            if (is_gbc())
+            if (is_gbc(gb))
             {
-                uint8_t index = memory[BCPS] & LOWER_6_MASK;
-                cram[index] = value;
+                sync_ppu(gb);
+                uint8_t index = gb->memory[BCPS] & LOWER_6_MASK;
+                gb->cram[index] = value;
                 uint8_t inc_index = (index + 1) & LOWER_6_MASK;
-                if(memory[BCPS] & BIT_7_MASK) 
-                    memory[BCPS] = (memory[BCPS] & BIT_7_MASK) | (inc_index);
+                if(gb->memory[BCPS] & BIT_7_MASK) 
+                    gb->memory[BCPS] = (gb->memory[BCPS] & BIT_7_MASK) | (inc_index);
             }
             break;
         case OCPS:
-            if (is_gbc()) memory[address] = value;
+            if (is_gbc(gb)) gb->memory[address] = value;
             break;
         case OCPD:
-            if (is_gbc())
+            if (is_gbc(gb))
             {
-                uint8_t index = memory[OCPS] & LOWER_6_MASK;
-                cram[index + 0x40] = value;
+                sync_ppu(gb);
+                uint8_t index = gb->memory[OCPS] & LOWER_6_MASK;
+                gb->cram[index + 0x40] = value;
                 uint8_t inc_index = (index + 1) & LOWER_6_MASK;
-                if (memory[OCPS] & BIT_7_MASK)
-                    memory[OCPS] = (memory[OCPS] & BIT_7_MASK) | inc_index;
+                if (gb->memory[OCPS] & BIT_7_MASK)
+                    gb->memory[OCPS] = (gb->memory[OCPS] & BIT_7_MASK) | inc_index;
             }
             break;
         case OPRI:
-            if (is_gbc()) memory[address] = value;
+            if (is_gbc(gb)) gb->memory[address] = value;
             break;
         case SVBK:
-            if (is_gbc()) memory[address] = value;
+            if (is_gbc(gb)) gb->memory[address] = value;
+            reset_code_cursor(gb);
+            remap_memory(gb);
             break;
         case PCM12:
-            if (is_gbc()) memory[address] = value;
+            if (is_gbc(gb)) gb->memory[address] = value;
             break;
         case PCM34:
-            if (is_gbc()) memory[address] = value;
+            if (is_gbc(gb)) gb->memory[address] = value;
+            break;
+        case LCDC:
+        case SCY:
+        case SCX:
+        case BGP:
+        case OBP0:
+        case OBP1:
+        case WY:
+        case WX:
+            sync_ppu(gb); // Lines up to now are drawn with the old value.
+            gb->memory[address] = value;
+            break;
+        case STAT:
+            sync_ppu(gb);
+            gb->memory[address] = (value & ~LOWER_3_MASK) | (gb->memory[address] & LOWER_3_MASK); // Mode and LY=LYC are read-only.
+            refresh_stat_line(gb);
+            refresh_event(gb, EVENT_PPU);
+            break;
+        case LY: // Read-only.
+            break;
+        case LYC:
+            sync_ppu(gb);
+            gb->memory[address] = value;
+            refresh_stat_line(gb);
+            refresh_event(gb, EVENT_PPU);
             break;
         default:
-            memory[address] = value;
+            gb->memory[address] = value;
             break;
     }
 }
 
-uint8_t read_vram(uint8_t bank, uint16_t address)
+uint8_t read_vram(GbcMachine *gb, uint8_t bank, uint16_t address)
 {
     if ((address < VRAM_ADDRESS_START) || (address > VRAM_ADDRESS_END))
     {
@@ -334,119 +526,152 @@ uint8_t read_vram(uint8_t bank, uint16_t address)
         return 0xFF;
     }
     address -= (uint16_t) VRAM_ADDRESS_START;
-    return vram[bank][address];
+    return gb->vram[bank][address];
 }
 
-uint8_t read_cram(bool is_obj, uint8_t palette_index, uint8_t color_id, uint8_t index)
+uint8_t read_cram(GbcMachine *gb, bool is_obj, uint8_t palette_index, uint8_t color_id, uint8_t index)
 {
     uint8_t base   = is_obj ? 0x40 : 0x00;
     uint8_t offset = (palette_index << 3) | (color_id << 1);
-    return cram[base + offset + index];
+    return gb->cram[base + offset + index];
+}
+
+uint8_t read_memory(GbcMachine *gb, uint16_t address)
+{
+    if (gb->owed_cycles) sync_machine_cycles(gb); // FAST_EXECUTION ran ahead, see the bus as of now.
+    if (gb->dma->active && dma_conflict(gb, address)) return get_dma_byte(gb, address);
+    return read_bus(gb, address);
 }
 
-uint8_t read_memory(uint16_t address)
+static uint8_t read_bus(GbcMachine *gb, uint16_t address) // What the CPU would see with the bus to itself.
 {
+    const uint8_t *page = gb->read_pages[address >> PAGE_SHIFT];
+    if (page) return page[address & (MEMORY_PAGE_SIZE - 1)];
+
     if (address <= BANK_N_ADDRESS_END)
     {
-        return read_rom_memory(address); 
+        return read_rom_memory(gb, address); 
     }
     else if (address <= VRAM_ADDRESS_END)
     {
         uint8_t value = 
-        memory[VBK] ? read_vram(1, address) : read_vram(0, address);
+        gb->memory[VBK] ? read_vram(gb, 1, address) : read_vram(gb, 0, address);
         return value;
     }
     else if (address <= EXT_RAM_ADDRESS_END)
     {
-        return read_rom_memory(address);
+        return read_rom_memory(gb, address);
     }
     else if (address <= WRAM_ZERO_ADDRESS_END)
     {
         address -= (uint16_t) WRAM_ZERO_ADDRESS_START;
-        return wram[0][address];
+        return gb->wram[0][address];
     }
     else if (address <= WRAM_N_ADDRESS_END)
     {  
-        uint8_t svbk = memory[SVBK] & LOWER_3_MASK;
+        uint8_t svbk = gb->memory[SVBK] & LOWER_3_MASK;
         if (!svbk) svbk = 1;
         address -= (uint16_t) WRAM_N_ADDRESS_START;
-        return wram[svbk][address];
+        return gb->wram[svbk][address];
     }
     else if (address <= ECHO_RAM_ADDRESS_END)
     {
-        return read_memory(address - ECHO_RAM_OFFSET);
+        return read_bus(gb, address - ECHO_RAM_OFFSET);
     }
     else if (address <= OAM_ADDRESS_END)
     {
-        return memory[address];
+        return gb->memory[address];
     }
     else if (address <= NOT_USABLE_END)
     {
-        return memory[address];
+        return gb->memory[address];
     }
     else if (address <= IO_REGISTERS_END)
     {
-        return io_memory_read(address);
+        return io_memory_read(gb, address);
     }
     else if (address <= INTERRUPT_ENABLE_ADDRESS)
     { // Implicit High RAM
-        return memory[address];
+        return gb->memory[address];
     }
     LOG_MESSAGE(ERROR, "Attempted Read from unmapped address: %04X", address);
     return 0xFF; // Return garbage if we ever get here.
 }
 
-void write_memory(uint16_t address, uint8_t value)
+void write_memory(GbcMachine *gb, uint16_t address, uint8_t value)
 { 
+    if (gb->owed_cycles) sync_machine_cycles(gb);
+    if (gb->dma->active && dma_conflict(gb, address)) return; // Lost to the DMA.
+    uint8_t *page = gb->write_pages[address >> PAGE_SHIFT];
+    if (page)
+    {
+        page[address & (MEMORY_PAGE_SIZE - 1)] = value;
+        return;
+    }
+
     if (address <= BANK_N_ADDRESS_END)
     {
-        write_rom_memory(address, value);
+        write_rom_memory(gb, address, value);
+        reset_code_cursor(gb); // MBC registers live here.
+        remap_memory(gb);
         return;
     }
     else if (address <= VRAM_ADDRESS_END)
     {
-        uint8_t bank = (is_gbc() && memory[VBK]) ? 1 : 0;
+        sync_ppu(gb);
+        uint8_t bank = (is_gbc(gb) && gb->memory[VBK]) ? 1 : 0;
         address -= (uint16_t) VRAM_ADDRESS_START;
-        vram[bank][address] = value;
+        own_bank(gb, &gb->vram[bank], VRAM_DIRTY_SHIFT + bank)[address] = value;
+        invalidate_tiles(gb, bank, address, 1);
         return;
     }
     else if (address <= EXT_RAM_ADDRESS_END)
     {
-        write_rom_memory(address, value);
+        write_rom_memory(gb, address, value);
+        remap_memory(gb); // The first write takes a private copy of the RAM.
         return;
     }
     else if (address <= WRAM_ZERO_ADDRESS_END)
     {
+        if (gb->code_in_ram) invalidate_code(gb, address, 0);
         address -= (uint16_t) WRAM_ZERO_ADDRESS_START;
-        wram[0][address] = value;
+        own_bank(gb, &gb->wram[0], WRAM_DIRTY_SHIFT)[address] = value;
         return;
     }
     else if (address <= WRAM_N_ADDRESS_END)
     { // Banks 1-7
-        uint8_t svbk = (memory[SVBK] & LOWER_3_MASK);
+        uint8_t svbk = (gb->memory[SVBK] & LOWER_3_MASK);
         if (!svbk) svbk = 1;
+        if (gb->code_in_ram) invalidate_code(gb, address, svbk);
         address -= (uint16_t) WRAM_N_ADDRESS_START;
-        wram[svbk][address] = value;
+        own_bank(gb, &gb->wram[svbk], WRAM_DIRTY_SHIFT + svbk)[address] = value;
         return;
     }
     else if (address <= ECHO_RAM_ADDRESS_END)
     {
-        write_memory(address - ECHO_RAM_OFFSET, value);
+        write_memory(gb, address - ECHO_RAM_OFFSET, value);
+        return;
+    }
+    else if (address <= OAM_ADDRESS_END)
+    {
+        sync_ppu(gb);
+        gb->memory[address] = value;
         return;
     }
     else if ((address >= IO_REGISTERS_START) && (address <= IO_REGISTERS_END))
-    { // Bypass 'not usable' memory range
-        io_memory_write(address, value);
+    { // Bypass 'not usable' gb->memory range
+        io_memory_write(gb, address, value);
         return;
     }
     else if (address <= HIGH_RAM_ADDRESS_END)
     { // implicit High RAM
-        memory[address] = value;
+        if (gb->code_in_ram) invalidate_code(gb, address, 0);
+        gb->memory[address] = value;
         return;
     }
     else if (address == INTERRUPT_ENABLE_ADDRESS)
     {
-        memory[address] = value;
+        gb->memory[address] = value;
         return;
     }
     LOG_MESSAGE(ERROR, "Attempted write to invalid address: %04X", address);
@@ -454,24 +679,32 @@ void write_memory(uint16_t address, uint8_t value)
 
 /* DEBUG */
 
-uint8_t *get_memory()
+uint8_t *get_memory(GbcMachine *gb)
 {
-    return memory;
+    return gb->memory;
 }
 
-uint8_t *get_memory_pointer(uint16_t address)
+void get_wram_view(GbcMachine *gb, uint8_t *dest)
 {
-    return &(memory[address]);
+    uint8_t svbk = gb->memory[SVBK] & LOWER_3_MASK;
+    if (!svbk) svbk = 1;
+    memcpy(dest, gb->wram[0], WRAM_VIEW_SIZE / 2);
+    memcpy(dest + (WRAM_VIEW_SIZE / 2), gb->wram[svbk], WRAM_VIEW_SIZE / 2);
 }
 
-void print_vram(uint16_t start, uint16_t end, bool bank)
+uint8_t *get_memory_pointer(GbcMachine *gb, uint16_t address)
+{
+    return &(gb->memory[address]);
+}
+
+void print_vram(GbcMachine *gb, uint16_t start, uint16_t end, bool bank)
 {
     if (bank)
     {
         LOG_MESSAGE(INFO, "%s", "VRAM BANK 1 \n ----------------------------------");
         for (int i = start; i <= end; i++)
         {
-            LOG_MESSAGE(INFO, "%04X: %02X", i, vram[1][i - VRAM_ADDRESS_START]);
+            LOG_MESSAGE(INFO, "%04X: %02X", i, gb->vram[1][i - VRAM_ADDRESS_START]);
         }
     }
     else
@@ -479,7 +712,67 @@ void print_vram(uint16_t start, uint16_t end, bool bank)
         LOG_MESSAGE(INFO, "%s", "VRAM BANK 0 \n ----------------------------------");
         for (int i = start; i <= end; i++)
         {
-            LOG_MESSAGE(INFO, "%04X: %02X", i, vram[0][i - VRAM_ADDRESS_START]);
+            LOG_MESSAGE(INFO, "%04X: %02X", i, gb->vram[0][i - VRAM_ADDRESS_START]);
         }
     }
-}
\ No newline at end of file
+}
+
+/* SNAPSHOTS */
+
+size_t get_memory_snapshot_size(GbcMachine *gb)
+{
+    return MEMORY_SIZE + CRAM_BANK_SIZE +
+           (VRAM_BANK_QUANTITY * VRAM_BANK_SIZE) +
+           (WRAM_BANK_QUANTITY * WRAM_BANK_SIZE) +
+           (2 * sizeof(int64_t)) + sizeof(uint16_t) + sizeof(bool) + // DMATransfer
+           sizeof(HDMATransfer) + sizeof(bool);
+}
+
+uint8_t *save_memory_snapshot(GbcMachine *gb, uint8_t *dest)
+{
+    dest = pack_bytes(dest, gb->memory, MEMORY_SIZE);
+    dest = pack_bytes(dest, gb->cram, CRAM_BANK_SIZE);
+    for (int i = 0; i < VRAM_BANK_QUANTITY; i++)
+    {
+        dest = pack_bytes(dest, gb->vram[i], VRAM_BANK_SIZE);
+    }
+    for (int i = 0; i < WRAM_BANK_QUANTITY; i++)
+    {
+        dest = pack_bytes(dest, gb->wram[i], WRAM_BANK_SIZE);
+    }
+    int64_t start = (int64_t) (gb->dma->start - gb->clock); // Relative, the loading machine has its own clock.
+    int64_t   end = (int64_t) (gb->dma->end   - gb->clock);
+    dest = pack_bytes(dest, &start,                sizeof(int64_t));
+    dest = pack_bytes(dest, &end,                  sizeof(int64_t));
+    dest = pack_bytes(dest, &gb->dma->src_address, sizeof(uint16_t));
+    dest = pack_bytes(dest, &gb->dma->active,      sizeof(bool));
+    dest = pack_bytes(dest, gb->hdma, sizeof(HDMATransfer));
+    dest = pack_bytes(dest, &gb->bios_locked, sizeof(bool));
+    return dest;
+}
+
+const uint8_t *load_memory_snapshot(GbcMachine *gb, const uint8_t *src)
+{
+    src = unpack_bytes(src, gb->memory, MEMORY_SIZE);
+    src = unpack_bytes(src, gb->cram, CRAM_BANK_SIZE);
+    for (int i = 0; i < VRAM_BANK_QUANTITY; i++)
+    {
+        src = unpack_bytes(src, own_bank(gb, &gb->vram[i], VRAM_DIRTY_SHIFT + i), VRAM_BANK_SIZE);
+        invalidate_tiles(gb, i, 0, VRAM_BANK_SIZE);
+    }
+    for (int i = 0; i < WRAM_BANK_QUANTITY; i++)
+    {
+        src = unpack_bytes(src, own_bank(gb, &gb->wram[i], WRAM_DIRTY_SHIFT + i), WRAM_BANK_SIZE);
+    }
+    int64_t start, end;
+    src = unpack_bytes(src, &start,                sizeof(int64_t));
+    src = unpack_bytes(src, &end,                  sizeof(int64_t));
+    src = unpack_bytes(src, &gb->dma->src_address, sizeof(uint16_t));
+    src = unpack_bytes(src, &gb->dma->active,      sizeof(bool));
+    gb->dma->start = gb->clock + start;
+    gb->dma->end   = gb->clock + end;
+    src = unpack_bytes(src, gb->hdma, sizeof(HDMATransfer));
+    src = unpack_bytes(src, &gb->bios_locked, sizeof(bool));
+    remap_memory(gb);
+    return src;
+}
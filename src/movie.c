@@ -0,0 +1,273 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cart.h"
+#include "emulator.h"
+#include "logger.h"
+#include "machine.h"
+#include "movie.h"
+#include "snapshot.h"
+#include "util.h"
+
+#define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
+#define MOVIE_RUN_SIZE     3 // buttons + 16-bit frame count, packed.
+#define MOVIE_RUN_MAX      UINT16_MAX
+#define DEFAULT_RUN_CAPACITY 64
+
+typedef struct
+{
+    uint8_t  buttons;
+    uint16_t  frames;
+
+} MovieRun;
+
+typedef struct Movie
+{
+    uint32_t      rom_hash;
+    uint32_t   frame_count;
+    uint8_t  start_buttons;
+
+    uint8_t      *snapshot; // NULL when the movie starts from power-on.
+    size_t   snapshot_size;
+
+    MovieRun         *runs;
+    uint32_t     run_count;
+    uint32_t  run_capacity;
+
+} Movie;
+
+static Movie *alloc_movie(uint32_t run_capacity)
+{
+    Movie *movie        = (Movie*) calloc(1, sizeof(Movie));
+    movie->runs         = (MovieRun*) malloc(run_capacity * sizeof(MovieRun));
+    movie->run_capacity = run_capacity;
+    return movie;
+}
+
+static void push_run(Movie *movie, uint8_t buttons)
+{
+    if (movie->run_count == movie->run_capacity)
+    {
+        movie->run_capacity *= 2;
+        movie->runs = (MovieRun*) realloc(movie->runs, movie->run_capacity * sizeof(MovieRun));
+    }
+    movie->runs[movie->run_count].buttons = buttons;
+    movie->runs[movie->run_count].frames  = 0;
+    movie->run_count += 1;
+}
+
+Movie *init_movie(GbcMachine *gb, bool from_snapshot)
+{
+    Movie *movie = alloc_movie(DEFAULT_RUN_CAPACITY);
+    if (from_snapshot)
+    {
+        movie->snapshot_size = gbc_snapshot_size(gb);
+        movie->snapshot      = (uint8_t*) malloc(movie->snapshot_size);
+        gbc_snapshot_save(gb, movie->snapshot, movie->snapshot_size);
+    }
+    else
+    {
+        power_cycle_emulator(gb);
+    }
+    movie->rom_hash      = get_rom_hash(gb);
+    movie->start_buttons = get_joypad_buttons(gb);
+    return movie;
+}
+
+void tidy_movie(Movie *movie)
+{
+    if (movie == NULL) return;
+    free(movie->snapshot);
+    free(movie->runs);
+    free(movie);
+}
+
+void record_movie_frame(Movie *movie, GbcMachine *gb)
+{
+    uint8_t  buttons = get_joypad_buttons(gb);
+    MovieRun    *run = movie->run_count ? &movie->runs[movie->run_count - 1] : NULL;
+    if ((run == NULL) || (run->buttons != buttons) || (run->frames == MOVIE_RUN_MAX))
+    {
+        push_run(movie, buttons);
+        run = &movie->runs[movie->run_count - 1];
+    }
+    run->frames        += 1;
+    movie->frame_count += 1;
+}
+
+uint32_t get_movie_length(Movie *movie)
+{
+    return movie->frame_count;
+}
+
+static bool rewind_movie(Movie *movie, GbcMachine *gb)
+{
+    if (movie->rom_hash != get_rom_hash(gb))
+    {
+        LOG_MESSAGE(ERROR, "Movie was recorded with a different ROM.");
+        return false;
+    }
+    if (movie->snapshot == NULL)
+    {
+        power_cycle_emulator(gb);
+    }
+    else if (!gbc_snapshot_load(gb, movie->snapshot, movie->snapshot_size))
+    {
+        return false;
+    }
+    restore_joypad(gb, movie->start_buttons);
+    return true;
+}
+
+bool play_movie(Movie *movie, GbcMachine *gb, MovieFrameHandler on_frame, void *context)
+{
+    if (!rewind_movie(movie, gb)) return false;
+
+    uint32_t frame = 0;
+    for (uint32_t i = 0; i < movie->run_count; i++)
+    {
+        MovieRun *run = &movie->runs[i];
+        set_joypad(gb, run->buttons); // Same path live input takes, interrupt included.
+        if (on_frame == NULL)
+        {
+            run_frames(gb, run->frames);
+            frame += run->frames;
+            continue;
+        }
+        for (uint16_t j = 0; j < run->frames; j++)
+        {
+            run_frames(gb, 1);
+            on_frame(context, gb, frame++);
+        }
+    }
+    return true;
+}
+
+/* SERIALIZATION */
+
+size_t get_movie_size(Movie *movie)
+{
+    return sizeof(MovieHeader) + movie->snapshot_size + (movie->run_count * MOVIE_RUN_SIZE);
+}
+
+size_t save_movie(Movie *movie, uint8_t *buffer, size_t size)
+{
+    size_t needed = get_movie_size(movie);
+    if (size < needed)
+    {
+        LOG_MESSAGE(ERROR, "Movie needs %zu bytes, buffer has %zu.", needed, size);
+        return 0;
+    }
+
+    MovieHeader header =
+    {
+        .magic         = MOVIE_MAGIC,
+        .version       = MOVIE_VERSION,
+        .start_buttons = movie->start_buttons,
+        .reserved      = 0,
+        .rom_hash      = movie->rom_hash,
+        .frame_count   = movie->frame_count,
+        .run_count     = movie->run_count,
+        .snapshot_size = (uint32_t) movie->snapshot_size
+    };
+
+    uint8_t *cursor = pack_bytes(buffer, &header, sizeof(MovieHeader));
+    if (movie->snapshot) cursor = pack_bytes(cursor, movie->snapshot, movie->snapshot_size);
+    for (uint32_t i = 0; i < movie->run_count; i++)
+    {
+        cursor = pack_bytes(cursor, &movie->runs[i].buttons, sizeof(uint8_t));
+        cursor = pack_bytes(cursor, &movie->runs[i].frames,  sizeof(uint16_t));
+    }
+    return (size_t) (cursor - buffer);
+}
+
+Movie *load_movie(const uint8_t *buffer, size_t size)
+{
+    MovieHeader header;
+    if (size < sizeof(MovieHeader)) return NULL;
+    memcpy(&header, buffer, sizeof(MovieHeader));
+
+    if ((header.magic != MOVIE_MAGIC) || (header.version != MOVIE_VERSION))
+    {
+        LOG_MESSAGE(ERROR, "Not a version %d movie.", MOVIE_VERSION);
+        return NULL;
+    }
+    size_t needed = sizeof(MovieHeader) + header.snapshot_size + ((size_t) header.run_count * MOVIE_RUN_SIZE);
+    if (size < needed)
+    {
+        LOG_MESSAGE(ERROR, "Movie is truncated: %zu of %zu bytes.", size, needed);
+        return NULL;
+    }
+
+    Movie *movie         = alloc_movie(header.run_count ? header.run_count : 1);
+    movie->rom_hash      = header.rom_hash;
+    movie->start_buttons = header.start_buttons;
+    movie->run_count     = header.run_count;
+
+    const uint8_t *cursor = buffer + sizeof(MovieHeader);
+    if (header.snapshot_size)
+    {
+        movie->snapshot_size = header.snapshot_size;
+        movie->snapshot      = (uint8_t*) malloc(movie->snapshot_size);
+        cursor = unpack_bytes(cursor, movie->snapshot, movie->snapshot_size);
+    }
+    for (uint32_t i = 0; i < movie->run_count; i++)
+    {
+        cursor = unpack_bytes(cursor, &movie->runs[i].buttons, sizeof(uint8_t));
+        cursor = unpack_bytes(cursor, &movie->runs[i].frames,  sizeof(uint16_t));
+        movie->frame_count += movie->runs[i].frames;
+    }
+
+    if (movie->frame_count != header.frame_count)
+    {
+        LOG_MESSAGE(ERROR, "Movie runs add up to %u frames, header says %u.", movie->frame_count, header.frame_count);
+        tidy_movie(movie);
+        return NULL;
+    }
+    return movie;
+}
+
+bool write_movie_file(Movie *movie, const char *file_path)
+{
+    size_t     size = get_movie_size(movie);
+    uint8_t *buffer = (uint8_t*) malloc(size);
+    save_movie(movie, buffer, size);
+
+    FILE *file = fopen(file_path, "wb");
+    if (file == NULL)
+    {
+        LOG_MESSAGE(ERROR, "Failed to open %s.", file_path);
+        free(buffer);
+        return false;
+    }
+    bool written = (fwrite(buffer, 1, size, file) == size);
+    fclose(file);
+    free(buffer);
+    return written;
+}
+
+Movie *read_movie_file(const char *file_path)
+{
+    FILE *file = fopen(file_path, "rb");
+    if (file == NULL)
+    {
+        LOG_MESSAGE(ERROR, "Failed to open %s.", file_path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    rewind(file);
+
+    uint8_t *buffer = (uint8_t*) malloc(size);
+    Movie    *movie = NULL;
+    if (fread(buffer, 1, size, file) == (size_t) size)
+    {
+        movie = load_movie(buffer, (size_t) size);
+    }
+    fclose(file);
+    free(buffer);
+    return movie;
+}
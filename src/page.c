@@ -0,0 +1,65 @@
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "logger.h"
+#include "page.h"
+
+#define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
+
+typedef struct
+{
+    atomic_uint   refs;
+    size_t        size;
+    uint8_t     data[];
+
+} Page;
+
+static Page *get_page(uint8_t *data)
+{
+    return (Page*) (data - offsetof(Page, data));
+}
+
+uint8_t *alloc_page(size_t size)
+{
+    Page *page = (Page*) calloc(1, sizeof(Page) + size);
+    if (page == NULL)
+    {
+        LOG_MESSAGE(ERROR, "Could not allocate a %zu byte page.", size);
+        return NULL;
+    }
+    atomic_init(&page->refs, 1);
+    page->size = size;
+    return page->data;
+}
+
+uint8_t *share_page(uint8_t *data)
+{
+    if (data == NULL) return NULL;
+    atomic_fetch_add(&get_page(data)->refs, 1);
+    return data;
+}
+
+void release_page(uint8_t *data)
+{
+    if (data == NULL) return;
+    Page *page = get_page(data);
+    if (atomic_fetch_sub(&page->refs, 1) == 1) free(page);
+}
+
+uint8_t *own_page(uint8_t *data)
+{
+    Page *page = get_page(data);
+    if (atomic_load(&page->refs) == 1) return data; // Nobody else can gain a reference while we run.
+
+    uint8_t *copy = alloc_page(page->size);
+    memcpy(copy, data, page->size);
+    release_page(data);
+    return copy;
+}
+
+size_t get_page_size(uint8_t *data)
+{
+    return get_page(data)->size;
+}
@@ -1,28 +1,58 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include "arena.h"  // Machine state arena
 #include "cart.h"   // Used to determine DMG or CGB
 #include "common.h" // Essential enums for readibility
 #include "cpu.h"    // Interrupt requesting
 #include "logger.h" // Console or file logs
+#include "machine.h" // Emulation context
 #include "mmu.h"    // Reading hardware memory
 #include "ppu.h"    // Header file
-#include "util.h"   // Queue implementation
+#include "util.h"   // Snapshot packing
 
 #define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
 
-typedef struct
+#define TILE_BANKS            2
+#define TILE_COUNT          384 // $8000-$97FF, 16 bytes each.
+#define TILE_BYTES           16
+#define TILE_DATA_SIZE   0x1800
+#define OBJECTS_PER_LINE     10
+
+// A scanline pixel is one byte. The low 6 bits pick its color from the line's color table, bit 7 is the
+// background's priority over objects.
+#define PIXEL_COLOR_MASK   0x03 // Color id.
+#define PIXEL_PALETTE_SHIFT   2 // CGB palette, or the DMG object palette.
+#define PIXEL_OBJ          0x20 // Drawn by an object.
+#define PIXEL_PRIORITY     0x80
+#define PIXEL_COLORS         64
+
+typedef struct Tile
 {
     uint8_t     x;
     uint8_t     y;
     uint8_t index;
     uint8_t  attr;
-    uint8_t   lsb;
-    uint8_t   msb;
 
 } Tile;
 
-typedef struct
+typedef struct LineObject // OAM entry on the current scanline, position already shifted onto the screen.
+{
+    uint8_t          x;
+    uint8_t          y;
+    uint8_t tile_index;
+    uint8_t       attr;
+
+} LineObject;
+
+typedef struct TileCache
+{
+    uint8_t colors[TILE_BANKS][TILE_COUNT][2][TILE_SIZE][TILE_SIZE]; // [bank][tile][x_flip][row][x] -> 2-bit color id
+    uint64_t dirty[TILE_BANKS][TILE_COUNT / 64]; // Tiles whose VRAM changed since they were decoded.
+
+} TileCache;
+
+typedef struct PpuState
 {
     // 160px by 144px LCD Display
     uint32_t   *lcd;
@@ -34,6 +64,8 @@ typedef struct
     uint8_t penalty;
     uint8_t      lx;
     uint8_t     *ly;
+    LineObject objects[OBJECTS_PER_LINE]; // Found by OAM scan, sorted by x.
+    uint8_t object_count;
     // Background
     uint8_t    *scx;
     uint8_t    *scy;
@@ -46,16 +78,15 @@ typedef struct
     uint8_t   *opd1;
     // Flags
     bool   sc_complete;
+    // Mode Sequencing
+    uint64_t   clock; // gb->clock of the first dot not run yet, the PPU lags behind until something looks.
+    uint8_t     mode; // PpuMode
+    uint8_t     line; // Scanline being run, mirrored to LY as each one starts.
+    uint16_t countdown; // Dots left in the current mode, 0 = the next dot starts another.
+    bool   stat_line; // Combined STAT interrupt line, requests on its rising edge only.
 
 } PpuState;
 
-static PpuState *ppu;
-static Tile    *tile;
-
-static GbcPixel *pixel_schema;
-static Queue        *scanline;
-static Queue        *oam_fifo;
-
 /* ================== GLOBAL        ================== */
 
 static void reset_ppu(PpuState *ppu)
@@ -65,22 +96,22 @@ static void reset_ppu(PpuState *ppu)
     ppu->  sc_complete = false;
 }
 
-static void init_registers(PpuState *reg)
+static void init_registers(GbcMachine *gb, PpuState *reg)
 {
-    reg->lcdc = get_memory_pointer(LCDC);
-    reg->stat = get_memory_pointer(STAT);
-    reg->  ly = get_memory_pointer(  LY);
-    reg-> lyc = get_memory_pointer( LYC); 
+    reg->lcdc = get_memory_pointer(gb, LCDC);
+    reg->stat = get_memory_pointer(gb, STAT);
+    reg->  ly = get_memory_pointer(gb,   LY);
+    reg-> lyc = get_memory_pointer(gb,  LYC); 
     
-    reg-> scx = get_memory_pointer( SCX);
-    reg-> scy = get_memory_pointer( SCY);
+    reg-> scx = get_memory_pointer(gb,  SCX);
+    reg-> scy = get_memory_pointer(gb,  SCY);
     
-    reg->  wx = get_memory_pointer(  WX);
-    reg->  wy = get_memory_pointer(  WY);
+    reg->  wx = get_memory_pointer(gb,   WX);
+    reg->  wy = get_memory_pointer(gb,   WY);
 
-    reg-> bgp = get_memory_pointer( BGP);
-    reg->opd0 = get_memory_pointer(OBP0);
-    reg->opd1 = get_memory_pointer(OBP1); 
+    reg-> bgp = get_memory_pointer(gb,  BGP);
+    reg->opd0 = get_memory_pointer(gb, OBP0);
+    reg->opd1 = get_memory_pointer(gb, OBP1); 
 }
 
 static void set_ppu_mode(PpuState *ppu, PpuMode mode)
@@ -88,16 +119,48 @@ static void set_ppu_mode(PpuState *ppu, PpuMode mode)
     (*ppu->stat) = ((*ppu->stat) & ~LOWER_2_MASK) | mode;
 }
 
-/* ================== DRAWING       ================== */
+static void get_next_phase(uint8_t *mode, uint8_t *line, uint16_t *length) // Mode that follows, and its length.
+{
+    switch (*mode)
+    {
+        case OAM_SCAN:
+            (*mode)   = DRAWING;
+            (*length) = DRAWING_DOTS;
+            break;
+        case DRAWING:
+            (*mode)   = HBLANK;
+            (*length) = DOTS_PER_LINE - OAM_SCAN_DOTS - DRAWING_DOTS;
+            break;
+        default:
+            (*line)   = ((*line) + 1) % LINES_PER_FRAME;
+            (*mode)   = ((*line) < GBC_HEIGHT) ? OAM_SCAN : VBLANK;
+            (*length) = ((*line) < GBC_HEIGHT) ? OAM_SCAN_DOTS : DOTS_PER_LINE;
+            break;
+    }
+}
 
-static GbcPixel *empty_pixel()
+static bool get_stat_level(uint8_t stat, uint8_t mode, bool equal) // The four STAT sources, OR'ed into one line.
 {
-    pixel_schema->color_id     = 0;
-    pixel_schema->bg_priority  = false;
-    pixel_schema->obj_priority = false;
-    return pixel_schema;
+    return (equal              && (stat & BIT_6_MASK)) ||
+           ((mode == OAM_SCAN) && (stat & BIT_5_MASK)) ||
+           ((mode == VBLANK)   && (stat & BIT_4_MASK)) ||
+           ((mode == HBLANK)   && (stat & BIT_3_MASK));
 }
 
+static void update_stat_line(GbcMachine *gb, PpuState *ppu)
+{
+    uint8_t stat = (*ppu->stat);
+    bool   equal = (ppu->line == (*ppu->lyc));
+    stat = equal ? (stat | BIT_2_MASK) : (stat & ~BIT_2_MASK);
+    (*ppu->stat) = stat;
+
+    bool line = get_stat_level(stat, ppu->mode, equal);
+    if (line && !ppu->stat_line) request_interrupt(gb, LCD_STAT_INTERRUPT_CODE);
+    ppu->stat_line = line;
+}
+
+/* ================== DRAWING       ================== */
+
 static uint32_t get_argb(uint8_t lsb, uint8_t msb)
 {
     uint16_t color = (msb << BYTE) | lsb;
@@ -105,7 +168,7 @@ static uint32_t get_argb(uint8_t lsb, uint8_t msb)
     uint8_t green  = ((color >>  5) & LOWER_5_MASK) << 3;
     uint8_t  blue  = ((color >> 10) & LOWER_5_MASK) << 3;
     uint32_t argb  = 
-    (0xFF << (BYTE * 3)) | (red << (BYTE * 2)) | (green << (BYTE * 1)) | blue;
+    ((uint32_t) 0xFF << (BYTE * 3)) | (red << (BYTE * 2)) | (green << (BYTE * 1)) | blue;
     return argb;
 }
 
@@ -122,28 +185,6 @@ static uint32_t get_dmg_shade(uint8_t id)
     return result;
 }
 
-static uint8_t get_next_color(Tile *tile, bool x_flip)
-{
-    uint8_t lsb, msb;
-
-    if (!x_flip)
-    {
-        lsb = (tile->lsb & BIT_7_MASK) >> 7;
-        tile->lsb <<= 1;
-        msb = (tile->msb & BIT_7_MASK) >> 7;
-        tile->msb <<= 1;
-    }
-    else
-    {
-        lsb = tile->lsb & BIT_0_MASK;
-        tile->lsb >>= 1;
-        msb = tile->msb & BIT_0_MASK;
-        tile->msb >>= 1;
-    }
-
-    return ((msb << 1) | lsb);
-}
-
 static bool drawing_window(PpuState *ppu)
 {
     uint8_t lcdc = (*ppu->lcdc);
@@ -152,54 +193,55 @@ static bool drawing_window(PpuState *ppu)
     return ((lx >= (wx - 7)) && (ly >= wy) && (lcdc & BIT_5_MASK));
 }
 
-static bool drawing_obj(GbcPixel *bgw, GbcPixel *obj, PpuState *ppu)
+static void load_line_colors(GbcMachine *gb, PpuState *ppu, uint32_t *colors) // Indexed by a pixel's low 6 bits.
 {
-    bool obj_enabled = (((*ppu->lcdc) & BIT_1_MASK) != 0);
-    bool master_prio = is_gbc() ? ((*ppu->lcdc & BIT_0_MASK) != 0) : false;
-
-    if (!obj_enabled)       return false;
-
-    if (bgw->color_id == 0) return true;
-
-    if (!master_prio)       return true;
-
-    if (!bgw->bg_priority && !obj->obj_priority) return true;
-
-    return false;
-}
-
-static uint32_t get_obj_pixel_color(GbcPixel *pixel)
-{
-    if(is_gbc())
+    if (is_gbc(gb))
     {
-        uint8_t lsb = read_cram(true, pixel->gbc_palette, pixel->color_id, 0);
-        uint8_t msb = read_cram(true, pixel->gbc_palette, pixel->color_id, 1);
-        return get_argb(lsb, msb); 
+        for (uint8_t i = 0; i < PIXEL_COLORS; i++)
+        {
+            bool    is_obj  = (i & PIXEL_OBJ) != 0;
+            uint8_t palette = (i >> PIXEL_PALETTE_SHIFT) & LOWER_3_MASK;
+            uint8_t id      = i & PIXEL_COLOR_MASK;
+            colors[i] = get_argb(read_cram(gb, is_obj, palette, id, 0), read_cram(gb, is_obj, palette, id, 1));
+        }
+        return;
     }
-    else
+    for (uint8_t id = 0; id < 4; id++) // DMG lines only ever use these 12.
     {
-        uint8_t opd = (pixel->dmg_palette) ? io_memory_read(OBP1) : io_memory_read(OBP0);
-        uint8_t cid = (opd >> (2 * pixel->color_id)) & LOWER_2_MASK;
-        return get_dmg_shade(cid);
+        colors[id]                                          = get_dmg_shade(((*ppu->bgp)  >> (2 * id)) & LOWER_2_MASK);
+        colors[PIXEL_OBJ | id]                              = get_dmg_shade(((*ppu->opd0) >> (2 * id)) & LOWER_2_MASK);
+        colors[PIXEL_OBJ | (1 << PIXEL_PALETTE_SHIFT) | id] = get_dmg_shade(((*ppu->opd1) >> (2 * id)) & LOWER_2_MASK);
     }
 }
 
-static uint32_t get_bgw_pixel_color(GbcPixel *pixel)
+/* ================== VRAM ACCESS ================== */
+
+static void decode_tile(GbcMachine *gb, TileCache *cache, uint8_t bank, uint16_t tile)
 {
-    if(is_gbc())
-    {
-        uint8_t lsb = read_cram(false, pixel->gbc_palette, pixel->color_id, 0);
-        uint8_t msb = read_cram(false, pixel->gbc_palette, pixel->color_id, 1);
-        return get_argb(lsb, msb); 
-    }
-    else
+    const uint8_t *data = gb->vram[bank] + (tile * TILE_BYTES);
+    for (uint8_t row = 0; row < TILE_SIZE; row++)
     {
-        uint8_t cid = ((*ppu->bgp) >> (2 * pixel->color_id)) & LOWER_2_MASK;
-        return get_dmg_shade(cid);
+        uint8_t lsb = data[2 * row];
+        uint8_t msb = data[2 * row + 1];
+        for (uint8_t x = 0; x < TILE_SIZE; x++)
+        {
+            uint8_t id = (((msb >> (7 - x)) & BIT_0_MASK) << 1) | ((lsb >> (7 - x)) & BIT_0_MASK);
+            cache->colors[bank][tile][0][row][x]                 = id;
+            cache->colors[bank][tile][1][row][TILE_SIZE - 1 - x] = id;
+        }
     }
+    cache->dirty[bank][tile / 64] &= ~(1ULL << (tile % 64));
 }
 
-/* ================== VRAM ACCESS ================== */
+static const uint8_t *get_tile_row(GbcMachine *gb, uint8_t bank, uint16_t address, bool x_flip) // Row of 8 color ids.
+{
+    TileCache *cache = gb->tile_cache;
+    uint16_t  offset = address - B0_ADDRESS_START;
+    uint16_t    tile = offset / TILE_BYTES;
+    uint8_t      row = (offset % TILE_BYTES) / 2;
+    if (cache->dirty[bank][tile / 64] & (1ULL << (tile % 64))) decode_tile(gb, cache, bank, tile);
+    return cache->colors[bank][tile][x_flip][row];
+}
 
 static uint16_t bgw_tile_data_address(Tile *tile, uint8_t lcdc, uint8_t row)
 {
@@ -217,11 +259,11 @@ static uint16_t bgw_tile_data_address(Tile *tile, uint8_t lcdc, uint8_t row)
     return address;
 }
 
-static void get_win_tile(Tile *tile, PpuState *ppu) // Encodes (index, attr, lsb, msb)
+static const uint8_t *get_win_tile(GbcMachine *gb, Tile *tile, PpuState *ppu) // Encodes (index, attr), returns the row
 {
     uint8_t      lcdc = (*ppu->lcdc);
     uint8_t        lx =      (ppu->lx); uint8_t ly = (*ppu->ly);
-    uint8_t        wx =    (*ppu->scx); uint8_t wy = (*ppu->wy);
+    uint8_t        wx =     (*ppu->wx); uint8_t wy = (*ppu->wy);
 
     uint8_t    tile_x = (lx - (wx - 7)) / TILE_SIZE;
     uint8_t    tile_y = (ly - wy) / TILE_SIZE;
@@ -230,21 +272,20 @@ static void get_win_tile(Tile *tile, PpuState *ppu) // Encodes (index, attr, lsb
     
     uint8_t       row = (ly - wy) % TILE_SIZE;
     uint8_t      bank = TILE_MAP_BANK_0;
-    tile->      index = read_vram(TILE_MAP_BANK_0, address);
+    tile->      index = read_vram(gb, TILE_MAP_BANK_0, address);
 
-    if (is_gbc())
+    if (is_gbc(gb))
     {
-        tile->attr = read_vram(TILE_MAP_BANK_1, address);
+        tile->attr = read_vram(gb, TILE_MAP_BANK_1, address);
         bank = (tile->attr & BIT_3_MASK) >> 3;
         row  = (tile->attr & BIT_6_MASK) ? (TILE_SIZE - 1 - row) : row; 
     }
 
-    address = bgw_tile_data_address(tile, lcdc, row);
-    tile->       lsb = read_vram(bank, address);
-    tile->       msb = read_vram(bank, address + 1);
+    bool   x_flip = is_gbc(gb) && ((tile->attr & BIT_5_MASK) != 0);
+    return get_tile_row(gb, bank, bgw_tile_data_address(tile, lcdc, row), x_flip);
 }
 
-static void get_bg_tile(Tile *tile, PpuState *ppu)  // Encodes (index, attr, lsb, msb)
+static const uint8_t *get_bg_tile(GbcMachine *gb, Tile *tile, PpuState *ppu)  // Encodes (index, attr), returns the row
 {
     uint8_t      lcdc = (*ppu->lcdc);
 
@@ -258,245 +299,311 @@ static void get_bg_tile(Tile *tile, PpuState *ppu)  // Encodes (index, attr, lsb
     
     uint8_t       row = (ly + scy) % TILE_SIZE;
     uint8_t      bank = TILE_MAP_BANK_0;
-    tile->      index = read_vram(TILE_MAP_BANK_0, address);
+    tile->      index = read_vram(gb, TILE_MAP_BANK_0, address);
 
-    if (is_gbc())
+    if (is_gbc(gb))
     {
-        tile->attr = read_vram(TILE_MAP_BANK_1, address);
+        tile->attr = read_vram(gb, TILE_MAP_BANK_1, address);
         bank = (tile->attr & BIT_3_MASK) >> 3;
         row  = ((tile->attr & BIT_6_MASK) != 0) ? (TILE_SIZE - 1 - row) : row; 
     }
 
-    address = bgw_tile_data_address(tile, lcdc, row);
-    tile->       lsb = read_vram(bank, address);
-    tile->       msb = read_vram(bank, address + 1);
+    bool   x_flip = is_gbc(gb) && ((tile->attr & BIT_5_MASK) != 0);
+    return get_tile_row(gb, bank, bgw_tile_data_address(tile, lcdc, row), x_flip);
 }
 
-static void get_obj_tile(Tile *tile, GbcPixel *obj, PpuState *ppu)
+static const uint8_t *get_obj_tile(GbcMachine *gb, Tile *tile, LineObject *obj, PpuState *ppu)
 {
-    uint8_t   bank = obj->bank;
+    uint8_t   bank = (obj->attr & BIT_3_MASK) != 0;
     uint8_t    row = (*ppu->ly - obj->y);
     bool   stacked = ((*ppu->lcdc & BIT_2_MASK) != 0);
     uint8_t height = stacked ? 16 : 8;
-    row = (obj->y_flip) ? (row - height - 1) : row;
+    row = ((obj->attr & BIT_6_MASK) != 0) ? (row - height - 1) : row;
 
     tile->index = obj->tile_index; 
 
     uint16_t address = B0_ADDRESS_START + (tile->index * 16) + (row * 2);
-    tile->lsb = read_vram(bank, address);
-    tile->msb = read_vram(bank, address + 1);
+    return get_tile_row(gb, bank, address, (obj->attr & BIT_5_MASK) != 0);
 }
 
-static void oam_scan(uint8_t ly)
+static void oam_scan(GbcMachine *gb, uint8_t ly)
 {
-    reset_queue(oam_fifo);
-    uint16_t curr_address = OAM_ADDRESS_START;
-    uint8_t lcdc = (*ppu->lcdc);
-    bool stacked = (lcdc & BIT_2_MASK) != 0;
+    PpuState *ppu = gb->ppu;
+    uint8_t  *oam = get_memory(gb); // Straight from memory, the bus would sync the PPU we are running.
+    bool  stacked = ((*ppu->lcdc) & BIT_2_MASK) != 0;
+    uint8_t height = (stacked) ? 16 : 8;
+    ppu->object_count = 0;
 
-    while(curr_address <= OAM_ADDRESS_END)
+    for (uint16_t address = OAM_ADDRESS_START; address <= OAM_ADDRESS_END; address += OAM_ENTRY_SIZE)
     {
-        uint8_t      y_pos = read_memory(curr_address) - 16;
-        uint8_t     height = (stacked) ? 16 : 8;
+        uint8_t      y_pos = oam[address] - 16;
         bool   on_scanline = (ly >= y_pos) && ((ly - y_pos) < height);
+        if (!on_scanline) continue;
 
-        if (on_scanline)
+        LineObject object =
         {
-            GbcPixel     *object = empty_pixel();
-            uint8_t        x_pos = read_memory(curr_address + 1);
-            uint8_t   tile_index = read_memory(curr_address + 2);
-            uint8_t   attributes = read_memory(curr_address + 3);
-            object-> oam_address = curr_address;
-            object->           x = x_pos - 8;
-            object->           y = y_pos;
-            object->  tile_index = tile_index;
-            object->      is_obj = true;
-            object->obj_priority = (attributes & BIT_7_MASK) != 0;
-            object->      y_flip = (attributes & BIT_6_MASK) != 0;
-            object->      x_flip = (attributes & BIT_5_MASK) != 0;
-            object-> dmg_palette = (attributes & BIT_4_MASK) != 0;
-            object->        bank = (attributes & BIT_3_MASK) != 0;
-            object-> gbc_palette = (uint8_t) (attributes & LOWER_3_MASK);
-            cpu_log(DEBUG, "Found object at (%02X, %02X)", object->x, object->y);
-            enqueue(oam_fifo, object);
+            .x          = oam[address + 1] - 8,
+            .y          = y_pos,
+            .tile_index = oam[address + 2],
+            .attr       = oam[address + 3]
+        };
+        cpu_log(gb, DEBUG, "Found object at (%02X, %02X)", object.x, object.y);
+
+        uint8_t slot = ppu->object_count++;
+        while ((slot > 0) && (ppu->objects[slot - 1].x > object.x))
+        { // Insertion by x, earlier OAM entries stay first on ties.
+            ppu->objects[slot] = ppu->objects[slot - 1];
+            slot -= 1;
         }
-
-        curr_address += OAM_ENTRY_SIZE;
+        ppu->objects[slot] = object;
+        if (ppu->object_count == OBJECTS_PER_LINE) break;
     }
-
-    sort_oam_by_xpos(oam_fifo);
 }
 
 /* ================== SCANLINE RENDER ============= */
 
-static void render_background(PpuState *ppu, Queue *scanline)
+static void render_background(GbcMachine *gb, PpuState *ppu, uint8_t *line)
 {
+    Tile tile = {0};
     ppu->lx = 0;
     bool win_rendering = false;
+    int          win_x = (*ppu->wx) - 7; // Screen column of window column 0, negative when WX < 7.
 
     while (ppu->lx < GBC_WIDTH)
     {
-        win_rendering ? get_win_tile(tile, ppu) : get_bg_tile(tile, ppu);
+        win_rendering = win_rendering || drawing_window(ppu);
+        const uint8_t *colors = win_rendering ? get_win_tile(gb, &tile, ppu) : get_bg_tile(gb, &tile, ppu);
+        uint8_t          attr = is_gbc(gb) ?
+                                ((tile.attr & BIT_7_MASK) | ((tile.attr & LOWER_3_MASK) << PIXEL_PALETTE_SHIFT)) : 0;
 
-        uint8_t offset = ppu->lx % 8;
-        // Non-zero offset means we transitioned to window tile at an uneven spacing.
-        while (offset != 0) 
+        // The window counts its columns from WX - 7, not from the left edge of the screen.
+        for (int i = (win_rendering ? (ppu->lx - win_x) : ppu->lx) % TILE_SIZE; (i < TILE_SIZE) && (ppu->lx < GBC_WIDTH); i++)
         {
-            get_next_color(tile, false);
-            offset -= 0;
-        }
-
-        for (int i = 0; i < TILE_SIZE; i++)
-        {
-            GbcPixel    *pixel = empty_pixel();
-            bool x_flip = is_gbc() ? ((tile->attr & BIT_5_MASK) != 0) : false;
-            pixel->   color_id = get_next_color(tile, x_flip);
-            pixel->bg_priority = is_gbc() ? ((tile->attr & BIT_7_MASK) != 0) : 0;
-            pixel->gbc_palette = is_gbc() ? (tile->attr & LOWER_3_MASK) : 0;
-            pixel->      is_obj = false;
-            enqueue(scanline, pixel);
-
+            line[ppu->lx] = attr | colors[i];
             ppu->lx += 1;
 
-            if (!win_rendering && drawing_window(ppu))
-            {
-                win_rendering = true; // for rest of scanline
-                break;
-            }
+            if (!win_rendering && drawing_window(ppu)) break; // Window for the rest of the scanline.
         }
     }
 }
 
-static void render_objects(PpuState *ppu, Queue *scanline, Queue *oam_fifo)
+static void render_objects(GbcMachine *gb, PpuState *ppu, uint8_t *line)
 {
-    if (is_empty(oam_fifo)) return;
+    if (((*ppu->lcdc) & BIT_1_MASK) == 0) return;
+    bool master_prio = is_gbc(gb) && (((*ppu->lcdc) & BIT_0_MASK) != 0);
 
+    Tile tile = {0};
     ppu->lx = 0;
 
-    GbcPixel *obj = dequeue(oam_fifo);
-
-    while ((obj != NULL) && (ppu->lx < GBC_WIDTH))
+    for (uint8_t n = 0; n < ppu->object_count; n++)
     {
-        if (ppu->lx >= obj->x)
-        {
-            get_obj_tile(tile, obj, ppu);
-            uint8_t offset = ppu->lx - obj->x;
-
-            for (int i = 0; i < TILE_SIZE; i++)
-            {
-                obj->color_id = get_next_color(tile, obj->x_flip);
+        LineObject *obj = &ppu->objects[n];
+        if (obj->x >= GBC_WIDTH) break; // Sorted, the rest are off screen too.
+        if (ppu->lx < obj->x) ppu->lx = obj->x;
 
-                if (i < offset) continue;
+        const uint8_t *colors = get_obj_tile(gb, &tile, obj, ppu);
+        bool     obj_priority = (obj->attr & BIT_7_MASK) != 0;
+        uint8_t       palette = is_gbc(gb) ? (obj->attr & LOWER_3_MASK) : ((obj->attr & BIT_4_MASK) != 0);
+        uint8_t         pixel = PIXEL_OBJ | (palette << PIXEL_PALETTE_SHIFT);
 
-                GbcPixel *bgw = dequeue(scanline);
-                drawing_obj(bgw, obj, ppu) ? enqueue(scanline, obj) : enqueue(scanline, bgw);
-                ppu->lx += 1;
-            }
-            
-            obj = dequeue(oam_fifo);
-        }
-        else // Circular shift scanline.
+        // Objects further left already own the pixels they overlap.
+        for (int i = ppu->lx - obj->x; i < TILE_SIZE; i++)
         {
-            enqueue(scanline, dequeue(scanline));
+            uint8_t bgw = line[ppu->lx];
+            bool   over = ((bgw & PIXEL_COLOR_MASK) == 0) || !master_prio ||
+                          (((bgw & PIXEL_PRIORITY) == 0) && !obj_priority);
+            if (over) line[ppu->lx] = pixel | colors[i];
             ppu->lx += 1;
+            if (ppu->lx == GBC_WIDTH) return;
         }
     }
-    
-    while (ppu->lx < GBC_WIDTH) // Complete scanline shift.
-    {
-        enqueue(scanline, dequeue(scanline));
-        ppu->lx += 1;
-    }
-}   
-
-static void render_scanline(PpuState *ppu)
-{
-    render_background(ppu, scanline);
-    render_objects(ppu, scanline, oam_fifo);
-    ppu->lx = 0; uint8_t ly = (*ppu->ly);
-    while (!is_empty(scanline))
-    {   
-        GbcPixel *pixel = dequeue(scanline);
-        ppu->lcd[ly * GBC_WIDTH + ppu->lx] = 
-        pixel->is_obj ? get_obj_pixel_color(pixel) : get_bgw_pixel_color(pixel);
-        ppu->lx += 1; 
-    }
 }
 
-static void prep_scanline_render(PpuState *ppu)
-{   
-    reset_ppu(ppu);
-    reset_queue(scanline);
+static void render_scanline(GbcMachine *gb, PpuState *ppu)
+{
+    uint8_t  line[GBC_WIDTH];
+    uint32_t colors[PIXEL_COLORS];
+    render_background(gb, ppu, line);
+    render_objects(gb, ppu, line);
+    load_line_colors(gb, ppu, colors);
+
+    uint32_t *lcd = ppu->lcd + ((*ppu->ly) * GBC_WIDTH); // Straight into the frame, one lookup per pixel.
+    for (uint8_t x = 0; x < GBC_WIDTH; x++)
+    {
+        lcd[x] = colors[line[x] & (PIXEL_COLORS - 1)];
+    }
+    ppu->lx = GBC_WIDTH;
 }
 
 /* ================== PUBLIC API ================= */
 
-void dot(uint32_t current_dot)
+static void next_mode(GbcMachine *gb, PpuState *ppu) // Runs on the first dot of every mode.
 {
-    uint16_t sc_dot = current_dot % DOTS_PER_LINE;
-    uint8_t      ly = (current_dot / DOTS_PER_LINE);
-    uint8_t    lcdc = (*ppu->lcdc);
-    uint8_t    stat = (*ppu->stat);
-
-    (*ppu->ly) = ly; // Recording scanline position.
+    uint8_t line = ppu->line;
+    if (ppu->mode == DRAWING) render_scanline(gb, ppu);
+    get_next_phase(&ppu->mode, &ppu->line, &ppu->countdown);
+    set_ppu_mode(ppu, ppu->mode);
+    if (ppu->line != line) (*ppu->ly) = ppu->line; // Recording scanline position.
 
-    if      ((ly < GBC_HEIGHT)  && (sc_dot ==   0))
+    switch (ppu->mode)
     {
-        set_ppu_mode(ppu, OAM_SCAN);
-        oam_scan(ly);
-        bool triggered = ((stat & BIT_5_MASK) != 0);
-        if (triggered) request_interrupt(LCD_STAT_INTERRUPT_CODE);
+        case OAM_SCAN:
+            oam_scan(gb, ppu->line);
+            break;
+        case DRAWING:
+            reset_ppu(ppu);
+            break;
+        case HBLANK:
+            run_hblank_dma(gb);
+            break;
+        case VBLANK:
+            if (ppu->line == GBC_HEIGHT) request_interrupt(gb, VBLANK_INTERRUPT_CODE); // Once per frame, regardless.
+            break;
     }
-    else if ((ly < GBC_HEIGHT)  && (sc_dot ==  80))
+    update_stat_line(gb, ppu);
+}
+
+void ppu_advance(GbcMachine *gb, uint32_t dots)
+{
+    PpuState *ppu = gb->ppu;
+    ppu->clock += dots;
+    while (dots > 0)
     {
-        set_ppu_mode(ppu, DRAWING);
-        prep_scanline_render(ppu);
+        if (ppu->countdown == 0) next_mode(gb, ppu);
+        uint32_t span  = (dots < ppu->countdown) ? dots : ppu->countdown;
+        ppu->countdown -= span;
+        dots           -= span;
     }
-    else if ((ly < GBC_HEIGHT)  && (sc_dot == 369))
-    {
-        render_scanline(ppu);
-        set_ppu_mode(ppu, HBLANK);
-        bool triggered = ((stat & BIT_4_MASK) != 0);
-        if (triggered) request_interrupt(LCD_STAT_INTERRUPT_CODE);
+}
+
+static void catch_up(GbcMachine *gb, uint64_t clock)
+{
+    uint64_t run = gb->ppu->clock;
+    if (run < clock) ppu_advance(gb, (uint32_t) (clock - run));
+}
+
+void sync_ppu(GbcMachine *gb)
+{
+    catch_up(gb, gb->clock + 1);
+}
+
+void catch_up_ppu(GbcMachine *gb)
+{
+    catch_up(gb, gb->clock);
+}
+
+uint32_t get_ppu_countdown(GbcMachine *gb)
+{
+    PpuState *ppu = gb->ppu;
+    catch_up(gb, gb->clock);
+    return (uint32_t) (ppu->clock - gb->clock) + ppu->countdown;
+}
+
+uint32_t get_ppu_deadline(GbcMachine *gb)
+{
+    PpuState *ppu = gb->ppu;
+    catch_up(gb, gb->clock);
+
+    uint8_t      mode = ppu->mode;
+    uint8_t      line = ppu->line;
+    uint16_t   length = ppu->countdown;
+    bool        level = ppu->stat_line;
+    uint32_t deadline = (uint32_t) (ppu->clock - gb->clock) + ppu->countdown;
+    while (true)
+    { // Walks the modes to come, VBlank ends the walk within a frame.
+        get_next_phase(&mode, &line, &length);
+        bool rising = !level && get_stat_level(*ppu->stat, mode, (line == (*ppu->lyc)));
+        bool vblank = (mode == VBLANK) && (line == GBC_HEIGHT);
+        bool hblank = (mode == HBLANK) && hdma_active(gb); // The block lands before the CPU's slot.
+        if (rising || vblank || hblank) return deadline;
+        level     = get_stat_level(*ppu->stat, mode, (line == (*ppu->lyc)));
+        deadline += length;
     }
-    else if ((ly == GBC_HEIGHT) && (sc_dot ==   0))
+}
+
+void refresh_stat_line(GbcMachine *gb)
+{
+    update_stat_line(gb, gb->ppu);
+}
+
+void invalidate_tiles(GbcMachine *gb, uint8_t bank, uint16_t offset, uint16_t length)
+{
+    if (offset >= TILE_DATA_SIZE) return; // Tile maps, read straight from VRAM.
+    uint16_t   last = (((offset + length) < TILE_DATA_SIZE) ? (offset + length) : TILE_DATA_SIZE) - 1;
+    uint64_t *dirty = gb->tile_cache->dirty[bank];
+    for (uint16_t tile = offset / TILE_BYTES; tile <= last / TILE_BYTES; tile++)
     {
-        set_ppu_mode(ppu, VBLANK);
-        request_interrupt(VBLANK_INTERRUPT_CODE); // Happens once per frame, regardless.
-        bool triggered = ((stat & BIT_4_MASK) != 0);
-        if (triggered) request_interrupt(LCD_STAT_INTERRUPT_CODE);
+        dirty[tile / 64] |= 1ULL << (tile % 64);
     }
-
-    uint8_t    lyc = (*ppu->lyc);
-    bool triggered = ((ly == lyc) && (stat & BIT_6_MASK));
-    if (triggered) request_interrupt(LCD_STAT_INTERRUPT_CODE);
 }
 
-void *render_frame()
+void *render_frame(GbcMachine *gb)
 {   
-    return ppu->lcd;
+    return gb->ppu->lcd;
+}
+
+bool init_graphics(GbcMachine *gb)
+{
+    PpuState *ppu = (PpuState*) arena_alloc(gb->arena, sizeof(PpuState));
+    ppu->lcd      = (uint32_t*) arena_alloc(gb->arena, GBC_WIDTH * GBC_HEIGHT * sizeof(uint32_t));
+    ppu->mode     = VBLANK;
+    ppu->line     = LINES_PER_FRAME - 1; // The first dot starts line 0.
+    reset_ppu(ppu); init_registers(gb, ppu);
+    gb->ppu       = ppu;
+
+    gb->tile_cache    = (TileCache*) arena_alloc(gb->arena, sizeof(TileCache));
+    invalidate_tiles(gb, 0, 0, TILE_DATA_SIZE); // Forks start with VRAM already filled in.
+    invalidate_tiles(gb, 1, 0, TILE_DATA_SIZE);
 }
 
-bool init_graphics()
+void tidy_graphics(GbcMachine *gb)
 {
-    ppu           = (PpuState*) malloc(sizeof(PpuState));
-    ppu->lcd      = (uint32_t*) malloc(GBC_WIDTH * GBC_HEIGHT * sizeof(uint32_t));
-    reset_ppu(ppu); init_registers(ppu);
+    gb->ppu        = NULL; // Both, LCD included, live in the arena.
+    gb->tile_cache = NULL;
+}
 
-    tile          = (Tile*) malloc(sizeof(Tile)); 
+/* ================== SNAPSHOTS ================== */
 
-    pixel_schema  = (GbcPixel*) malloc(sizeof(GbcPixel));
-    scanline      = init_queue(GBC_WIDTH);
-    oam_fifo      = init_queue(10);
+size_t get_graphics_snapshot_size(GbcMachine *gb)
+{
+    return (5 * sizeof(uint8_t)) + (2 * sizeof(bool)) + sizeof(uint16_t) +
+           (GBC_WIDTH * GBC_HEIGHT * sizeof(uint32_t)) +
+           sizeof(uint8_t) + (OBJECTS_PER_LINE * sizeof(LineObject));
 }
 
-void tidy_graphics()
+uint8_t *save_graphics_snapshot(GbcMachine *gb, uint8_t *dest)
 {
-    free(ppu->lcd);         ppu->lcd = NULL;
-    free(ppu);                   ppu = NULL;
-    free(tile);                 tile = NULL;
-    free(pixel_schema); pixel_schema = NULL;
-    tidy_queue(scanline);
-    tidy_queue(oam_fifo);
+    PpuState *ppu = gb->ppu; // Register pointers stay bound to this machine's memory.
+    uint8_t  lead = (uint8_t) (ppu->clock - gb->clock); // 1 if the bus synced through the current dot.
+    dest = pack_bytes(dest, &ppu->penalty,     sizeof(uint8_t));
+    dest = pack_bytes(dest, &ppu->lx,          sizeof(uint8_t));
+    dest = pack_bytes(dest, &ppu->sc_complete, sizeof(bool));
+    dest = pack_bytes(dest, &ppu->mode,        sizeof(uint8_t));
+    dest = pack_bytes(dest, &ppu->line,        sizeof(uint8_t));
+    dest = pack_bytes(dest, &ppu->countdown,   sizeof(uint16_t));
+    dest = pack_bytes(dest, &ppu->stat_line,   sizeof(bool));
+    dest = pack_bytes(dest, &lead,             sizeof(uint8_t));
+    dest = pack_bytes(dest, ppu->lcd, GBC_WIDTH * GBC_HEIGHT * sizeof(uint32_t));
+    dest = pack_bytes(dest, &ppu->object_count, sizeof(uint8_t));
+    dest = pack_bytes(dest, ppu->objects, OBJECTS_PER_LINE * sizeof(LineObject));
+    return dest;
 }
 
+const uint8_t *load_graphics_snapshot(GbcMachine *gb, const uint8_t *src)
+{
+    PpuState *ppu = gb->ppu;
+    src = unpack_bytes(src, &ppu->penalty,     sizeof(uint8_t));
+    src = unpack_bytes(src, &ppu->lx,          sizeof(uint8_t));
+    src = unpack_bytes(src, &ppu->sc_complete, sizeof(bool));
+    src = unpack_bytes(src, &ppu->mode,        sizeof(uint8_t));
+    src = unpack_bytes(src, &ppu->line,        sizeof(uint8_t));
+    src = unpack_bytes(src, &ppu->countdown,   sizeof(uint16_t));
+    src = unpack_bytes(src, &ppu->stat_line,   sizeof(bool));
+    uint8_t lead;
+    src = unpack_bytes(src, &lead,             sizeof(uint8_t));
+    ppu->clock = gb->clock + lead;
+    src = unpack_bytes(src, ppu->lcd, GBC_WIDTH * GBC_HEIGHT * sizeof(uint32_t));
+    src = unpack_bytes(src, &ppu->object_count, sizeof(uint8_t));
+    src = unpack_bytes(src, ppu->objects, OBJECTS_PER_LINE * sizeof(LineObject));
+    return src;
+}
@@ -0,0 +1,334 @@
+#include <SDL2/SDL.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "logger.h"
+#include "scheduler.h"
+
+#define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
+#define DEFAULT_DEQUE_CAPACITY 64
+
+typedef struct
+{
+    SchedulerTask *tasks; // Ring buffer; owner works the bottom, thieves take the top.
+    uint32_t    capacity;
+    uint32_t         top;
+    uint32_t       count;
+    SDL_mutex      *lock;
+
+} TaskDeque;
+
+typedef struct
+{
+    struct Scheduler *scheduler;
+    uint16_t                 id;
+    TaskDeque             deque;
+    uint32_t               seed; // xorshift32 state for victim selection.
+
+    // Statistics
+    _Atomic Uint64   busy_ticks; // Read by get_worker_utilization() while the worker runs.
+    uint32_t          tasks_run;
+    uint32_t       tasks_stolen;
+
+} Worker;
+
+struct Scheduler
+{
+    Worker        *workers;
+    SDL_Thread   **threads;
+    uint16_t   num_workers;
+    uint32_t   next_worker; // Round-robin cursor for submissions.
+
+    TaskHandler    handler;
+    void          *context;
+
+    SDL_mutex       *mutex; // Only for sleeping and waking, the counters are atomic.
+    SDL_cond   *work_ready;
+    SDL_cond     *all_done;
+    atomic_uint     queued; // Tasks sitting in deques.
+    atomic_uint outstanding; // Tasks submitted but not yet finished.
+    bool           running;
+
+    Uint64     stats_epoch;
+};
+
+/* ================== TASK DEQUE ================== */
+
+static void init_deque(TaskDeque *deque)
+{
+    deque->tasks    = (SchedulerTask*) malloc(DEFAULT_DEQUE_CAPACITY * sizeof(SchedulerTask));
+    deque->capacity = DEFAULT_DEQUE_CAPACITY;
+    deque->top      = 0;
+    deque->count    = 0;
+    deque->lock     = SDL_CreateMutex();
+}
+
+static void tidy_deque(TaskDeque *deque)
+{
+    SDL_DestroyMutex(deque->lock);
+    free(deque->tasks); deque->tasks = NULL;
+}
+
+static void push_bottom(TaskDeque *deque, SchedulerTask task)
+{
+    SDL_LockMutex(deque->lock);
+    if (deque->count == deque->capacity)
+    { // Unroll the ring into a buffer twice the size.
+        SchedulerTask *tasks = (SchedulerTask*) malloc(2 * deque->capacity * sizeof(SchedulerTask));
+        for (uint32_t i = 0; i < deque->count; i++)
+        {
+            tasks[i] = deque->tasks[(deque->top + i) % deque->capacity];
+        }
+        free(deque->tasks);
+        deque->tasks     = tasks;
+        deque->top       = 0;
+        deque->capacity *= 2;
+    }
+    deque->tasks[(deque->top + deque->count) % deque->capacity] = task;
+    deque->count += 1;
+    SDL_UnlockMutex(deque->lock);
+}
+
+static bool pop_bottom(TaskDeque *deque, SchedulerTask *task)
+{
+    bool found = false;
+    SDL_LockMutex(deque->lock);
+    if (deque->count != 0)
+    {
+        deque->count -= 1;
+        *task = deque->tasks[(deque->top + deque->count) % deque->capacity];
+        found = true;
+    }
+    SDL_UnlockMutex(deque->lock);
+    return found;
+}
+
+static bool steal_top(TaskDeque *deque, SchedulerTask *task)
+{
+    bool found = false;
+    if (SDL_TryLockMutex(deque->lock) != 0) return false; // Busy victim, try another.
+    if (deque->count != 0)
+    {
+        *task = deque->tasks[deque->top];
+        deque->top    = (deque->top + 1) % deque->capacity;
+        deque->count -= 1;
+        found = true;
+    }
+    SDL_UnlockMutex(deque->lock);
+    return found;
+}
+
+/* ================== WORKERS ================== */
+
+static uint32_t next_random(Worker *worker)
+{
+    uint32_t x = worker->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x <<  5;
+    worker->seed = x;
+    return x;
+}
+
+static bool steal_task(Worker *worker, SchedulerTask *task)
+{
+    Scheduler *scheduler = worker->scheduler;
+    uint16_t           n = scheduler->num_workers;
+    if (n < 2) return false;
+
+    uint16_t start = next_random(worker) % n;
+    for (uint16_t i = 0; i < n; i++)
+    {
+        uint16_t victim = (start + i) % n;
+        if (victim == worker->id) continue;
+        if (steal_top(&scheduler->workers[victim].deque, task))
+        {
+            worker->tasks_stolen += 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool take_task(Worker *worker, SchedulerTask *task)
+{
+    Scheduler *scheduler = worker->scheduler;
+    bool found = pop_bottom(&worker->deque, task) || steal_task(worker, task);
+    if (found) atomic_fetch_sub_explicit(&scheduler->queued, 1, memory_order_relaxed);
+    return found;
+}
+
+static void finish_task(Scheduler *scheduler)
+{
+    if (atomic_fetch_sub_explicit(&scheduler->outstanding, 1, memory_order_acq_rel) != 1) return;
+    SDL_LockMutex(scheduler->mutex); // Last one out, a waiter is either asleep or yet to check.
+    SDL_CondBroadcast(scheduler->all_done);
+    SDL_UnlockMutex(scheduler->mutex);
+}
+
+static int worker_thread(void *data)
+{
+    Worker       *worker = (Worker*) data;
+    Scheduler *scheduler = worker->scheduler;
+    SchedulerTask   task;
+
+    while (true)
+    {
+        if (take_task(worker, &task))
+        {
+            Uint64 start = SDL_GetPerformanceCounter();
+            scheduler->handler(scheduler->context, &task);
+            atomic_fetch_add_explicit(&worker->busy_ticks, SDL_GetPerformanceCounter() - start, memory_order_relaxed);
+            worker->tasks_run  += 1;
+            finish_task(scheduler);
+            continue;
+        }
+
+        // Nothing to pop or steal; sleep until a submission or shutdown.
+        SDL_LockMutex(scheduler->mutex);
+        while (scheduler->running && (atomic_load(&scheduler->queued) == 0))
+        {
+            SDL_CondWait(scheduler->work_ready, scheduler->mutex);
+        }
+        bool running = scheduler->running;
+        SDL_UnlockMutex(scheduler->mutex);
+        if (!running) break;
+    }
+    return 0;
+}
+
+/* ================== PUBLIC API ================= */
+
+Scheduler *init_scheduler(uint16_t num_workers, TaskHandler handler, void *context)
+{
+    if (num_workers == 0)
+    {
+        int cpus    = SDL_GetCPUCount();
+        num_workers = (cpus < 1) ? 1 : (cpus > UINT16_MAX) ? UINT16_MAX : (uint16_t) cpus;
+    }
+
+    Scheduler *scheduler   = (Scheduler*) calloc(1, sizeof(Scheduler));
+    scheduler->workers     = (Worker*) calloc(num_workers, sizeof(Worker));
+    scheduler->threads     = (SDL_Thread**) calloc(num_workers, sizeof(SDL_Thread*));
+    scheduler->num_workers = num_workers;
+    scheduler->handler     = handler;
+    scheduler->context     = context;
+    scheduler->mutex       = SDL_CreateMutex();
+    scheduler->work_ready  = SDL_CreateCond();
+    scheduler->all_done    = SDL_CreateCond();
+    scheduler->running     = true;
+    scheduler->stats_epoch = SDL_GetPerformanceCounter();
+
+    for (uint16_t w = 0; w < num_workers; w++)
+    {
+        Worker *worker    = &scheduler->workers[w];
+        worker->scheduler = scheduler;
+        worker->id        = w;
+        worker->seed      = 0x9E3779B9u * (w + 1); // Any non-zero seed works for xorshift.
+        init_deque(&worker->deque);
+    }
+
+    for (uint16_t w = 0; w < num_workers; w++)
+    {
+        scheduler->threads[w] = SDL_CreateThread(worker_thread, "Scheduler Worker", &scheduler->workers[w]);
+        if (!scheduler->threads[w])
+        {
+            LOG_MESSAGE(ERROR, "Could not create worker %d: %s", w, SDL_GetError());
+            tidy_scheduler(scheduler);
+            return NULL;
+        }
+    }
+    return scheduler;
+}
+
+void tidy_scheduler(Scheduler *scheduler)
+{
+    SDL_LockMutex(scheduler->mutex);
+    scheduler->running = false;
+    SDL_CondBroadcast(scheduler->work_ready);
+    SDL_UnlockMutex(scheduler->mutex);
+
+    for (uint16_t w = 0; w < scheduler->num_workers; w++)
+    {
+        if (scheduler->threads[w]) SDL_WaitThread(scheduler->threads[w], NULL);
+        tidy_deque(&scheduler->workers[w].deque);
+    }
+
+    SDL_DestroyCond(scheduler->all_done);
+    SDL_DestroyCond(scheduler->work_ready);
+    SDL_DestroyMutex(scheduler->mutex);
+    free(scheduler->threads); scheduler->threads = NULL;
+    free(scheduler->workers); scheduler->workers = NULL;
+    free(scheduler);
+}
+
+void submit_task(Scheduler *scheduler, uint32_t index, uint32_t frames)
+{
+    SchedulerTask task = { .index = index, .frames = frames };
+    uint16_t    target = scheduler->next_worker;
+    scheduler->next_worker = (target + 1) % scheduler->num_workers;
+
+    // Count first, so a worker that grabs the task early never sees the counters underflow.
+    atomic_fetch_add_explicit(&scheduler->outstanding, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&scheduler->queued,      1, memory_order_relaxed);
+
+    push_bottom(&scheduler->workers[target].deque, task);
+
+    SDL_LockMutex(scheduler->mutex); // A worker between its queued check and its wait still gets the wakeup.
+    SDL_CondBroadcast(scheduler->work_ready);
+    SDL_UnlockMutex(scheduler->mutex);
+}
+
+void wait_scheduler(Scheduler *scheduler)
+{
+    SDL_LockMutex(scheduler->mutex);
+    while (atomic_load(&scheduler->outstanding) != 0)
+    {
+        SDL_CondWait(scheduler->all_done, scheduler->mutex);
+    }
+    SDL_UnlockMutex(scheduler->mutex);
+}
+
+uint16_t get_worker_count(Scheduler *scheduler)
+{
+    return scheduler->num_workers;
+}
+
+double get_worker_utilization(Scheduler *scheduler, uint16_t worker)
+{
+    if (worker >= scheduler->num_workers) return 0.0;
+    Uint64 elapsed = SDL_GetPerformanceCounter() - scheduler->stats_epoch;
+    if (elapsed == 0) return 0.0;
+    return (double) atomic_load_explicit(&scheduler->workers[worker].busy_ticks, memory_order_relaxed) / (double) elapsed;
+}
+
+void reset_scheduler_stats(Scheduler *scheduler)
+{
+    for (uint16_t w = 0; w < scheduler->num_workers; w++)
+    {
+        Worker *worker       = &scheduler->workers[w];
+        atomic_store(&worker->busy_ticks, 0);
+        worker->tasks_run    = 0;
+        worker->tasks_stolen = 0;
+    }
+    scheduler->stats_epoch = SDL_GetPerformanceCounter();
+}
+
+void print_scheduler_stats(Scheduler *scheduler)
+{
+    for (uint16_t w = 0; w < scheduler->num_workers; w++)
+    {
+        Worker *worker = &scheduler->workers[w];
+        LOG_MESSAGE
+        (
+            INFO,
+            "Worker %2d: %5.1f%% busy, %u tasks (%u stolen)",
+            w,
+            100.0 * get_worker_utilization(scheduler, w),
+            worker->tasks_run,
+            worker->tasks_stolen
+        );
+    }
+}
@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cart.h"
+#include "cpu.h"
+#include "logger.h"
+#include "machine.h"
+#include "mmu.h"
+#include "page.h"
+#include "ppu.h"
+#include "snapshot.h"
+#include "timer.h"
+
+#define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
+#define BOOT_PATH_SIZE 512
+
+size_t gbc_snapshot_size(GbcMachine *gb)
+{
+    return sizeof(SnapshotHeader)       +
+           get_cpu_snapshot_size(gb)      +
+           get_memory_snapshot_size(gb)   +
+           get_graphics_snapshot_size(gb) +
+           get_timer_snapshot_size(gb)    +
+           get_cartridge_snapshot_size(gb);
+}
+
+size_t gbc_snapshot_save(GbcMachine *gb, uint8_t *buffer, size_t size)
+{
+    size_t needed = gbc_snapshot_size(gb);
+    if (size < needed)
+    {
+        LOG_MESSAGE(ERROR, "Snapshot needs %zu bytes, buffer has %zu.", needed, size);
+        return 0;
+    }
+
+    SnapshotHeader header =
+    {
+        .magic    = SNAPSHOT_MAGIC,
+        .version  = SNAPSHOT_VERSION,
+        .reserved = 0,
+        .size     = (uint32_t) needed,
+        .rom_hash = get_rom_hash(gb)
+    };
+    memcpy(buffer, &header, sizeof(SnapshotHeader));
+
+    catch_up_ppu(gb); // LY, STAT and the LCD are saved with the memory, ahead of the PPU section.
+    uint8_t *cursor = buffer + sizeof(SnapshotHeader);
+    cursor = save_cpu_snapshot(gb, cursor);
+    cursor = save_memory_snapshot(gb, cursor);
+    cursor = save_graphics_snapshot(gb, cursor);
+    cursor = save_timer_snapshot(gb, cursor);
+    cursor = save_cartridge_snapshot(gb, cursor);
+
+    return (size_t) (cursor - buffer);
+}
+
+bool gbc_snapshot_load(GbcMachine *gb, const uint8_t *buffer, size_t size)
+{
+    SnapshotHeader header;
+    if (size < sizeof(SnapshotHeader)) return false;
+    memcpy(&header, buffer, sizeof(SnapshotHeader));
+
+    if ((header.magic != SNAPSHOT_MAGIC) || (header.version != SNAPSHOT_VERSION))
+    {
+        LOG_MESSAGE(ERROR, "Not a version %d snapshot.", SNAPSHOT_VERSION);
+        return false;
+    }
+    if ((header.size != gbc_snapshot_size(gb)) || (size < header.size))
+    {
+        LOG_MESSAGE(ERROR, "Snapshot size %u does not match this machine.", header.size);
+        return false;
+    }
+    if (header.rom_hash != get_rom_hash(gb))
+    {
+        LOG_MESSAGE(ERROR, "Snapshot was taken with a different ROM.");
+        return false;
+    }
+
+    const uint8_t *cursor = buffer + sizeof(SnapshotHeader);
+    cursor = load_cpu_snapshot(gb, cursor);
+    cursor = load_memory_snapshot(gb, cursor);
+    cursor = load_graphics_snapshot(gb, cursor);
+    cursor = load_timer_snapshot(gb, cursor);
+    cursor = load_cartridge_snapshot(gb, cursor);
+
+    return true;
+}
+
+/* BOOT CACHE */
+
+static void get_boot_snapshot_path(GbcMachine *gb, char *buffer, size_t size) // Next to the ROM, keyed by its hash.
+{
+    snprintf(buffer, size, "%s.%08X.boot", gb->cartridge_file, get_rom_hash(gb));
+}
+
+void capture_boot_snapshot(GbcMachine *gb)
+{
+    gb->boot_pending = false;
+
+    size_t        size = gbc_snapshot_size(gb);
+    uint8_t *snapshot = alloc_page(size);
+    gbc_snapshot_save(gb, snapshot, size);
+    release_page(gb->boot_snapshot);
+    gb->boot_snapshot = snapshot;
+    LOG_MESSAGE(INFO, "Captured %zu byte boot snapshot.", size);
+
+    if (gb->persist_boot) write_boot_snapshot_file(gb);
+}
+
+bool restore_boot_snapshot(GbcMachine *gb)
+{
+    if (gb->boot_snapshot == NULL) return false;
+    return gbc_snapshot_load(gb, gb->boot_snapshot, get_page_size(gb->boot_snapshot));
+}
+
+void set_boot_persistence(GbcMachine *gb, bool persist)
+{
+    gb->persist_boot = persist;
+}
+
+bool write_boot_snapshot_file(GbcMachine *gb)
+{
+    if (gb->boot_snapshot == NULL) return false;
+
+    char path[BOOT_PATH_SIZE];
+    get_boot_snapshot_path(gb, path, BOOT_PATH_SIZE);
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        LOG_MESSAGE(ERROR, "Failed to open %s.", path);
+        return false;
+    }
+    size_t size = get_page_size(gb->boot_snapshot);
+    bool written = (fwrite(gb->boot_snapshot, 1, size, file) == size);
+    fclose(file);
+    return written;
+}
+
+bool read_boot_snapshot_file(GbcMachine *gb)
+{
+    char path[BOOT_PATH_SIZE];
+    get_boot_snapshot_path(gb, path, BOOT_PATH_SIZE);
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return false; // Not cached yet.
+
+    size_t        size = gbc_snapshot_size(gb);
+    uint8_t *snapshot = alloc_page(size);
+    SnapshotHeader header;
+    bool valid = (fread(snapshot, 1, size, file) == size);
+    fclose(file);
+
+    memcpy(&header, snapshot, sizeof(SnapshotHeader));
+    valid = valid &&
+    (
+        (header.magic    == SNAPSHOT_MAGIC)   &&
+        (header.version  == SNAPSHOT_VERSION) &&
+        (header.size     == size)             &&
+        (header.rom_hash == get_rom_hash(gb))
+    );
+    if (!valid)
+    {
+        LOG_MESSAGE(ERROR, "Ignoring stale boot snapshot %s.", path);
+        release_page(snapshot);
+        return false;
+    }
+
+    release_page(gb->boot_snapshot);
+    gb->boot_snapshot = snapshot;
+    return true;
+}
@@ -5,9 +5,10 @@
 
 static void load_rom(char *path)
 {
-    init_emulator(path, true);
-    start_emulator();
-    tidy_emulator(true);
+    GbcMachine *gb = init_emulator(path, true);
+    if (!gb) return;
+    start_emulator(gb, NULL);
+    tidy_emulator(gb, true);
     SDL_Delay(100);
 }
 
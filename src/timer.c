@@ -2,20 +2,24 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "arena.h"
 #include "common.h"
 #include "ppu.h"
 #include "cpu.h"
 #include "mmu.h"
 #include "timer.h"
 #include "logger.h"
+#include "snapshot.h"
+#include "util.h"
+#include "machine.h"
 
 #define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
 #define DEFAULT_MACHINE_CYCLE_DELAY   4 // System  Cycles
 #define DEFAULT_TIMA_OVERFLOW_DELAY   4 // Machine Cycles (1 Cycle After Enabled)
 
-typedef void (*EventHandler)();
+typedef void (*EventHandler)(GbcMachine*);
 
-typedef struct // Event handler will interpret delay in T-Cycles.
+typedef struct SystemCycleEvent // Event handler will interpret delay in T-Cycles.
 {
     bool          active;
     int8_t         delay;
@@ -23,6 +27,22 @@ typedef struct // Event handler will interpret delay in T-Cycles.
 
 } SystemCycleEvent;
 
+typedef uint32_t (*EventDelay)(GbcMachine*); // Dots before the next one that has to be stepped, 0 = the next one.
+
+typedef struct ScheduledEvent
+{
+    uint64_t  at; // Dot (gb->clock) that has to be stepped in full.
+    uint8_t kind; // EventKind
+
+} ScheduledEvent;
+
+typedef struct EventQueue // Binary min-heap on 'at', always holding one entry per EventKind.
+{
+    ScheduledEvent heap[EVENT_COUNT];
+    uint8_t       index[EVENT_COUNT]; // Heap position of each kind.
+
+} EventQueue;
+
 static const uint8_t sys_shift_table[4] = {
     9, // TAC = 0b00 → 4096 Hz
     3, // TAC = 0b01 → 262144 Hz
@@ -30,130 +50,399 @@ static const uint8_t sys_shift_table[4] = {
     7  // TAC = 0b11 → 16384 Hz
 };
 
-static SystemCycleEvent*  tima_overflow;
-static uint32_t             current_dot;
+/* EVENT SCHEDULER */
+
+static void swap_events(EventQueue *queue, uint8_t a, uint8_t b)
+{
+    ScheduledEvent event = queue->heap[a];
+    queue->heap[a] = queue->heap[b];
+    queue->heap[b] = event;
+    queue->index[queue->heap[a].kind] = a;
+    queue->index[queue->heap[b].kind] = b;
+}
+
+static void set_event(GbcMachine *gb, EventKind kind, uint64_t at)
+{
+    EventQueue *queue = gb->events;
+    uint8_t         i = queue->index[kind];
+    queue->heap[i].at = at;
+    while ((i > 0) && (queue->heap[(i - 1) / 2].at > queue->heap[i].at))
+    { // Sift up
+        swap_events(queue, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+    while (true)
+    { // Sift down
+        uint8_t least = i;
+        uint8_t  left = (2 * i) + 1;
+        uint8_t right = (2 * i) + 2;
+        if ((left  < EVENT_COUNT) && (queue->heap[left].at  < queue->heap[least].at)) least = left;
+        if ((right < EVENT_COUNT) && (queue->heap[right].at < queue->heap[least].at)) least = right;
+        if (least == i) break;
+        swap_events(queue, i, least);
+        i = least;
+    }
+}
+
+static uint64_t get_next_event(GbcMachine *gb)
+{
+    return gb->events->heap[0].at;
+}
 
-static uint16_t      sys;
-static uint8_t     *div_;
-static uint8_t      *tac;
-static uint8_t      *tma;
-static uint8_t     *tima;
+static bool is_event_due(GbcMachine *gb) // The current dot has to be stepped in full.
+{
+    return get_next_event(gb) <= gb->clock;
+}
 
-bool prev_sys_bit;
+void refresh_event(GbcMachine *gb, EventKind kind)
+{
+    set_event(gb, kind, gb->clock); // Stepping it recomputes the real delay.
+}
 
-static bool get_current_sys_bit()
+static bool get_current_sys_bit(GbcMachine *gb)
 {
-    uint8_t    select = (*tac) & LOWER_2_MASK;
-    bool curr_sys_bit = (sys >> sys_shift_table[select]) & BIT_0_MASK;
+    uint8_t    select = (*gb->tac) & LOWER_2_MASK;
+    bool curr_sys_bit = (gb->sys >> sys_shift_table[select]) & BIT_0_MASK;
     return curr_sys_bit;
 }
 
-static void inc_tima(bool incrementing)
+static void inc_tima(GbcMachine *gb, bool incrementing)
 {
-    (*tima) += 1;
+    (*gb->tima) += 1;
 
-    if ((*tima == 0) && incrementing) // Overflow only triggers on SYS increments.
+    if ((*gb->tima == 0) && incrementing) // Overflow only triggers on SYS increments.
     { // overflow
-        tima_overflow->active = true;
-        tima_overflow-> delay = DEFAULT_TIMA_OVERFLOW_DELAY;
+        gb->tima_overflow->active = true;
+        gb->tima_overflow-> delay = DEFAULT_TIMA_OVERFLOW_DELAY;
     }
 }
 
-static void check_tima_inc(bool incrementing) // Falling edge detection multiplexer. 
+static void check_tima_inc(GbcMachine *gb, bool incrementing) // Falling edge detection multiplexer. 
 {
-    bool   inc_enable = (*tac) & BIT_2_MASK;
-    bool curr_sys_bit = get_current_sys_bit();
-    if (prev_sys_bit && !curr_sys_bit && inc_enable) inc_tima(incrementing);
-    prev_sys_bit = curr_sys_bit;
+    bool   inc_enable = (*gb->tac) & BIT_2_MASK;
+    bool curr_sys_bit = get_current_sys_bit(gb);
+    if (gb->prev_sys_bit && !curr_sys_bit && inc_enable) inc_tima(gb, incrementing);
+    gb->prev_sys_bit = curr_sys_bit;
 }
 
-static void write_sys(uint16_t value, bool incrementing)
+static void write_sys(GbcMachine *gb, uint16_t value, bool incrementing)
 {
-    sys   =  value & LOWER_14_MASK;
-    *div_ = (sys >> 6) & LOWER_BYTE_MASK;
-    check_tima_inc(incrementing);
+    gb->sys   =  value & LOWER_14_MASK;
+    *gb->div_ = (gb->sys >> 6) & LOWER_BYTE_MASK;
+    check_tima_inc(gb, incrementing);
 }
 
-void clear_sys() // MMU Interface for writing to DIV. 
+void clear_sys(GbcMachine *gb) // MMU Interface for writing to DIV. 
 { // 'Writing to DIV'
-    write_sys(0, false);
+    write_sys(gb, 0, false);
+    refresh_event(gb, EVENT_TIMER);
 }
 
-void write_tima(uint8_t value) // MMU Interface for writing to TIMA.
+void write_tima(GbcMachine *gb, uint8_t value) // MMU Interface for writing to TIMA.
 {
-    (*tima) = value;
-    prev_sys_bit = get_current_sys_bit(); // Resync to prevent increment pulse.
+    (*gb->tima) = value;
+    gb->prev_sys_bit = get_current_sys_bit(gb); // Resync to prevent increment pulse.
+    refresh_event(gb, EVENT_TIMER);
 }   
 
-void write_tac(uint8_t value)
+void write_tac(GbcMachine *gb, uint8_t value)
 {
-    (*tac) = value;
-    check_tima_inc(false);
+    (*gb->tac) = value;
+    check_tima_inc(gb, false);
+    refresh_event(gb, EVENT_TIMER);
 }
 
-static void check_cycle_event(SystemCycleEvent *event)
+static void check_cycle_event(GbcMachine *gb, SystemCycleEvent *event)
 {
     if (event->active)
     {
         if (--event->delay <= 0)
         {
-            event->handler();
+            event->handler(gb);
         }
     }
 }
 
-static void tima_overflow_handler()
+static void tima_overflow_handler(GbcMachine *gb)
+{
+    (*gb->tima) = (*gb->tma);
+    request_interrupt(gb, TIMER_INTERRUPT_CODE);
+    gb->tima_overflow->active = false; // Consume the Event.
+}
+
+static uint32_t get_quiet_timer_dots(GbcMachine *gb) // Dots before TIMA overflows.
+{
+    if (gb->tima_overflow->active)     return 0;
+    if (!((*gb->tac) & BIT_2_MASK))    return UINT32_MAX;
+    uint8_t  shift = sys_shift_table[(*gb->tac) & LOWER_2_MASK] + 1;
+    uint32_t edges = 0x100 - (*gb->tima);
+    uint32_t  wrap = (((uint32_t) gb->sys >> shift) + edges) << shift; // SYS value whose edge overflows.
+    return wrap - gb->sys - 1;
+}
+
+static uint32_t get_frame_delay(GbcMachine *gb) // The wrap is stepped, run_frames() watches it.
+{
+    return DOT_PER_FRAME - 1 - gb->current_dot;
+}
+
+static uint32_t get_boot_delay(GbcMachine *gb)
+{
+    return gb->boot_pending ? 0 : UINT32_MAX;
+}
+
+static const EventDelay event_delay[EVENT_COUNT] =
+{
+    [EVENT_PPU]   = get_ppu_deadline,
+    [EVENT_TIMER] = get_quiet_timer_dots,
+    [EVENT_DMA]   = get_dma_dots,
+    [EVENT_FRAME] = get_frame_delay,
+    [EVENT_BOOT]  = get_boot_delay
+};
+
+static void reschedule_events(GbcMachine *gb) // Between dots, after one was stepped in full.
+{
+    while (get_next_event(gb) < gb->clock)
+    {
+        EventKind kind = gb->events->heap[0].kind;
+        set_event(gb, kind, gb->clock + event_delay[kind](gb));
+    }
+}
+
+static void begin_dot(GbcMachine *gb) // Everything that runs before the CPU's slot in a dot.
+{
+    sync_ppu(gb);                // PPU
+    check_dma(gb);               // MMU, releases the bus once an OAM DMA is done
+}
+
+static void end_dot(GbcMachine *gb) // Everything that runs after it.
+{
+    check_cycle_event(gb, gb->tima_overflow);
+    write_sys(gb, (gb->sys + 1), true);  // TIMER
+
+    gb->clock      += 1;
+    gb->current_dot = ((gb->current_dot + 1) % DOT_PER_FRAME);
+    if (gb->current_dot == 0) gb->frame_count += 1;
+    if (gb->boot_pending) capture_boot_snapshot(gb); // Between dots, so nothing is half-done.
+    reschedule_events(gb);
+}
+
+static void advance_sys(GbcMachine *gb, uint32_t dots) // Closed form of 'dots' write_sys() increments.
+{
+    uint32_t sys = (uint32_t) gb->sys + dots;
+    if ((*gb->tac) & BIT_2_MASK)
+    { // One falling edge per multiple of 2^(shift + 1) crossed, never reaching the overflow.
+        uint8_t shift = sys_shift_table[(*gb->tac) & LOWER_2_MASK] + 1;
+        (*gb->tima) += (sys >> shift) - ((uint32_t) gb->sys >> shift);
+    }
+    gb->sys          = sys & LOWER_14_MASK;
+    *gb->div_        = (gb->sys >> 6) & LOWER_BYTE_MASK;
+    gb->prev_sys_bit = get_current_sys_bit(gb);
+}
+
+static void skip_dots(GbcMachine *gb, uint32_t dots) // Dots before the next event, where only the counters move.
+{
+    advance_sys(gb, dots);
+    gb->clock       += dots;
+    gb->current_dot += dots;
+}
+
+static void open_dot(GbcMachine *gb)
+{
+    if (is_event_due(gb)) begin_dot(gb);
+}
+
+static bool close_dot(GbcMachine *gb) // Checked again, the CPU may have refreshed an event in between.
 {
-    (*tima) = (*tma);
-    request_interrupt(TIMER_INTERRUPT_CODE);
-    tima_overflow->active = false; // Consume the Event.
+    bool due = is_event_due(gb);
+    if (due) end_dot(gb);
+    else     skip_dots(gb, 1);
+    return due;
+}
+
+static uint32_t run_dots(GbcMachine *gb, uint32_t dots) // Whole dots without the CPU, stopping after a frame wraps.
+{
+    uint32_t run = 0;
+    while (run < dots)
+    {
+        uint64_t quiet = get_next_event(gb) - gb->clock;
+        if (quiet == 0)
+        {
+            begin_dot(gb);
+            end_dot(gb);
+            run += 1;
+            if (gb->current_dot == 0) break;
+            continue;
+        }
+        uint32_t span = ((dots - run) < quiet) ? (dots - run) : (uint32_t) quiet;
+        skip_dots(gb, span);
+        run += span;
+    }
+    return run;
 }
 
-uint32_t system_clock_pulse() // Emulator Interface
+void sync_machine_cycles(GbcMachine *gb) // CPU Interface for FAST_EXECUTION.
 {
-    dot(current_dot);            // PPU
-    check_dma();                 // MMU
+    uint8_t owed = gb->owed_cycles;
+    gb->owed_cycles = 0; // Cleared first, so nothing run while we catch up syncs again.
+    if (owed == 0) return;
+
+    uint8_t  scaler = get_machine_cycle_scaler(gb);
+    uint32_t  slots = (scaler - (gb->sys % scaler)) + ((owed - 1) * scaler); // Dots to the owed-th next slot.
+    close_dot(gb);
+    for (uint32_t left = slots - 1; left > 0; left -= run_dots(gb, left));
+    open_dot(gb);
+}
 
-    if ((sys % get_machine_cycle_scaler()) == 0)
+static uint32_t get_poll_dots(GbcMachine *gb, uint8_t polls) // Dots before a polled register changes.
+{
+    uint32_t dots = UINT32_MAX;
+    if (polls & (POLL_LY | POLL_STAT)) dots = get_ppu_countdown(gb); // Not an event anymore, the PPU runs lazily.
+    if (polls & POLL_DIV)
     {
-        machine_cycle();
+        uint32_t div = DIV_INC_PERIOD - (gb->sys % DIV_INC_PERIOD);
+        if (dots > div) dots = div;
     }
-    check_cycle_event(tima_overflow);
-    write_sys((sys + 1), true);  // TIMER
+    if ((polls & POLL_TIMA) && ((*gb->tac) & BIT_2_MASK))
+    {
+        uint8_t  shift = sys_shift_table[(*gb->tac) & LOWER_2_MASK] + 1;
+        uint32_t  edge = ((((uint32_t) gb->sys >> shift) + 1) << shift) - gb->sys;
+        if (dots > edge) dots = edge;
+    }
+    return dots;
+}
+
+static void skip_idle_dots(GbcMachine *gb, uint64_t limit) // HALT and polling loops, up to the dot that can change their course.
+{
+    uint64_t quiet = get_next_event(gb) - gb->clock;
+    if (quiet > (limit - gb->clock)) quiet = limit - gb->clock;
+    if (gb->no_idle_skip || (quiet == 0) || cpu_stalled(gb)) return; // Stalled slots are counted one by one.
+
+    uint8_t   polls = 0;
+    bool   sleeping = cpu_sleeping(gb);
+    uint32_t period = sleeping ? 1 : get_idle_period(gb, &polls);
+    if (period == 0) return;
+
+    uint32_t dots = get_poll_dots(gb, polls);
+    if (dots > quiet) dots = (uint32_t) quiet;
+    dots -= (dots % period); // Whole loop iterations only.
+    if (dots == 0) return;
+
+    skip_dots(gb, dots);
+    if (sleeping) gb->halted_dots  += dots;
+    else          gb->polling_dots += dots;
+}
 
-    current_dot = ((current_dot + 1) % DOT_PER_FRAME);
-    return current_dot;
+static void run_slots(GbcMachine *gb, uint64_t limit) // Stops at the next due event, a new frame or gb->clock == limit.
+{
+    uint32_t frame = gb->frame_count;
+    bool   stepped = false;
+    do
+    { // The CPU runs slot after slot until an event is due, quiet dots in between cost nothing.
+        skip_idle_dots(gb, limit);
+        uint8_t scaler = get_machine_cycle_scaler(gb);
+        uint32_t  wait = (scaler - (gb->sys % scaler)) % scaler;
+        if (wait > (limit - gb->clock)) wait = (uint32_t) (limit - gb->clock);
+        run_dots(gb, wait);
+        if ((gb->frame_count != frame) || (gb->clock == limit)) break;
+
+        uint64_t wrap = gb->clock + (DOT_PER_FRAME - gb->current_dot);
+        gb->slot_horizon = (limit < wrap) ? limit : wrap;
+        open_dot(gb);
+        machine_cycle(gb);
+        stepped = close_dot(gb); // Whatever the CPU triggered (a BIOS unmap, say) is done by the time we return.
+    } while (!stepped && !is_event_due(gb) && (gb->frame_count == frame) && (gb->clock < limit));
+}
+
+uint32_t system_clock_pulse(GbcMachine *gb) // Emulator Interface
+{
+    run_slots(gb, UINT64_MAX);
+    return gb->current_dot;
+}
+
+void run_machine_dots(GbcMachine *gb, uint64_t dots)
+{
+    uint64_t limit = gb->clock + dots;
+    while (gb->clock < limit) run_slots(gb, limit);
+}
+
+void set_idle_skipping(GbcMachine *gb, bool enabled)
+{
+    gb->no_idle_skip = !enabled;
+}
+
+IdleStats get_idle_stats(GbcMachine *gb)
+{
+    IdleStats stats;
+    stats. halted = gb->halted_dots;
+    stats.polling = gb->polling_dots;
+    stats.  total = gb->clock;
+    return stats;
 }
 
-char *get_emu_time(char *buffer, size_t size)
+char *get_emu_time(GbcMachine *gb, char *buffer, size_t size)
 {
     snprintf(
         buffer, 
         size, 
         "%02X:%02X:%02X:%04X", 
-        (*tac), (*tma), (*tima), sys
+        (*gb->tac), (*gb->tma), (*gb->tima), gb->sys
     );
     return buffer;
 }
 
-void init_timer()
+void init_timer(GbcMachine *gb)
 {
-    tima_overflow           = (SystemCycleEvent*) malloc(sizeof(SystemCycleEvent));
-    tima_overflow->  active = false;
-    tima_overflow->   delay = DEFAULT_TIMA_OVERFLOW_DELAY;
-    tima_overflow-> handler = tima_overflow_handler;
+    gb->events = (EventQueue*) arena_alloc(gb->arena, sizeof(EventQueue));
+    for (uint8_t kind = 0; kind < EVENT_COUNT; kind++)
+    { // All due, the first dot schedules them for real.
+        gb->events->heap[kind].at   = gb->clock;
+        gb->events->heap[kind].kind = kind;
+        gb->events->index[kind]     = kind;
+    }
 
-    current_dot  = 0;
-    prev_sys_bit = 0;
+    gb->tima_overflow           = (SystemCycleEvent*) arena_alloc(gb->arena, sizeof(SystemCycleEvent));
+    gb->tima_overflow->  active = false;
+    gb->tima_overflow->   delay = DEFAULT_TIMA_OVERFLOW_DELAY;
+    gb->tima_overflow-> handler = tima_overflow_handler;
 
-    sys  = 0; // Grab pointers here carefully.
-    div_ = get_memory_pointer(DIV);
-    tac  = get_memory_pointer(TAC);
-    tma  = get_memory_pointer(TMA);
-    tima = get_memory_pointer(TIMA); 
+    gb->current_dot  = 0;
+    gb->prev_sys_bit = 0;
+
+    gb->sys  = 0; // Grab pointers here carefully.
+    gb->div_ = get_memory_pointer(gb, DIV);
+    gb->tac  = get_memory_pointer(gb, TAC);
+    gb->tma  = get_memory_pointer(gb, TMA);
+    gb->tima = get_memory_pointer(gb, TIMA); 
 }
 
-void tidy_timer()
+void tidy_timer(GbcMachine *gb)
 {
-    free(tima_overflow); tima_overflow = NULL;
-}
\ No newline at end of file
+    gb->tima_overflow = NULL; // Both live in the arena.
+    gb->events        = NULL;
+}
+
+size_t get_timer_snapshot_size(GbcMachine *gb)
+{
+    return sizeof(bool) + sizeof(int8_t) + sizeof(uint32_t) + sizeof(uint16_t) + sizeof(bool);
+}
+
+uint8_t *save_timer_snapshot(GbcMachine *gb, uint8_t *dest) // DIV, TIMA, TMA and TAC live in memory.
+{
+    dest = pack_bytes(dest, &gb->tima_overflow->active, sizeof(bool));
+    dest = pack_bytes(dest, &gb->tima_overflow->delay,  sizeof(int8_t));
+    dest = pack_bytes(dest, &gb->current_dot,           sizeof(uint32_t));
+    dest = pack_bytes(dest, &gb->sys,                   sizeof(uint16_t));
+    dest = pack_bytes(dest, &gb->prev_sys_bit,          sizeof(bool));
+    return dest;
+}
+
+const uint8_t *load_timer_snapshot(GbcMachine *gb, const uint8_t *src)
+{
+    src = unpack_bytes(src, &gb->tima_overflow->active, sizeof(bool));
+    src = unpack_bytes(src, &gb->tima_overflow->delay,  sizeof(int8_t));
+    src = unpack_bytes(src, &gb->current_dot,           sizeof(uint32_t));
+    src = unpack_bytes(src, &gb->sys,                   sizeof(uint16_t));
+    src = unpack_bytes(src, &gb->prev_sys_bit,          sizeof(bool));
+    for (uint8_t kind = 0; kind < EVENT_COUNT; kind++) refresh_event(gb, kind); // Every register may have moved.
+    return src;
+}
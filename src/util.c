@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include "logger.h"
 #include "util.h"
 
@@ -8,31 +9,35 @@
 
 /* CIRCULAR QUEUE IMPLEMENTATION FOR PIXEL FETCHER */
 
-Queue *init_queue(uint16_t capacity)
+static size_t get_queue_footprint(uint16_t capacity)
+{
+    return sizeof(Queue) + (capacity * sizeof(GbcPixel*)) + (capacity * sizeof(GbcPixel));
+}
+
+static Queue *place_queue(void *memory, uint16_t capacity)
 {
-    Queue *queue    = (Queue*) malloc(sizeof(Queue));
+    Queue    *queue = (Queue*) memory;
+    GbcPixel *slots = (GbcPixel*) ((uint8_t*) memory + sizeof(Queue) + (capacity * sizeof(GbcPixel*)));
     queue->capacity = capacity;
-    queue->items    = (GbcPixel**) malloc(capacity * sizeof(GbcPixel*));
+    queue->items    = (GbcPixel**) ((uint8_t*) memory + sizeof(Queue));
     queue->front    = -1;
     queue->rear     = -1;
     queue->size     =  0;
-    for (uint8_t i = 0; i < capacity; i++)
-    {
-        queue->items[i] = (GbcPixel*) malloc(sizeof(GbcPixel));
+    for (uint16_t i = 0; i < capacity; i++)
+    { // Slots are contiguous, a scanline's worth of pixels is one run of memory.
+        queue->items[i] = &slots[i];
     }
     return queue;
 }
 
+Queue *init_queue(uint16_t capacity)
+{
+    return place_queue(calloc(1, get_queue_footprint(capacity)), capacity);
+}
+
 void tidy_queue(Queue *queue)
 {
-    for (uint8_t i = 0; i < queue->capacity; i++)
-    {
-        free(queue->items[i]);
-    }
-    free(queue->items);
-    queue->items = NULL;
-    free(queue);
-    queue = NULL;
+    free(queue); // Header, item pointers and slots are one allocation.
 }
 
 bool is_full(Queue *queue)
@@ -125,3 +130,46 @@ void print_queue(Queue *queue)
     }
     LOG_MESSAGE(TEST, "");
 }
+
+/* SNAPSHOT SUPPORT */
+
+uint8_t *pack_bytes(uint8_t *dest, const void *src, size_t size)
+{
+    memcpy(dest, src, size);
+    return dest + size;
+}
+
+const uint8_t *unpack_bytes(const uint8_t *src, void *dest, size_t size)
+{
+    memcpy(dest, src, size);
+    return src + size;
+}
+
+size_t get_queue_snapshot_size(Queue *queue)
+{
+    return (3 * sizeof(int)) + (queue->capacity * sizeof(GbcPixel));
+}
+
+uint8_t *save_queue(Queue *queue, uint8_t *dest)
+{
+    dest = pack_bytes(dest, &queue->front, sizeof(int));
+    dest = pack_bytes(dest,  &queue->rear, sizeof(int));
+    dest = pack_bytes(dest,  &queue->size, sizeof(int));
+    for (int i = 0; i < queue->capacity; i++)
+    { // Slot order matters, sorting permutes the item pointers.
+        dest = pack_bytes(dest, queue->items[i], sizeof(GbcPixel));
+    }
+    return dest;
+}
+
+const uint8_t *load_queue(Queue *queue, const uint8_t *src)
+{
+    src = unpack_bytes(src, &queue->front, sizeof(int));
+    src = unpack_bytes(src,  &queue->rear, sizeof(int));
+    src = unpack_bytes(src,  &queue->size, sizeof(int));
+    for (int i = 0; i < queue->capacity; i++)
+    {
+        src = unpack_bytes(src, queue->items[i], sizeof(GbcPixel));
+    }
+    return src;
+}
@@ -0,0 +1,129 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "common.h"
+#include "emulator.h"
+#include "logger.h"
+#include "machine.h"
+#include "mmu.h"
+#include "ppu.h"
+#include "scheduler.h"
+#include "vec_env.h"
+
+#define LOG_MESSAGE(level, format, ...) log_message(level, __FILE__, __func__, format, ##__VA_ARGS__)
+
+struct GbcVecEnv
+{
+    GbcMachine    **machines;
+    uint16_t        num_envs;
+    Scheduler     *scheduler;
+
+    // Current step
+    const uint8_t   *actions;
+    uint32_t   *framebuffers;
+    uint8_t             *ram;
+};
+
+static void step_instance(void *context, SchedulerTask *task)
+{
+    GbcVecEnv  *env = (GbcVecEnv*) context;
+    uint32_t      k = task->index;
+    GbcMachine  *gb = env->machines[k];
+
+    if (env->actions) set_joypad(gb, env->actions[k]);
+    run_frames(gb, task->frames);
+
+    if (env->framebuffers)
+    {
+        uint32_t *dest = env->framebuffers + ((size_t) k * VEC_ENV_FRAME_SIZE);
+        memcpy(dest, render_frame(gb), VEC_ENV_FRAME_SIZE * sizeof(uint32_t));
+    }
+    if (env->ram)
+    {
+        get_wram_view(gb, env->ram + ((size_t) k * VEC_ENV_RAM_SIZE));
+    }
+}
+
+/* ================== PUBLIC API ================= */
+
+GbcVecEnv *init_vec_env(char *file_path, uint16_t num_envs, uint16_t num_workers)
+{
+    if (num_envs == 0) return NULL;
+
+    GbcVecEnv *env = (GbcVecEnv*) calloc(1, sizeof(GbcVecEnv));
+    env->num_envs  = num_envs;
+    env->machines  = (GbcMachine**) malloc(num_envs * sizeof(GbcMachine*));
+    for (uint16_t k = 0; k < num_envs; k++)
+    {
+        env->machines[k] = init_emulator(file_path, false);
+        if (!env->machines[k])
+        {
+            env->num_envs = k; // Only tidy the instances that were built.
+            tidy_vec_env(env);
+            return NULL;
+        }
+    }
+
+    if (num_workers > num_envs) num_workers = num_envs;
+    env->scheduler = init_scheduler(num_workers, step_instance, env);
+    if (!env->scheduler)
+    {
+        tidy_vec_env(env);
+        return NULL;
+    }
+
+    LOG_MESSAGE(INFO, "%d instances across %d workers.", num_envs, get_worker_count(env->scheduler));
+    return env;
+}
+
+void tidy_vec_env(GbcVecEnv *env)
+{
+    if (env->scheduler) tidy_scheduler(env->scheduler);
+    for (uint16_t k = 0; k < env->num_envs; k++)
+    {
+        tidy_emulator(env->machines[k], false);
+    }
+    free(env->machines); env->machines = NULL;
+    free(env);
+}
+
+void step_vec_env
+(
+    GbcVecEnv     *env,
+    const uint8_t *actions,
+    uint32_t       frames,
+    uint32_t      *framebuffers,
+    uint8_t       *ram
+)
+{
+    env->actions      = actions;
+    env->framebuffers = framebuffers;
+    env->ram          = ram;
+
+    for (uint16_t k = 0; k < env->num_envs; k++)
+    {
+        submit_task(env->scheduler, k, frames);
+    }
+    wait_scheduler(env->scheduler);
+}
+
+void reset_vec_env(GbcVecEnv *env, uint16_t index)
+{
+    if (index < env->num_envs) fast_reset_emulator(env->machines[index]);
+}
+
+uint16_t get_vec_env_size(GbcVecEnv *env)
+{
+    return env->num_envs;
+}
+
+Scheduler *get_vec_env_scheduler(GbcVecEnv *env)
+{
+    return env->scheduler;
+}
+
+GbcMachine *get_vec_env_machine(GbcVecEnv *env, uint16_t index)
+{
+    return (index < env->num_envs) ? env->machines[index] : NULL;
+}
@@ -0,0 +1,66 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "cpu.h"
+#include "emulator.h"
+#include "machine.h"
+
+// gcc -O2 -o alu_bench alu_bench.c ../src/*.c -lSDL2 -I "../include"
+// Times the CPU core alone on ALU-heavy code: machine_cycle() without the PPU or timer in between.
+
+#define TEST_ROM    "../roms/Tetris.gb"
+#define BENCH_ROM   "alu_bench.gb"
+#define ROM_SIZE    0x8000
+#define CYCLES      50000000
+
+static const uint8_t program[] = // At $0150, where Tetris' entry point jumps.
+{
+    0xF3,                               // DI
+    0x31, 0x00, 0xE0,                   // LD SP, $E000
+    0x01, 0x34, 0x12,                   // LD BC, $1234
+    0x11, 0x78, 0x56,                   // LD DE, $5678
+    0x21, 0xBC, 0x9A,                   // LD HL, $9ABC
+    0x80, 0x89, 0x27, 0x92, 0x9B,       // loop: ADD B, ADC C, DAA, SUB D, SBC E
+    0x04, 0x0D, 0xA4, 0xAD, 0xB0, 0xB9, //       INC B, DEC C, AND H, XOR L, OR B, CP C
+    0xCB, 0x12, 0xCB, 0x1B, 0xCB, 0x34, //       RL D, RR E, SWAP H
+    0xCB, 0x25, 0xCB, 0x38,             //       SLA L, SRL B
+    0xC6, 0x35, 0xDE, 0x11, 0x3C,       //       ADD $35, SBC $11, INC A
+    0xF5, 0xF1,                         //       PUSH AF, POP AF
+    0x20, 0xE2,                         //       JR NZ, loop
+    0x18, 0xE0                          //       JR loop
+};
+
+static void write_bench_rom()
+{
+    FILE   *file = fopen(TEST_ROM, "rb");
+    uint8_t *rom = (uint8_t*) calloc(1, ROM_SIZE);
+    fread(rom, 1, 0x150, file); // Header and logo, so the BIOS hands over.
+    fclose(file);
+    memcpy(&rom[0x150], program, sizeof(program));
+
+    file = fopen(BENCH_ROM, "wb");
+    fwrite(rom, 1, ROM_SIZE, file);
+    fclose(file);
+    free(rom);
+}
+
+int main()
+{
+    write_bench_rom();
+    GbcMachine *gb = init_emulator(BENCH_ROM, false);
+    run_frames(gb, 400); // Through the BIOS and into the loop.
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < CYCLES; i++) machine_cycle(gb);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + ((end.tv_nsec - start.tv_nsec) / 1e9);
+    printf("%u M-cycles in %.3fs, %.2f ns per M-cycle\n", CYCLES, seconds, (seconds * 1e9) / CYCLES);
+
+    tidy_emulator(gb, false);
+    remove(BENCH_ROM);
+    return 0;
+}
@@ -1,5 +1,19 @@
 #include <CUnit/CUnit.h> 
 #include <CUnit/Basic.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cart.h"
+#include "emulator.h"
+#include "image.h"
+#include "mmu.h"
+
+#define TEST_ROM       "../roms/Tetris.gb"
+#define TEST_ROM_ALIAS "../roms/../roms/Tetris.gb"
+#define MBC1_ROM       "cartridge_test.gb"
+#define MBC1_BANKS     8
+#define BANK_SIZE      0x4000
 
 void test_get_cartridge()
 {
@@ -7,6 +21,82 @@ void test_get_cartridge()
     CU_ASSERT_PTR_NULL(cart);
 }
 
+void test_images_are_shared()
+{
+    size_t size = 0, alias_size = 0;
+    const uint8_t *rom   = map_image(TEST_ROM, &size);
+    const uint8_t *alias = map_image(TEST_ROM_ALIAS, &alias_size);
+    CU_ASSERT_FATAL(rom != NULL);
+    CU_ASSERT(rom == alias); // One mapping per file, whatever the path.
+    CU_ASSERT(size == alias_size);
+    CU_ASSERT(get_image_references(rom) == 2);
+
+    GbcMachine *a = init_emulator(TEST_ROM, false);
+    GbcMachine *b = init_emulator(TEST_ROM_ALIAS, false);
+    CU_ASSERT_FATAL((a != NULL) && (b != NULL));
+    CU_ASSERT(get_rom_image(a) == rom);
+    CU_ASSERT(get_rom_image(b) == rom);
+    CU_ASSERT(get_image_references(rom) == 4);
+
+    tidy_emulator(a, false);
+    CU_ASSERT(get_image_references(rom) == 3);
+    tidy_emulator(b, false);
+    CU_ASSERT(get_image_references(rom) == 2);
+
+    unmap_image(alias);
+    CU_ASSERT(share_image(rom) == rom);
+    CU_ASSERT(get_image_references(rom) == 2);
+    unmap_image(rom);
+    unmap_image(rom);
+    CU_ASSERT(get_image_references(rom) == 0); // Released with the last user.
+}
+
+void test_missing_rom_fails()
+{
+    CU_ASSERT(init_emulator("../roms/missing.gb", false) == NULL);
+}
+
+static void write_mbc1_rom() // 8 banks on file, 16 claimed by the header, each bank starting with its number.
+{
+    FILE   *file = fopen(TEST_ROM, "rb");
+    uint8_t *rom = (uint8_t*) calloc(MBC1_BANKS, BANK_SIZE);
+    fread(rom, 1, 0x150, file); // Header and logo, so the BIOS hands over.
+    fclose(file);
+
+    rom[0x0147] = 0x01; // MBC1
+    rom[0x0148] = 0x03; // 256 KB
+    uint8_t checksum = 0;
+    for (uint16_t i = 0x0134; i <= 0x014C; i++) checksum = checksum - rom[i] - 1;
+    rom[0x014D] = checksum;
+    rom[0x0150] = 0x18; rom[0x0151] = 0xFE; // JR -2
+    for (uint8_t bank = 1; bank < MBC1_BANKS; bank++) rom[bank * BANK_SIZE] = bank;
+
+    file = fopen(MBC1_ROM, "wb");
+    fwrite(rom, BANK_SIZE, MBC1_BANKS, file);
+    fclose(file);
+    free(rom);
+}
+
+void test_mbc1_reaches_every_bank()
+{
+    write_mbc1_rom();
+    GbcMachine *gb = init_emulator(MBC1_ROM, false);
+    run_frames(gb, 400);
+
+    bool banked = true;
+    for (uint8_t bank = 1; bank < MBC1_BANKS; bank++)
+    {
+        write_memory(gb, 0x2000, bank);
+        banked &= (read_memory(gb, BANK_N_ADDRESS_START) == bank);
+    }
+    CU_ASSERT(banked);
+    write_memory(gb, 0x2000, 12); // Past the end of the file.
+    CU_ASSERT(read_memory(gb, BANK_N_ADDRESS_START) == 0xFF);
+
+    tidy_emulator(gb, false);
+    remove(MBC1_ROM);
+}
+
 int main()
 {
     // Initialize the CUnit test registry
@@ -22,7 +112,10 @@ int main()
     }
 
     // Add test cases to the suite
-    if ((CU_add_test(suite, "Cartrdige Copy Test", test_get_cartridge) == NULL)) {
+    if ((CU_add_test(suite, "Cartrdige Copy Test", test_get_cartridge) == NULL) ||
+        (CU_add_test(suite, "Shared ROM Images",   test_images_are_shared) == NULL) ||
+        (CU_add_test(suite, "Missing ROM Fails",   test_missing_rom_fails) == NULL) ||
+        (CU_add_test(suite, "MBC1 Every Bank",     test_mbc1_reaches_every_bank) == NULL)) {
         CU_cleanup_registry();
         return CU_get_error();
     }
@@ -33,6 +126,5 @@ int main()
 
     // Clean up registry
     CU_cleanup_registry();
-    tidy_cartridge();
     return CU_get_error();
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "common.h"
+#include "cpu.h"
+#include "emulator.h"
+#include "machine.h"
+
+// gcc -O2 -o dispatch_bench dispatch_bench.c ../src/*.c -lSDL2 -I "../include"
+// Times whole frames of the decoded families (LD r, r', ALU A, r and the $CB page), mixed so no one handler stays hot.
+
+#define TEST_ROM    "../roms/Tetris.gb"
+#define BENCH_ROM   "dispatch_bench.gb"
+#define ROM_SIZE    0x8000
+#define FRAMES      3000
+#define FRAME_CYCLES (DOT_PER_FRAME / 4) // M-cycles per frame at normal speed.
+
+static const uint8_t program[] = // At $0150, where Tetris' entry point jumps.
+{
+    0xF3,                               // DI
+    0x31, 0x00, 0xE0,                   // LD SP, $E000
+    0x01, 0x34, 0x12,                   // LD BC, $1234
+    0x11, 0x78, 0x56,                   // LD DE, $5678
+    0x21, 0x00, 0xC0,                   // LD HL, $C000
+    0x41, 0x53, 0x7A, 0x58, 0x4F,       // loop: LD B, C  LD D, E  LD A, D  LD E, B  LD C, A
+    0x7C, 0x47, 0x5A, 0x46, 0x70,       //       LD A, H  LD B, A  LD E, D  LD B, [HL]  LD [HL], B
+    0x80, 0x89, 0x92, 0x9B, 0xA4,       //       ADD B  ADC C  SUB D  SBC E  AND H
+    0xAD, 0xB0, 0xB9, 0x86, 0xAE,       //       XOR L  OR B  CP C  ADD [HL]  XOR [HL]
+    0xCB, 0x10, 0xCB, 0x19, 0xCB, 0x22, //       RL B  RR C  SLA D
+    0xCB, 0x2B, 0xCB, 0x37, 0xCB, 0x38, //       SRA E  SWAP A  SRL B
+    0xCB, 0x41, 0xCB, 0x5A, 0xCB, 0x93, //       BIT 0, C  BIT 3, D  RES 2, E
+    0xCB, 0xC8, 0xCB, 0x06, 0xCB, 0x7E, //       SET 1, B  RLC [HL]  BIT 7, [HL]
+    0x18, 0xD2                          //       JR loop
+};
+
+static void write_bench_rom()
+{
+    FILE   *file = fopen(TEST_ROM, "rb");
+    uint8_t *rom = (uint8_t*) calloc(1, ROM_SIZE);
+    fread(rom, 1, 0x150, file); // Header and logo, so the BIOS hands over.
+    fclose(file);
+    memcpy(&rom[0x150], program, sizeof(program));
+
+    file = fopen(BENCH_ROM, "wb");
+    fwrite(rom, 1, ROM_SIZE, file);
+    fclose(file);
+    free(rom);
+}
+
+static void time_mode(ExecutionMode mode, const char *name)
+{
+    GbcMachine *gb = init_emulator(BENCH_ROM, false);
+    set_execution_mode(gb, mode);
+    run_frames(gb, 400); // Through the BIOS and into the loop.
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    run_frames(gb, FRAMES);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + ((end.tv_nsec - start.tv_nsec) / 1e9);
+    printf("%-8s %u frames in %.3fs, %.2f ns per M-cycle\n", name, FRAMES, seconds, (seconds * 1e9) / ((double) FRAMES * FRAME_CYCLES));
+
+    tidy_emulator(gb, false);
+}
+
+int main()
+{
+    write_bench_rom();
+    time_mode(ACCURATE_EXECUTION, "accurate");
+    time_mode(FAST_EXECUTION,     "fast");
+    remove(BENCH_ROM);
+    return 0;
+}
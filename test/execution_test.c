@@ -0,0 +1,460 @@
+#include <CUnit/CUnit.h>
+#include <CUnit/Basic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "cpu.h"
+#include "emulator.h"
+#include "machine.h"
+#include "mmu.h"
+#include "ppu.h"
+#include "timer.h"
+
+// gcc -o execution_test execution_test.c ../src/*.c -lcunit -lSDL2 -I "../include"
+
+#define TEST_ROM    "../roms/Tetris.gb"
+#define FRAME_BYTES (GBC_WIDTH * GBC_HEIGHT * sizeof(uint32_t))
+#define SMC_ROM     "execution_test.gb"
+#define ROM_SIZE    0x8000
+
+static const uint8_t script[] = { 0, JOYPAD_START, 0, JOYPAD_A, JOYPAD_LEFT, JOYPAD_RIGHT | JOYPAD_DOWN, 0 };
+
+static bool frames_match(GbcMachine *accurate, GbcMachine *fast, uint32_t frames)
+{
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        uint8_t buttons = script[(i / 20) % sizeof(script)];
+        set_joypad(accurate, buttons);
+        set_joypad(fast,     buttons);
+        run_frames(accurate, 1);
+        run_frames(fast,     1);
+        if (memcmp(render_frame(accurate), render_frame(fast), FRAME_BYTES) != 0) return false;
+    }
+    return true;
+}
+
+void test_fast_execution_matches_accurate()
+{
+    GbcMachine *accurate = init_emulator(TEST_ROM, false);
+    GbcMachine     *fast = init_emulator(TEST_ROM, false);
+    set_execution_mode(fast, FAST_EXECUTION);
+
+    CU_ASSERT(get_execution_mode(accurate) == ACCURATE_EXECUTION);
+    CU_ASSERT(frames_match(accurate, fast, 600));
+    CU_ASSERT(accurate->frame_count == fast->frame_count);
+    CU_ASSERT(fast->owed_cycles == 0); // Always paid by the end of an instruction.
+
+    tidy_emulator(fast, false);
+    tidy_emulator(accurate, false);
+}
+
+void test_fast_execution_survives_power_cycle()
+{
+    GbcMachine *gb = init_emulator(TEST_ROM, false);
+    set_execution_mode(gb, FAST_EXECUTION);
+    run_frames(gb, 10);
+    power_cycle_emulator(gb);
+    CU_ASSERT(get_execution_mode(gb) == FAST_EXECUTION);
+
+    GbcMachine *child = fork_emulator(gb);
+    CU_ASSERT(get_execution_mode(child) == FAST_EXECUTION);
+
+    tidy_emulator(child, false);
+    tidy_emulator(gb, false);
+}
+
+static const uint8_t smc_program[] = // At $0150, where Tetris' entry point jumps.
+{
+    0x21, 0x00, 0xC0, // LD HL, $C000
+    0x36, 0x3C,       // LD [HL], $3C    (INC A)
+    0x23,             // INC HL
+    0x36, 0xC9,       // LD [HL], $C9    (RET)
+    0xAF,             // XOR A
+    0x47,             // LD B, A
+    0xCD, 0x00, 0xC0, // CALL $C000      A = 1
+    0xCD, 0x00, 0xC0, // CALL $C000      A = 2, from the cache
+    0x21, 0x00, 0xC0, // LD HL, $C000
+    0x36, 0x04,       // LD [HL], $04    (INC B)
+    0xCD, 0x00, 0xC0, // CALL $C000      B = 1, only if the old block was dropped
+    0x18, 0xFE        // JR -2
+};
+
+static void write_test_rom(const uint8_t *program, size_t size)
+{
+    FILE   *file = fopen(TEST_ROM, "rb");
+    uint8_t *rom = (uint8_t*) calloc(1, ROM_SIZE);
+    fread(rom, 1, 0x150, file); // Header and logo, so the BIOS hands over.
+    fclose(file);
+    memcpy(&rom[0x150], program, size);
+
+    file = fopen(SMC_ROM, "wb");
+    fwrite(rom, 1, ROM_SIZE, file);
+    fclose(file);
+    free(rom);
+}
+
+static void mark_test_rom_cgb() // Flags the written ROM as CGB-only and fixes the header checksum.
+{
+    FILE *file = fopen(SMC_ROM, "r+b");
+    uint8_t header[0x50];
+    fseek(file, 0x100, SEEK_SET);
+    fread(header, 1, sizeof(header), file);
+
+    header[0x43] = 0xC0;
+    uint8_t checksum = 0;
+    for (uint8_t i = 0x34; i <= 0x4C; i++) checksum = checksum - header[i] - 1;
+    header[0x4D] = checksum;
+    fseek(file, 0x100, SEEK_SET);
+    fwrite(header, 1, sizeof(header), file);
+    fclose(file);
+}
+
+void test_block_cache_sees_code_writes()
+{
+    write_test_rom(smc_program, sizeof(smc_program));
+    GbcMachine *gb = init_emulator(SMC_ROM, false);
+    run_frames(gb, 400);
+
+    CodeCacheStats stats = get_code_cache_stats(gb);
+    CU_ASSERT(gb->R->A == 2);
+    CU_ASSERT(gb->R->B == 1);
+    CU_ASSERT(stats.invalidations >= 1);
+    CU_ASSERT(stats.hits > stats.decodes);
+
+    tidy_emulator(gb, false);
+    remove(SMC_ROM);
+}
+
+static const uint8_t alu_program[] = // 256 passes over every translated opcode, A and F pushed after each.
+{
+    0xF3,                               // DI
+    0x31, 0x00, 0xE0,                   // LD SP, $E000
+    0xAF, 0xE0, 0x80,                   // XOR A, LDH [$80], A
+    0x01, 0x34, 0x12,                   // LD BC, $1234
+    0x11, 0x78, 0x56,                   // LD DE, $5678
+    0x21, 0xBC, 0x9A,                   // LD HL, $9ABC
+    0x3C, 0x80, 0x89, 0x91, 0x9A, 0xA3, // loop: INC A, ADD B, ADC C, SUB C, SBC D, AND E
+    0xAC, 0xB5, 0xBA, 0x2F, 0x37, 0x3F, //       XOR H, OR L, CP D, CPL, SCF, CCF
+    0x0C, 0x15, 0x1C, 0x25, 0x78, 0x4F, //       INC C, DEC D, INC E, DEC H, LD A, B, LD C, A
+    0x03, 0x1B, 0x23, 0x00,             //       INC BC, DEC DE, INC HL, NOP
+    0xC6, 0x37, 0xCE, 0x11, 0xD6, 0x05, //       ADD $37, ADC $11, SUB $05
+    0xDE, 0x03, 0xE6, 0xF7, 0xEE, 0x5A, //       SBC $03, AND $F7, XOR $5A
+    0xF6, 0x01, 0x06, 0x80, 0xB8,       //       OR $01, LD B, $80, CP B
+    0x8F, 0x9F, 0x3D,                   //       ADC A, SBC A, DEC A
+    0xF5,                               //       PUSH AF
+    0xE5, 0x21, 0x80, 0xFF, 0x35, 0xE1, //       PUSH HL, LD HL, $FF80, DEC [HL], POP HL
+    0x20, 0xCD,                         //       JR NZ, loop
+    0x18, 0xFE                          // JR -2
+};
+
+void test_jit_matches_interpreter()
+{
+    write_test_rom(alu_program, sizeof(alu_program));
+    GbcMachine *accurate = init_emulator(SMC_ROM, false);
+    GbcMachine      *jit = init_emulator(SMC_ROM, false);
+    set_execution_mode(jit, JIT_EXECUTION);
+    run_frames(accurate, 400);
+    run_frames(jit,      400);
+
+    CU_ASSERT(memcmp(accurate->R, jit->R, offsetof(Register, IER)) == 0);
+    bool trace_matches = true;
+    for (uint32_t address = 0xDE00; address < 0xE000; address++)
+    {
+        trace_matches &= (read_memory(accurate, (uint16_t) address) == read_memory(jit, (uint16_t) address));
+    }
+    CU_ASSERT(trace_matches);
+    if (get_execution_mode(jit) == JIT_EXECUTION) CU_ASSERT(get_code_cache_stats(jit).native > 0);
+
+    tidy_emulator(jit, false);
+    tidy_emulator(accurate, false);
+    remove(SMC_ROM);
+}
+
+static const uint8_t threaded_program[] = // Runs of LD r, r', ALU A, r and $CB ops, with DIV sampled so drift shows.
+{
+    0xF3,                               // DI
+    0x31, 0x00, 0xE0,                   // LD SP, $E000
+    0x01, 0x34, 0x12,                   // LD BC, $1234
+    0x11, 0x78, 0x56,                   // LD DE, $5678
+    0x21, 0x00, 0xC0,                   // LD HL, $C000
+    0x41, 0x53, 0x7A, 0x80, 0x8E, 0xAB, // loop: LD B, C  LD D, E  LD A, D  ADD B  ADC [HL]  XOR E
+    0x77, 0xCB, 0x10, 0xCB, 0x36,       //       LD [HL], A  RL B  SWAP [HL]
+    0xCB, 0x7E, 0xCB, 0xDE, 0xCB, 0x19, //       BIT 7, [HL]  SET 3, [HL]  RR C
+    0xF0, 0x04, 0x86, 0x77, 0x2C,       //       LDH A, [DIV]  ADD [HL]  LD [HL], A  INC L
+    0x18, 0xE8                          //       JR loop
+};
+
+void test_threaded_fast_matches_accurate()
+{
+    write_test_rom(threaded_program, sizeof(threaded_program));
+    GbcMachine *accurate = init_emulator(SMC_ROM, false);
+    GbcMachine     *fast = init_emulator(SMC_ROM, false);
+    set_execution_mode(fast, FAST_EXECUTION);
+    run_frames(accurate, 400);
+    run_frames(fast,     400);
+
+    CU_ASSERT(memcmp(accurate->R, fast->R, offsetof(Register, IER)) == 0);
+    bool wram_matches = true;
+    for (uint16_t address = 0xC000; address < 0xC100; address++)
+    {
+        wram_matches &= (read_memory(accurate, address) == read_memory(fast, address));
+    }
+    CU_ASSERT(wram_matches);
+    CU_ASSERT(accurate->frame_count == fast->frame_count);
+
+    tidy_emulator(fast, false);
+    tidy_emulator(accurate, false);
+    remove(SMC_ROM);
+}
+
+static const uint8_t halt_program[] = // Sleeps through every frame with the timer overflowing underneath.
+{
+    0xF3,                   // DI
+    0x31, 0x00, 0xE0,       // LD SP, $E000
+    0x21, 0x00, 0xC0,       // LD HL, $C000
+    0x3E, 0x05, 0xE0, 0x07, // LD A, $05, LDH [TAC], A
+    0x3E, 0xF0, 0xE0, 0x06, // LD A, $F0, LDH [TMA], A
+    0x3E, 0x01, 0xE0, 0xFF, // LD A, $01, LDH [IE], A
+    0xAF, 0xE0, 0x0F,       // loop: XOR A, LDH [IF], A
+    0x76, 0x00,             //       HALT, NOP
+    0xF0, 0x44, 0x22,       //       LDH A, [LY], LD [HL+], A
+    0x18, 0xF6              //       JR loop
+};
+
+void test_halt_wakes_on_vblank()
+{
+    write_test_rom(halt_program, sizeof(halt_program));
+    GbcMachine *gb = init_emulator(SMC_ROM, false);
+    run_frames(gb, 400);
+
+    uint16_t end = (gb->R->H << BYTE) | gb->R->L;
+    bool woke_on_vblank = true;
+    for (uint16_t address = 0xC000; address < end; address++)
+    {
+        woke_on_vblank &= (read_memory(gb, address) == GBC_HEIGHT);
+    }
+    CU_ASSERT(end > 0xC000);
+    CU_ASSERT(woke_on_vblank);
+    CU_ASSERT(read_memory(gb, IFR) & BIT_2_MASK); // TIMA overflowed while asleep, IE left it pending.
+
+    tidy_emulator(gb, false);
+    remove(SMC_ROM);
+}
+
+void test_lyc_interrupt_is_edge_triggered()
+{
+    write_test_rom(halt_program, sizeof(halt_program)); // Sleeps until VBlank, STAT is never serviced.
+    GbcMachine *gb = init_emulator(SMC_ROM, false);
+    run_frames(gb, 400);
+    write_memory(gb, LYC, 0x50);
+    write_memory(gb, STAT, BIT_6_MASK);
+    write_memory(gb, IFR, read_memory(gb, IFR) & ~BIT_1_MASK);
+
+    run_machine_dots(gb, (0x50 * DOTS_PER_LINE) + 10);
+    CU_ASSERT(read_memory(gb, LY) == 0x50);
+    CU_ASSERT(read_memory(gb, STAT) & BIT_2_MASK);
+    CU_ASSERT(read_memory(gb, IFR) & BIT_1_MASK);
+
+    write_memory(gb, IFR, read_memory(gb, IFR) & ~BIT_1_MASK);
+    run_machine_dots(gb, 400); // Same line, LY=LYC still holds.
+    CU_ASSERT(read_memory(gb, LY) == 0x50);
+    CU_ASSERT((read_memory(gb, IFR) & BIT_1_MASK) == 0);
+
+    run_machine_dots(gb, DOTS_PER_FRAME);
+    CU_ASSERT(read_memory(gb, IFR) & BIT_1_MASK); // Next frame's rising edge.
+
+    tidy_emulator(gb, false);
+    remove(SMC_ROM);
+}
+
+void test_oam_dma_blocks_its_buses()
+{
+    write_test_rom(halt_program, sizeof(halt_program)); // Runs from ROM and WRAM, clear of a VRAM-sourced DMA.
+    GbcMachine *gb = init_emulator(SMC_ROM, false);
+    run_frames(gb, 400);
+    for (uint16_t i = 0; i < 160; i++) write_memory(gb, VRAM_ADDRESS_START + i, 0x80 | i);
+
+    write_memory(gb, DMA, VRAM_ADDRESS_START >> BYTE);
+    bool copied = true;
+    for (uint16_t i = 0; i < 160; i++) copied &= (get_memory(gb)[OAM_ADDRESS_START + i] == (0x80 | i));
+    CU_ASSERT(copied); // All at once.
+
+    run_machine_dots(gb, 40);
+    CU_ASSERT(dma_active(gb));
+    CU_ASSERT(read_memory(gb, OAM_ADDRESS_START) == 0xFF);
+    CU_ASSERT(read_memory(gb, VRAM_ADDRESS_END) & 0x80); // The byte in flight, not the $00 behind it.
+    write_memory(gb, OAM_ADDRESS_START, 0x00);
+    write_memory(gb, WRAM_N_ADDRESS_END, 0x42);
+    CU_ASSERT(read_memory(gb, WRAM_N_ADDRESS_END) == 0x42); // The external bus is free.
+
+    run_machine_dots(gb, 160 * 4);
+    CU_ASSERT(!dma_active(gb));
+    CU_ASSERT(read_memory(gb, OAM_ADDRESS_START) == 0x80); // The blocked write never landed.
+    CU_ASSERT(read_memory(gb, VRAM_ADDRESS_END) == 0x00);
+
+    tidy_emulator(gb, false);
+    remove(SMC_ROM);
+}
+
+void test_hdma_copies_blocks()
+{
+    write_test_rom(halt_program, sizeof(halt_program)); // Sleeps in ROM, its trace stays below $D000.
+    mark_test_rom_cgb();
+    GbcMachine *gb = init_emulator(SMC_ROM, false);
+    run_frames(gb, 400);
+    for (uint16_t i = 0; i < 0x30; i++) write_memory(gb, WRAM_N_ADDRESS_START + i, 0x80 | i);
+    write_memory(gb, VBK,   1);
+    write_memory(gb, HDMA1, WRAM_N_ADDRESS_START >> BYTE);
+    write_memory(gb, HDMA2, 0x00);
+    write_memory(gb, HDMA3, 0x00);
+    write_memory(gb, HDMA4, 0x00);
+
+    write_memory(gb, HDMA5, 0x01); // General-purpose, 2 blocks.
+    CU_ASSERT(read_memory(gb, HDMA5) == 0xFF);
+    CU_ASSERT(cpu_stalled(gb));
+    CU_ASSERT(read_vram(gb, 1, 0x801F) == 0x9F);
+
+    write_memory(gb, HDMA3, 0x01);
+    write_memory(gb, HDMA5, 0x82); // HBlank, 3 blocks into $8100.
+    CU_ASSERT(read_memory(gb, HDMA5) == 0x02);
+    run_machine_dots(gb, DOTS_PER_LINE);
+    CU_ASSERT(read_memory(gb, HDMA5) == 0x01);
+    run_machine_dots(gb, 2 * DOTS_PER_LINE);
+    CU_ASSERT(read_memory(gb, HDMA5) == 0xFF);
+    bool copied = true;
+    for (uint16_t i = 0; i < 0x30; i++) copied &= (read_vram(gb, 1, 0x8100 + i) == (0x80 | i));
+    CU_ASSERT(copied);
+
+    write_memory(gb, HDMA5, 0x83);
+    write_memory(gb, HDMA5, 0x00); // Stopped before its first HBlank.
+    CU_ASSERT(read_memory(gb, HDMA5) == 0x83);
+
+    tidy_emulator(gb, false);
+    remove(SMC_ROM);
+}
+
+void test_window_starts_at_wx()
+{
+    write_test_rom(halt_program, sizeof(halt_program)); // Sleeps in ROM, never touches the PPU.
+    GbcMachine *gb = init_emulator(SMC_ROM, false);
+    run_frames(gb, 400);
+    write_memory(gb, VBK, 1); // Plain attributes first, DMG ignores VBK and lands them in bank 0.
+    for (uint16_t address = TM0_ADDRESS_START; address <= TM1_ADDRESS_END; address++) write_memory(gb, address, 0);
+    write_memory(gb, VBK, 0); // Background on tile 0, window on tile 1.
+    for (uint16_t address = TM0_ADDRESS_START; address <= TM0_ADDRESS_END; address++) write_memory(gb, address, 0);
+    for (uint16_t address = TM1_ADDRESS_START; address <= TM1_ADDRESS_END; address++) write_memory(gb, address, 1);
+    for (uint16_t i = 0; i < 16; i++) write_memory(gb, B0_ADDRESS_START + i, 0x00);
+    for (uint16_t i = 0; i < 16; i++) write_memory(gb, B0_ADDRESS_START + 16 + i, (i % 2) ? 0x00 : 0x80); // Column 0 only.
+    write_memory(gb, SCX,  0x00);
+    write_memory(gb, SCY,  0x00);
+    write_memory(gb, WY,   0x00);
+    write_memory(gb, WX,   7 + 3); // Off the tile grid.
+    write_memory(gb, BGP,  0xE4);
+    write_memory(gb, BCPS, 0x80); // Color 0 white, color 1 black, in case the BIOS left CGB palette 0 flat.
+    write_memory(gb, BCPD, 0xFF); write_memory(gb, BCPD, 0x7F);
+    write_memory(gb, BCPD, 0x00); write_memory(gb, BCPD, 0x00);
+    write_memory(gb, LCDC, 0xF1); // LCD, window at $9C00, $8000 tile data, background on.
+    ppu_advance(gb, DOTS_PER_FRAME);
+
+    uint32_t *frame = (uint32_t*) render_frame(gb);
+    bool aligned = (frame[0] != frame[3]);
+    for (uint16_t y = 0; y < GBC_HEIGHT; y++)
+    {
+        for (uint16_t x = 0; x < GBC_WIDTH; x++)
+        {
+            bool marked = (x >= 3) && (((x - 3) % 8) == 0);
+            aligned &= ((frame[(y * GBC_WIDTH) + x] == frame[3]) == marked);
+        }
+    }
+    CU_ASSERT(aligned);
+
+    tidy_emulator(gb, false);
+    remove(SMC_ROM);
+}
+
+static const uint8_t poll_program[] = // Busy-waits for VBlank on LY instead of halting, DIV and TIMA traced.
+{
+    0xF3,                   // DI
+    0x31, 0x00, 0xE0,       // LD SP, $E000
+    0x21, 0x00, 0xC0,       // LD HL, $C000
+    0x3E, 0x05, 0xE0, 0x07, // LD A, $05, LDH [TAC], A
+    0xF0, 0x44, 0xFE, 0x90, // loop: LDH A, [LY], CP $90
+    0x20, 0xFA,             //       JR NZ, loop
+    0xF0, 0x04, 0x22,       //       LDH A, [DIV], LD [HL+], A
+    0xF0, 0x05, 0x22,       //       LDH A, [TIMA], LD [HL+], A
+    0xF0, 0x44, 0xFE, 0x90, // wait: LDH A, [LY], CP $90
+    0x28, 0xFA,             //       JR Z, wait
+    0x18, 0xEC              //       JR loop
+};
+
+void test_idle_skipping_is_exact()
+{
+    write_test_rom(poll_program, sizeof(poll_program));
+    GbcMachine *skipping = init_emulator(SMC_ROM, false);
+    GbcMachine *stepping = init_emulator(SMC_ROM, false);
+    set_idle_skipping(stepping, false);
+    run_frames(skipping, 400);
+    run_frames(stepping, 400);
+
+    CU_ASSERT(memcmp(skipping->R, stepping->R, offsetof(Register, IER)) == 0);
+    CU_ASSERT(skipping->sys == stepping->sys);
+    bool trace_matches = true;
+    for (uint32_t address = 0xC000; address < 0xC400; address++)
+    {
+        trace_matches &= (read_memory(skipping, (uint16_t) address) == read_memory(stepping, (uint16_t) address));
+    }
+    CU_ASSERT(trace_matches);
+    CU_ASSERT(get_idle_stats(skipping).polling > 0);
+    CU_ASSERT(get_idle_stats(stepping).polling == 0);
+
+    tidy_emulator(stepping, false);
+    tidy_emulator(skipping, false);
+    remove(SMC_ROM);
+}
+
+int main()
+{
+    // Initialize the CUnit test registry
+    if (CUE_SUCCESS != CU_initialize_registry())
+    {
+        return CU_get_error();
+    }
+
+    // Create a test suite
+    CU_pSuite suite = CU_add_suite("Execution Tests", 0, 0);
+    if (suite == NULL)
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add test cases to the suite
+    if
+    (
+        CU_add_test(suite, "Fast Matches Accurate",     test_fast_execution_matches_accurate)     == NULL ||
+        CU_add_test(suite, "Fast Survives Power Cycle", test_fast_execution_survives_power_cycle) == NULL ||
+        CU_add_test(suite, "Block Cache Code Writes",   test_block_cache_sees_code_writes)        == NULL ||
+        CU_add_test(suite, "JIT Matches Interpreter",   test_jit_matches_interpreter)             == NULL ||
+        CU_add_test(suite, "Threaded Matches Accurate", test_threaded_fast_matches_accurate)      == NULL ||
+        CU_add_test(suite, "HALT Wakes On VBlank",      test_halt_wakes_on_vblank)                == NULL ||
+        CU_add_test(suite, "LYC Interrupt Is An Edge",  test_lyc_interrupt_is_edge_triggered)     == NULL ||
+        CU_add_test(suite, "Idle Skipping Is Exact",    test_idle_skipping_is_exact)              == NULL ||
+        CU_add_test(suite, "OAM DMA Blocks Its Buses",  test_oam_dma_blocks_its_buses)            == NULL ||
+        CU_add_test(suite, "HDMA Copies Blocks",        test_hdma_copies_blocks)                  == NULL ||
+        CU_add_test(suite, "Window Starts At WX",       test_window_starts_at_wx)                 == NULL
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Run all tests using the basic interface
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+    // Clean up registry
+    CU_cleanup_registry();
+    return CU_get_error();
+}
@@ -2,24 +2,26 @@
 #include <CUnit/Basic.h>
 #include <stdlib.h>
 #include "common.h"
-#include "cart.h"
+#include "emulator.h"
+#include "machine.h"
 #include "mmu.h"
 
-// gcc -o mmu_test mmu_test.c ../src/mmu.c ../src/cart.c ../src/logger.c ../src/cpu.c -lcunit -I "../include"
+// gcc -o mmu_test mmu_test.c ../src/*.c -lcunit -lSDL2 -I "../include"
+
+static GbcMachine *gb; // Built whole, the bus reaches into the PPU, timer and cartridge.
 
 void vram_checksum_validation()
 {
-    init_memory(0xFFFF);
     uint16_t start = VRAM_ADDRESS_START;
     uint16_t   end = VRAM_ADDRESS_END;
     uint8_t scaler = 2;
     long expected = ((end - start) + 1) * scaler;
 
-    write_memory(VBK, 0);
+    write_memory(gb, VBK, 0);
     uint16_t index = start;
     while (index <= end)
     { // Set up checksum.
-        write_memory(index, scaler);
+        write_memory(gb, index, scaler);
         index += 1;
     }
 
@@ -27,18 +29,18 @@ void vram_checksum_validation()
     long checksum = 0;
     while (index <= end)
     { // Calculate checksum.
-        checksum += read_memory(index);
+        checksum += read_memory(gb, index);
         index += 1;
     }
 
     printf("\n\nVRAM Bank 0 Checksum: %ld == %ld ?", checksum, expected);
     CU_ASSERT(checksum == expected);
 
-    write_memory(VBK, 1);
+    write_memory(gb, VBK, 1);
     index = start;
     while (index <= end)
     { // Set up checksum.
-        write_memory(index, scaler);
+        write_memory(gb, index, scaler);
         index += 1;
     }
 
@@ -46,19 +48,16 @@ void vram_checksum_validation()
     checksum = 0;
     while (index <= end)
     { // Calculate checksum.
-        checksum += read_memory(index);
+        checksum += read_memory(gb, index);
         index += 1;
     }
 
     printf("\nVRAM Bank 0 Checksum: %ld == %ld ?\n\n", checksum, expected);
     CU_ASSERT(checksum == expected);
-    tidy_memory();
 }
 
 void wram_checksum_validation()
 {
-    init_memory(0xFFFF);
-
     uint8_t scaler = 2;
 
     // Static Bank 0
@@ -66,18 +65,18 @@ void wram_checksum_validation()
     uint16_t    end = WRAM_ZERO_ADDRESS_END;
     long   expected = ((end - start) + 1) * scaler;
 
-    write_memory(SVBK, 0);
+    write_memory(gb, SVBK, 0);
     uint16_t index = start;
     while (index <= end)
     { // Set up checksum.
-        write_memory(index, scaler);
+        write_memory(gb, index, scaler);
         index += 1;
     }
     index = start;
     long checksum = 0;
     while (index <= end)
     { // Calculate checksum.
-        checksum += read_memory(index);
+        checksum += read_memory(gb, index);
         index += 1;
     }
 
@@ -89,38 +88,33 @@ void wram_checksum_validation()
     expected = ((end - start) + 1) * scaler;
     for (int svbk = 1; svbk < 7; svbk++)
     {   
-        write_memory(SVBK, svbk);
+        write_memory(gb, SVBK, svbk);
         index = start;
         while (index <= end)
         { // Set up checksum.
-            write_memory(index, scaler);
+            write_memory(gb, index, scaler);
             index += 1;
         }
         index = start;
         checksum = 0;
         while (index <= end)
         { // Calculate checksum.
-            checksum += read_memory(index);
+            checksum += read_memory(gb, index);
             index += 1;
         }
 
         CU_ASSERT(checksum == expected);
     }
-
-    tidy_memory();
 }
 
 void cram_checksum_validaiton()
 {
-    init_memory(0xFFFF);
-
-    tidy_memory();
 }
 
 int main()
 {
-    init_cartridge("../roms/gb-test-roms-master/interrupt_time/interrupt_time.gb", 0x0000);
-    //init_cartridge("../roms/assembly/graphics_test.gb", 0x0000);
+    gb = init_emulator("../roms/gb-test-roms-master/interrupt_time/interrupt_time.gb", false);
+    //gb = init_emulator("../roms/assembly/graphics_test.gb", false);
     // Initialize the CUnit test registry
     if (CUE_SUCCESS != CU_initialize_registry()) 
     {
@@ -152,6 +146,6 @@ int main()
 
     // Clean up registry
     CU_cleanup_registry();
-    tidy_cartridge();
+    tidy_emulator(gb, false);
     return CU_get_error();
 }
\ No newline at end of file
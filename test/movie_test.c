@@ -0,0 +1,140 @@
+#include <CUnit/CUnit.h>
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "emulator.h"
+#include "movie.h"
+#include "ppu.h"
+
+// gcc -o movie_test movie_test.c ../src/*.c -lcunit -lSDL2 -I "../include"
+
+#define TEST_ROM    "../roms/Tetris.gb"
+#define TEST_MOVIE  "movie_test.gbm"
+#define FRAME_BYTES (GBC_WIDTH * GBC_HEIGHT * sizeof(uint32_t))
+
+static const uint8_t script[] = { 0, 0, JOYPAD_START, 0, JOYPAD_A, JOYPAD_LEFT, JOYPAD_LEFT | JOYPAD_DOWN, 0 };
+
+static uint8_t scripted_input(uint32_t frame)
+{
+    return script[(frame / 15) % sizeof(script)]; // Held for a few frames, like a player would.
+}
+
+static Movie *record(GbcMachine *gb, bool from_snapshot, uint32_t frames)
+{
+    Movie *movie = init_movie(gb, from_snapshot);
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        set_joypad(gb, scripted_input(i));
+        record_movie_frame(movie, gb);
+        run_frames(gb, 1);
+    }
+    return movie;
+}
+
+static void count_frames(void *context, GbcMachine *gb, uint32_t frame)
+{
+    (*(uint32_t*) context) = frame + 1;
+}
+
+void test_movie_power_on_playback()
+{
+    GbcMachine *gb = init_emulator(TEST_ROM, false);
+    Movie   *movie = record(gb, false, 240);
+    uint8_t *final = (uint8_t*) malloc(FRAME_BYTES);
+    memcpy(final, render_frame(gb), FRAME_BYTES);
+
+    CU_ASSERT(get_movie_length(movie) == 240);
+    CU_ASSERT(get_movie_size(movie) < sizeof(MovieHeader) + 240); // Run-length encoded.
+
+    run_frames(gb, 30); // Wander off, playback has to rewind.
+    uint32_t played = 0;
+    CU_ASSERT(play_movie(movie, gb, count_frames, &played));
+    CU_ASSERT(played == 240);
+    CU_ASSERT(memcmp(final, render_frame(gb), FRAME_BYTES) == 0);
+
+    free(final);
+    tidy_movie(movie);
+    tidy_emulator(gb, false);
+}
+
+void test_movie_snapshot_playback_from_file()
+{
+    GbcMachine *gb = init_emulator(TEST_ROM, false);
+    run_frames(gb, 100);
+    set_joypad(gb, JOYPAD_B); // Held when recording starts.
+    Movie   *movie = record(gb, true, 120);
+    uint8_t *final = (uint8_t*) malloc(FRAME_BYTES);
+    memcpy(final, render_frame(gb), FRAME_BYTES);
+
+    CU_ASSERT(write_movie_file(movie, TEST_MOVIE));
+    Movie *loaded = read_movie_file(TEST_MOVIE);
+    CU_ASSERT_FATAL(loaded != NULL);
+    CU_ASSERT(get_movie_length(loaded) == 120);
+
+    GbcMachine *other = init_emulator(TEST_ROM, false);
+    CU_ASSERT(play_movie(loaded, other, NULL, NULL));
+    CU_ASSERT(memcmp(final, render_frame(other), FRAME_BYTES) == 0);
+
+    remove(TEST_MOVIE);
+    free(final);
+    tidy_movie(loaded);
+    tidy_movie(movie);
+    tidy_emulator(other, false);
+    tidy_emulator(gb, false);
+}
+
+void test_movie_rejects_bad_buffers()
+{
+    GbcMachine *gb = init_emulator(TEST_ROM, false);
+    Movie   *movie = record(gb, false, 60);
+    size_t    size = get_movie_size(movie);
+    uint8_t *buffer = (uint8_t*) malloc(size);
+
+    CU_ASSERT(save_movie(movie, buffer, size - 1) == 0);
+    CU_ASSERT(save_movie(movie, buffer, size) == size);
+    CU_ASSERT(load_movie(buffer, size - 1) == NULL);
+    buffer[0] ^= 0xFF; // Break the magic.
+    CU_ASSERT(load_movie(buffer, size) == NULL);
+
+    free(buffer);
+    tidy_movie(movie);
+    tidy_emulator(gb, false);
+}
+
+int main()
+{
+    // Initialize the CUnit test registry
+    if (CUE_SUCCESS != CU_initialize_registry())
+    {
+        return CU_get_error();
+    }
+
+    // Create a test suite
+    CU_pSuite suite = CU_add_suite("Movie Tests", 0, 0);
+    if (suite == NULL)
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add test cases to the suite
+    if
+    (
+        CU_add_test(suite, "Movie Power-On Playback",  test_movie_power_on_playback)           == NULL ||
+        CU_add_test(suite, "Movie Snapshot From File", test_movie_snapshot_playback_from_file) == NULL ||
+        CU_add_test(suite, "Movie Rejects Garbage",    test_movie_rejects_bad_buffers)         == NULL
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Run all tests using the basic interface
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+    // Clean up registry
+    CU_cleanup_registry();
+    return CU_get_error();
+}
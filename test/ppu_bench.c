@@ -0,0 +1,65 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "emulator.h"
+#include "machine.h"
+#include "mmu.h"
+#include "ppu.h"
+
+// gcc -O2 -o ppu_bench ppu_bench.c ../src/*.c -lSDL2 -I "../include"
+// Times the PPU alone on a busy scene: whole frames through ppu_advance() without the CPU or timer in between.
+
+#define TEST_ROM    "../roms/Tetris.gb"
+#define FRAMES      2000
+
+static uint32_t next_random(uint32_t *state) // xorshift32, the scene is the same on every run.
+{
+    (*state) ^= (*state) << 13;
+    (*state) ^= (*state) >> 17;
+    (*state) ^= (*state) <<  5;
+    return (*state);
+}
+
+static void build_scene(GbcMachine *gb)
+{
+    uint32_t state = 0x2545F491;
+    for (uint16_t address = VRAM_ADDRESS_START; address <= VRAM_ADDRESS_END; address++)
+    { // Noise in every tile, both maps pointing all over the tile data.
+        write_memory(gb, address, (uint8_t) next_random(&state));
+    }
+    for (uint8_t i = 0; i < 40; i++)
+    { // Ten objects on every fourth band of lines, flips and palettes mixed.
+        uint16_t entry = OAM_ADDRESS_START + (i * 4);
+        write_memory(gb, entry,     (uint8_t) (16 + ((i / 10) * 36)));
+        write_memory(gb, entry + 1, (uint8_t) (8 + ((i % 10) * 16)));
+        write_memory(gb, entry + 2, (uint8_t) next_random(&state));
+        write_memory(gb, entry + 3, (uint8_t) (next_random(&state) & 0xF0));
+    }
+    write_memory(gb, SCX,  0x00);
+    write_memory(gb, SCY,  0x00);
+    write_memory(gb, WX,   0x57);
+    write_memory(gb, WY,   0x48);
+    write_memory(gb, BGP,  0xE4);
+    write_memory(gb, OBP0, 0xD2);
+    write_memory(gb, OBP1, 0x1B);
+    write_memory(gb, LCDC, 0xF3); // LCD, window at $9C00, $8000 tile data, objects and background on.
+}
+
+int main()
+{
+    GbcMachine *gb = init_emulator(TEST_ROM, false);
+    run_frames(gb, 400); // Through the BIOS, so the cartridge owns the bus.
+    build_scene(gb);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < FRAMES; i++) ppu_advance(gb, DOTS_PER_FRAME);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + ((end.tv_nsec - start.tv_nsec) / 1e9);
+    printf("%u frames in %.3fs, %.1f us of PPU time per frame\n", FRAMES, seconds, (seconds * 1e6) / FRAMES);
+
+    tidy_emulator(gb, false);
+    return 0;
+}
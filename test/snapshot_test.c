@@ -0,0 +1,208 @@
+#include <CUnit/CUnit.h>
+#include <CUnit/Basic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common.h"
+#include "emulator.h"
+#include "mmu.h"
+#include "ppu.h"
+#include "snapshot.h"
+#include "timer.h"
+
+// gcc -o snapshot_test snapshot_test.c ../src/*.c -lcunit -lSDL2 -I "../include"
+
+#define TEST_ROM "../roms/Tetris.gb"
+
+static void run_dots(GbcMachine *gb, uint32_t dots)
+{
+    run_machine_dots(gb, dots);
+}
+
+static bool same_state(GbcMachine *a, GbcMachine *b)
+{
+    bool lcd = memcmp(render_frame(a), render_frame(b), GBC_WIDTH * GBC_HEIGHT * sizeof(uint32_t)) == 0;
+    bool mem = memcmp(get_memory(a), get_memory(b), 0x10000) == 0;
+    return lcd && mem;
+}
+
+void test_snapshot_round_trip()
+{
+    GbcMachine *gb = init_emulator(TEST_ROM, false);
+    run_dots(gb, DOT_PER_FRAME * 30 + 1234); // Land mid-instruction, mid-scanline.
+
+    size_t    size = gbc_snapshot_size(gb);
+    uint8_t *first = (uint8_t*) malloc(size);
+    uint8_t *again = (uint8_t*) malloc(size);
+    CU_ASSERT(gbc_snapshot_save(gb, first, size) == size);
+
+    run_dots(gb, DOT_PER_FRAME * 10);
+    CU_ASSERT(gbc_snapshot_load(gb, first, size));
+    CU_ASSERT(gbc_snapshot_save(gb, again, size) == size);
+    CU_ASSERT(memcmp(first, again, size) == 0);
+
+    free(first); free(again);
+    tidy_emulator(gb, false);
+}
+
+void test_snapshot_determinism()
+{
+    GbcMachine *a = init_emulator(TEST_ROM, false);
+    GbcMachine *b = init_emulator(TEST_ROM, false);
+    run_dots(a, DOT_PER_FRAME * 45 + 777);
+
+    size_t     size = gbc_snapshot_size(a);
+    uint8_t *buffer = (uint8_t*) malloc(size);
+    gbc_snapshot_save(a, buffer, size);
+    CU_ASSERT(gbc_snapshot_load(b, buffer, size));
+
+    run_dots(a, DOT_PER_FRAME * 20);
+    run_dots(b, DOT_PER_FRAME * 20);
+    CU_ASSERT(same_state(a, b));
+
+    free(buffer);
+    tidy_emulator(a, false);
+    tidy_emulator(b, false);
+}
+
+void test_snapshot_rejects_bad_buffers()
+{
+    GbcMachine *gb = init_emulator(TEST_ROM, false);
+    size_t     size = gbc_snapshot_size(gb);
+    uint8_t *buffer = (uint8_t*) malloc(size);
+
+    CU_ASSERT(gbc_snapshot_save(gb, buffer, size - 1) == 0);
+    gbc_snapshot_save(gb, buffer, size);
+    CU_ASSERT(!gbc_snapshot_load(gb, buffer, size - 1));
+    buffer[0] ^= 0xFF; // Break the magic.
+    CU_ASSERT(!gbc_snapshot_load(gb, buffer, size));
+
+    free(buffer);
+    tidy_emulator(gb, false);
+}
+
+void test_fork_matches_parent()
+{
+    GbcMachine *parent = init_emulator(TEST_ROM, false);
+    run_dots(parent, DOT_PER_FRAME * 40 + 321);
+
+    GbcMachine *child = fork_emulator(parent);
+    CU_ASSERT(get_dirty_pages(parent) == 0);
+    CU_ASSERT(get_dirty_pages(child)  == 0);
+    CU_ASSERT(same_state(parent, child));
+
+    run_dots(parent, DOT_PER_FRAME * 20);
+    run_dots(child,  DOT_PER_FRAME * 20);
+    CU_ASSERT(same_state(parent, child));
+
+    tidy_emulator(child, false);
+    tidy_emulator(parent, false);
+}
+
+void test_fork_children_are_isolated()
+{
+    GbcMachine *parent = init_emulator(TEST_ROM, false);
+    run_dots(parent, DOT_PER_FRAME * 60);
+
+    size_t     size = gbc_snapshot_size(parent);
+    uint8_t *buffer = (uint8_t*) malloc(size);
+    gbc_snapshot_save(parent, buffer, size);
+
+    GbcMachine *child = fork_emulator(parent);
+    set_joypad(child, JOYPAD_START | JOYPAD_DOWN); // Diverge, writing the shared banks.
+    run_dots(child, DOT_PER_FRAME * 30);
+    CU_ASSERT(get_dirty_pages(child) != 0);
+
+    GbcMachine *clone = init_emulator(TEST_ROM, false);
+    gbc_snapshot_load(clone, buffer, size);
+    run_dots(parent, DOT_PER_FRAME * 30);
+    run_dots(clone,  DOT_PER_FRAME * 30);
+    CU_ASSERT(same_state(parent, clone));
+
+    tidy_emulator(child, false); // Parent keeps running on its shared pages.
+    run_dots(parent, DOT_PER_FRAME);
+    run_dots(clone,  DOT_PER_FRAME);
+    CU_ASSERT(same_state(parent, clone));
+
+    free(buffer);
+    tidy_emulator(clone, false);
+    tidy_emulator(parent, false);
+}
+
+void test_fast_reset_matches_boot()
+{
+    GbcMachine *gb = init_emulator(TEST_ROM, false);
+    CU_ASSERT(!restore_boot_snapshot(gb)); // Nothing captured before the BIOS finishes.
+    run_frames(gb, 200);
+    CU_ASSERT(get_memory(gb)[BIOS] != 0);
+
+    GbcMachine *fresh = init_emulator(TEST_ROM, false);
+    while (get_memory(fresh)[BIOS] == 0) system_clock_pulse(fresh);
+
+    fast_reset_emulator(gb);
+    CU_ASSERT(same_state(gb, fresh));
+    run_dots(gb,    DOT_PER_FRAME * 20);
+    run_dots(fresh, DOT_PER_FRAME * 20);
+    CU_ASSERT(same_state(gb, fresh));
+
+    tidy_emulator(fresh, false);
+    tidy_emulator(gb, false);
+}
+
+void test_tile_cache_follows_vram()
+{
+    GbcMachine *parent = init_emulator(TEST_ROM, false);
+    run_dots(parent, DOT_PER_FRAME * 40); // Every tile on screen decoded by now.
+
+    for (uint16_t address = B0_ADDRESS_START; address < TM0_ADDRESS_START; address++)
+    {
+        write_memory(parent, address, (uint8_t) (address * 7));
+    }
+    GbcMachine *child = fork_emulator(parent); // Starts from a cold cache, so decodes what VRAM really holds.
+    run_dots(parent, DOT_PER_FRAME);
+    run_dots(child,  DOT_PER_FRAME);
+    CU_ASSERT(same_state(parent, child));
+
+    tidy_emulator(child, false);
+    tidy_emulator(parent, false);
+}
+
+int main()
+{
+    // Initialize the CUnit test registry
+    if (CUE_SUCCESS != CU_initialize_registry())
+    {
+        return CU_get_error();
+    }
+
+    // Create a test suite
+    CU_pSuite suite = CU_add_suite("Snapshot Tests", 0, 0);
+    if (suite == NULL)
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add test cases to the suite
+    if
+    (
+        CU_add_test(suite, "Snapshot Round Trip",      test_snapshot_round_trip)          == NULL ||
+        CU_add_test(suite, "Snapshot Determinism",     test_snapshot_determinism)         == NULL ||
+        CU_add_test(suite, "Snapshot Rejects Garbage", test_snapshot_rejects_bad_buffers) == NULL ||
+        CU_add_test(suite, "Fork Matches Parent",      test_fork_matches_parent)          == NULL ||
+        CU_add_test(suite, "Fork Children Isolated",   test_fork_children_are_isolated)   == NULL ||
+        CU_add_test(suite, "Fast Reset Matches Boot",  test_fast_reset_matches_boot)      == NULL ||
+        CU_add_test(suite, "Tile Cache Follows VRAM",  test_tile_cache_follows_vram)      == NULL
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Run all tests using the basic interface
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+
+    // Clean up registry
+    CU_cleanup_registry();
+    return CU_get_error();
+}